@@ -26,6 +26,7 @@
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/connected_components.hpp>
 #include <boost/timer.hpp>
+#include <boost/detail/atomic_count.hpp>
 
 
 namespace {
@@ -969,7 +970,8 @@ Empire::Empire() :
     m_capital_id(UniverseObject::INVALID_OBJECT_ID),
     m_resource_pools(),
     m_population_pool(),
-    m_maintenance_total_cost(0)
+    m_maintenance_total_cost(0),
+    m_supply_version(0)
 { Init(); }
 
 Empire::Empire(const std::string& name, const std::string& player_name, int empire_id, const GG::Clr& color) :
@@ -980,7 +982,8 @@ Empire::Empire(const std::string& name, const std::string& player_name, int empi
     m_capital_id(UniverseObject::INVALID_OBJECT_ID),
     m_resource_pools(),
     m_population_pool(),
-    m_maintenance_total_cost(0)
+    m_maintenance_total_cost(0),
+    m_supply_version(0)
 {
     Logger().debugStream() << "Empire::Empire(" << name << ", " << player_name << ", " << empire_id << ", colour)";
     Init();
@@ -1001,6 +1004,16 @@ void Empire::Init()
         const Alignment& alignment = *it;
         m_meters[alignment.Name()];
     }
+
+    SupplyChanged();
+}
+
+void Empire::SupplyChanged()
+{
+    // shared by all empires, so that a new empire replacing an old one, as
+    // when a client receives a turn update, gets a number the old one never had
+    static boost::detail::atomic_count s_last_supply_version(0);
+    m_supply_version = ++s_last_supply_version;
 }
 
 Empire::~Empire()
@@ -1305,6 +1318,7 @@ void Empire::EliminationCleanup() {
     m_resource_supply_obstructed_starlane_traversals.clear();
     m_resource_supply_system_ranges.clear();
     m_supply_unobstructed_systems.clear();
+    SupplyChanged();
 }
 
 void Empire::UpdateSystemSupplyRanges(const std::set<int>& known_objects) {
@@ -1367,13 +1381,12 @@ void Empire::UpdateSystemSupplyRanges() {
 
     // get ids of objects partially or better visible to this empire.
     std::vector<int> known_objects_vec = empire_known_objects.FindObjectIDs();
-    const std::set<int>& known_destroyed_objects = universe.EmpireKnownDestroyedObjectIDs(this->EmpireID());
 
     std::set<int> known_objects_set;
 
     // exclude objects known to have been destroyed (or rather, include ones that aren't known by this empire to be destroyed)
     for (std::vector<int>::const_iterator it = known_objects_vec.begin(); it != known_objects_vec.end(); ++it)
-        if (known_destroyed_objects.find(*it) == known_destroyed_objects.end())
+        if (!universe.EmpireKnowsObjectDestroyed(*it, this->EmpireID()))
             known_objects_set.insert(*it);
     UpdateSystemSupplyRanges(known_objects_set);
 }
@@ -1384,25 +1397,24 @@ void Empire::UpdateSupplyUnobstructedSystems() {
     // get ids of systems partially or better visible to this empire.
     // TODO: make a UniverseObjectVisitor for objects visible to an empire at a specified visibility or greater
     std::vector<int> known_systems_vec = universe.EmpireKnownObjects(this->EmpireID()).FindObjectIDs<System>();
-    const std::set<int>& known_destroyed_objects = universe.EmpireKnownDestroyedObjectIDs(this->EmpireID());
 
     std::set<int> known_systems_set;
 
     // exclude systems known to have been destroyed (or rather, include ones that aren't known to be destroyed)
     for (std::vector<int>::const_iterator it = known_systems_vec.begin(); it != known_systems_vec.end(); ++it)
-        if (known_destroyed_objects.find(*it) == known_destroyed_objects.end())
+        if (!universe.EmpireKnowsObjectDestroyed(*it, this->EmpireID()))
             known_systems_set.insert(*it);
     UpdateSupplyUnobstructedSystems(known_systems_set);
 }
 
 void Empire::UpdateSupplyUnobstructedSystems(const std::set<int>& known_systems) {
     m_supply_unobstructed_systems.clear();
+    SupplyChanged();
 
     // get systems with historically at least partial visibility
     std::set<int> systems_with_at_least_partial_visibility_at_some_point;
     for (std::set<int>::const_iterator sys_it = known_systems.begin(); sys_it != known_systems.end(); ++sys_it) {
-        const Universe::VisibilityTurnMap& vis_turns = GetUniverse().GetObjectVisibilityTurnMapByEmpire(*sys_it, m_id);
-        if (vis_turns.find(VIS_PARTIAL_VISIBILITY) != vis_turns.end())
+        if (GetUniverse().GetObjectVisibilityTurnByEmpire(*sys_it, m_id, VIS_PARTIAL_VISIBILITY) != INVALID_GAME_TURN)
             systems_with_at_least_partial_visibility_at_some_point.insert(*sys_it);
     }
 
@@ -1455,6 +1467,7 @@ void Empire::UpdateFleetSupply(const std::map<int, std::set<int> >& starlanes) {
 
     m_fleet_supplyable_system_ids.clear();
     m_fleet_supply_starlane_traversals.clear();
+    SupplyChanged();
 
     // store range of all systems before propegation of supply in working map used to propegate that range to other systems.
     std::map<int, int> propegating_fleet_supply_ranges = m_fleet_supply_system_ranges;
@@ -1820,7 +1833,6 @@ const std::map<int, std::set<int> > Empire::KnownStarlanes() const
 
     const Universe& universe = GetUniverse();
 
-    const std::set<int>& known_destroyed_objects = universe.EmpireKnownDestroyedObjectIDs(this->EmpireID());
     std::vector<const System*> systems = universe.EmpireKnownObjects(this->EmpireID()).FindObjects<const System>();
 
     for (std::vector<const System*>::const_iterator it = systems.begin(); it != systems.end(); ++it) {
@@ -1828,12 +1840,12 @@ const std::map<int, std::set<int> > Empire::KnownStarlanes() const
         int start_id = system->ID();
 
         // exclude lanes starting at systems known to be destroyed
-        if (known_destroyed_objects.find(start_id) != known_destroyed_objects.end())
+        if (universe.EmpireKnowsObjectDestroyed(start_id, this->EmpireID()))
             continue;
 
         System::StarlaneMap lanes = system->StarlanesWormholes();
         for (System::StarlaneMap::const_iterator lane_it = lanes.begin(); lane_it != lanes.end(); ++lane_it) {
-            if (lane_it->second || known_destroyed_objects.find(lane_it->second) != known_destroyed_objects.end())
+            if (lane_it->second || universe.EmpireKnowsObjectDestroyed(lane_it->second, this->EmpireID()))
                 continue;   // is a wormhole, not a starlane, or is connected to a known destroyed system
             int end_id = lane_it->first;
             retval[start_id].insert(end_id);
@@ -2676,7 +2688,7 @@ void Empire::SetPlayerName(const std::string& player_name)
 void Empire::InitResourcePools()
 {
     const ObjectMap& objects = GetUniverse().Objects();
-    std::vector<const UniverseObject*> object_vec = objects.FindObjects(OwnedVisitor<UniverseObject>(m_id));
+    std::vector<const UniverseObject*> object_vec = objects.FindOwnedObjects<UniverseObject>(m_id);
     std::vector<int> object_ids_vec, popcenter_ids_vec;
 
     // determine if each object owned by this empire is a PopCenter, and store
@@ -2766,11 +2778,10 @@ void Empire::UpdateTradeSpending()
     // TODO: Replace with call to some other subsystem, similar to the Update...Queue functions
     m_maintenance_total_cost = 0.0;
 
-    std::vector<UniverseObject*> buildings = GetUniverse().Objects().FindObjects(OwnedVisitor<Building>(m_id));
-    for (std::vector<UniverseObject*>::const_iterator it = buildings.begin(); it != buildings.end(); ++it) {
-        Building* building = universe_object_cast<Building*>(*it);
-        if (!building)
-            continue;
+    const ObjectMap& objects = GetUniverse().Objects();
+    std::vector<const Building*> buildings = objects.FindOwnedObjects<Building>(m_id);
+    for (std::vector<const Building*>::const_iterator it = buildings.begin(); it != buildings.end(); ++it) {
+        const Building* building = *it;
 
         const BuildingType* building_type = building->GetBuildingType();
         if (!building_type)
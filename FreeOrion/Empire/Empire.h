@@ -344,6 +344,13 @@ public:
 
     const std::set<int>&                    SupplyUnobstructedSystems() const;              ///< returns set of system ids that are able to propagate supply from one system to the next, or at which supply can be delivered to fleets if supply can reach the system from elsewhere
 
+    /** returns a number that changes whenever FleetSupplyableSystemIDs() or
+      * SupplyUnobstructedSystems() may have changed.  No two Empire objects
+      * in a process share a number, so it can be used to tell whether
+      * information derived from this empire's supply, such as fleets' move
+      * paths, is up to date. */
+    int                                     SupplyVersion() const                           { return m_supply_version; }
+
     /** modifies passed parameter, which is a map from system id to the range,
       * in starlane jumps that the system can send supplies. */
     void                    GetSystemSupplyRanges(std::map<int, int>& system_supply_ranges) const;
@@ -536,6 +543,7 @@ public:
 
 private:
     void                    Init();
+    void                    SupplyChanged();    ///< gives this empire a new SupplyVersion()
 
     int                             m_id;                       ///< Empire's unique numeric id
     std::string                     m_name;                     ///< Empire's name
@@ -580,6 +588,7 @@ private:
     std::set<std::pair<int, int> >  m_resource_supply_obstructed_starlane_traversals;   ///< ordered pairs of system ids between which a starlane could be used to convey resources between system, but is not because something is obstructing the resource flow.  That is, the resource flow isn't limited by range, but by something blocking its flow.
     std::map<int, int>              m_resource_supply_system_ranges;                    ///< number of starlane jumps away from each system (by id) that resources can be conveyed.
     std::set<int>                   m_supply_unobstructed_systems;                      ///< ids of system that don't block supply (resource or fleet) from flowing
+    int                             m_supply_version;                                   ///< not serialized; see SupplyVersion()
 
 
     friend class boost::serialization::access;
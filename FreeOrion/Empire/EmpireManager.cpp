@@ -5,6 +5,13 @@
 #include "../util/AppInterface.h"
 #include "../util/MultiplayerCommon.h"
 
+#include <algorithm>
+
+
+EmpireManager::EmpireManager() :
+    m_num_diplo_empires(0),
+    m_diplo_capacity(0)
+{}
 
 EmpireManager::~EmpireManager()
 {
@@ -16,6 +23,12 @@ const EmpireManager& EmpireManager::operator=(EmpireManager& rhs)
     Clear();
     m_empire_map = rhs.m_empire_map;
     rhs.m_empire_map.clear();
+    m_empire_indices.swap(rhs.m_empire_indices);
+    m_diplo_statuses.swap(rhs.m_diplo_statuses);
+    m_visibility_sharing.swap(rhs.m_visibility_sharing);
+    std::swap(m_num_diplo_empires, rhs.m_num_diplo_empires);
+    std::swap(m_diplo_capacity, rhs.m_diplo_capacity);
+    m_diplo_proposals.swap(rhs.m_diplo_proposals);
     return *this;
 }
 
@@ -40,6 +53,58 @@ bool EmpireManager::Eliminated(int id) const
     return m_eliminated_empires.find(id) != m_eliminated_empires.end();
 }
 
+DiplomaticStatus EmpireManager::GetDiplomaticStatus(int empire1_id, int empire2_id) const
+{
+    int index = PairIndex(empire1_id, empire2_id);
+    if (index == -1)
+        return DIPLO_WAR;
+    return DiplomaticStatus(m_diplo_statuses[index]);
+}
+
+bool EmpireManager::AtWar(int empire1_id, int empire2_id) const
+{
+    if (empire1_id == empire2_id)
+        return false;
+    int index = PairIndex(empire1_id, empire2_id);
+    return index == -1 || m_diplo_statuses[index] == DIPLO_WAR;
+}
+
+bool EmpireManager::Allied(int empire1_id, int empire2_id) const
+{
+    if (empire1_id == empire2_id)
+        return false;
+    int index = PairIndex(empire1_id, empire2_id);
+    return index != -1 && m_diplo_statuses[index] == DIPLO_ALLIED;
+}
+
+bool EmpireManager::SharesVisibility(int sharing_empire_id, int receiving_empire_id) const
+{
+    if (sharing_empire_id == receiving_empire_id)
+        return false;
+    int index = PairIndex(sharing_empire_id, receiving_empire_id);
+    return index != -1 && m_visibility_sharing[index];
+}
+
+DiplomaticStatus EmpireManager::ProposedDiplomaticStatus(int proposing_empire_id, int receiving_empire_id) const
+{
+    std::map<std::pair<int, int>, DiplomaticStatus>::const_iterator it =
+        m_diplo_proposals.find(std::make_pair(proposing_empire_id, receiving_empire_id));
+    return it == m_diplo_proposals.end() ? INVALID_DIPLOMATIC_STATUS : it->second;
+}
+
+int EmpireManager::PairIndex(int empire1_id, int empire2_id) const
+{
+    if (empire1_id < 0 || empire2_id < 0 ||
+        empire1_id >= static_cast<int>(m_empire_indices.size()) ||
+        empire2_id >= static_cast<int>(m_empire_indices.size()))
+    { return -1; }
+    int row = m_empire_indices[empire1_id];
+    int col = m_empire_indices[empire2_id];
+    if (row == -1 || col == -1)
+        return -1;
+    return row * static_cast<int>(m_diplo_capacity) + col;
+}
+
 Empire* EmpireManager::Lookup(int id)
 {
     iterator it = m_empire_map.find(id);
@@ -89,6 +154,116 @@ void EmpireManager::InsertEmpire(Empire* empire)
     }
 
     m_empire_map[empire_id] = empire;
+    AddDiplomacyEntries(empire_id);
+}
+
+void EmpireManager::AddDiplomacyEntries(int empire_id)
+{
+    if (empire_id < 0) {
+        Logger().errorStream() << "EmpireManager::AddDiplomacyEntries passed invalid empire id " << empire_id;
+        return;
+    }
+    if (empire_id >= static_cast<int>(m_empire_indices.size()))
+        m_empire_indices.resize(empire_id + 1, -1);
+    if (m_empire_indices[empire_id] != -1)
+        return;
+
+    // the new empire's row and column are already allocated, and still have
+    // their default values, unless the matrices are full
+    if (m_num_diplo_empires == m_diplo_capacity) {
+        std::size_t old_capacity = m_diplo_capacity;
+        std::size_t new_capacity = std::max<std::size_t>(8, 2 * old_capacity);
+        std::vector<unsigned char> diplo_statuses(new_capacity * new_capacity, static_cast<unsigned char>(DIPLO_WAR));
+        std::vector<unsigned char> visibility_sharing(new_capacity * new_capacity, 0);
+        for (std::size_t row = 0; row < m_num_diplo_empires; ++row) {
+            std::copy(m_diplo_statuses.begin() + row * old_capacity,
+                      m_diplo_statuses.begin() + row * old_capacity + m_num_diplo_empires,
+                      diplo_statuses.begin() + row * new_capacity);
+            std::copy(m_visibility_sharing.begin() + row * old_capacity,
+                      m_visibility_sharing.begin() + row * old_capacity + m_num_diplo_empires,
+                      visibility_sharing.begin() + row * new_capacity);
+        }
+        m_diplo_statuses.swap(diplo_statuses);
+        m_visibility_sharing.swap(visibility_sharing);
+        m_diplo_capacity = new_capacity;
+    }
+    m_empire_indices[empire_id] = static_cast<int>(m_num_diplo_empires);
+    ++m_num_diplo_empires;
+}
+
+void EmpireManager::SetDiplomaticStatus(int empire1_id, int empire2_id, DiplomaticStatus status)
+{
+    if (empire1_id == empire2_id || status <= INVALID_DIPLOMATIC_STATUS || status >= NUM_DIPLO_STATUSES) {
+        Logger().errorStream() << "EmpireManager::SetDiplomaticStatus passed invalid empire pair (" << empire1_id
+                               << ", " << empire2_id << ") or status " << status;
+        return;
+    }
+    int index12 = PairIndex(empire1_id, empire2_id);
+    int index21 = PairIndex(empire2_id, empire1_id);
+    if (index12 == -1 || index21 == -1) {
+        Logger().errorStream() << "EmpireManager::SetDiplomaticStatus couldn't find empires with ids "
+                               << empire1_id << " and " << empire2_id;
+        return;
+    }
+
+    m_diplo_proposals.erase(std::make_pair(empire1_id, empire2_id));
+    m_diplo_proposals.erase(std::make_pair(empire2_id, empire1_id));
+
+    bool changed = m_diplo_statuses[index12] != static_cast<unsigned char>(status);
+    m_diplo_statuses[index12] = static_cast<unsigned char>(status);
+    m_diplo_statuses[index21] = static_cast<unsigned char>(status);
+
+    if (status == DIPLO_WAR && (m_visibility_sharing[index12] || m_visibility_sharing[index21])) {
+        m_visibility_sharing[index12] = 0;
+        m_visibility_sharing[index21] = 0;
+        changed = true;
+    }
+
+    if (changed)
+        DiplomaticStatusChangedSignal(empire1_id, empire2_id);
+}
+
+void EmpireManager::ProposeDiplomaticStatus(int proposing_empire_id, int receiving_empire_id, DiplomaticStatus status)
+{
+    if (proposing_empire_id == receiving_empire_id || status <= INVALID_DIPLOMATIC_STATUS || status >= NUM_DIPLO_STATUSES ||
+        PairIndex(proposing_empire_id, receiving_empire_id) == -1)
+    {
+        Logger().errorStream() << "EmpireManager::ProposeDiplomaticStatus passed invalid empire pair ("
+                               << proposing_empire_id << ", " << receiving_empire_id << ") or status " << status;
+        return;
+    }
+
+    DiplomaticStatus current_status = GetDiplomaticStatus(proposing_empire_id, receiving_empire_id);
+    if (status == current_status) {
+        m_diplo_proposals.erase(std::make_pair(proposing_empire_id, receiving_empire_id));
+        return;
+    }
+
+    // statuses are ordered from most to least hostile, and either empire may
+    // make things more hostile on its own
+    if (status < current_status ||
+        ProposedDiplomaticStatus(receiving_empire_id, proposing_empire_id) == status)
+    {
+        SetDiplomaticStatus(proposing_empire_id, receiving_empire_id, status);
+        return;
+    }
+
+    m_diplo_proposals[std::make_pair(proposing_empire_id, receiving_empire_id)] = status;
+}
+
+void EmpireManager::SetVisibilitySharing(int sharing_empire_id, int receiving_empire_id, bool share)
+{
+    int index = sharing_empire_id == receiving_empire_id ? -1 : PairIndex(sharing_empire_id, receiving_empire_id);
+    if (index == -1) {
+        Logger().errorStream() << "EmpireManager::SetVisibilitySharing passed invalid empire pair ("
+                               << sharing_empire_id << ", " << receiving_empire_id << ")";
+        return;
+    }
+    unsigned char new_value = share ? 1 : 0;
+    if (m_visibility_sharing[index] == new_value)
+        return;
+    m_visibility_sharing[index] = new_value;
+    DiplomaticStatusChangedSignal(sharing_empire_id, receiving_empire_id);
 }
 
 void EmpireManager::Clear()
@@ -98,4 +273,10 @@ void EmpireManager::Clear()
     }
     m_empire_map.clear();
     m_eliminated_empires.clear();
+    m_empire_indices.clear();
+    m_diplo_statuses.clear();
+    m_visibility_sharing.clear();
+    m_num_diplo_empires = 0;
+    m_diplo_capacity = 0;
+    m_diplo_proposals.clear();
 }
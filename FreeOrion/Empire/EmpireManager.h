@@ -9,10 +9,13 @@
 #endif
 
 #include <boost/serialization/access.hpp>
+#include <boost/serialization/version.hpp>
+#include <boost/signal.hpp>
 
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 class Empire;
 
@@ -26,7 +29,12 @@ public:
     /// Const Iterator over Empires
     typedef std::map<int, Empire*>::const_iterator const_iterator;
 
+    /** emitted after the diplomatic status or visibility sharing between two
+      * empires changes; parameters are the ids of the two empires */
+    typedef boost::signal<void (int, int)> DiplomaticStatusChangedSignalType;
+
     /** \name Structors */ //@{
+    EmpireManager();          ///< default ctor
     virtual ~EmpireManager(); ///< virtual dtor
     const EmpireManager& operator=(EmpireManager& rhs); ///< assignment operator (move semantics)
     //@}
@@ -41,6 +49,30 @@ public:
     /** Returns whether the empire with ID \a id has been eliminated, or false
       * if no such empire exists. */
     bool            Eliminated(int id) const;
+
+    /** Returns the diplomatic status between the empires with ids \a empire1_id
+      * and \a empire2_id.  Empires start out at war with each other. */
+    DiplomaticStatus    GetDiplomaticStatus(int empire1_id, int empire2_id) const;
+
+    /** Returns true iff objects owned by \a empire1_id and \a empire2_id are
+      * hostile to each other.  An empire is never at war with itself, and
+      * unowned objects (ALL_EMPIRES) are at war with every empire. */
+    bool            AtWar(int empire1_id, int empire2_id) const;
+
+    /** Returns true iff the empires with ids \a empire1_id and \a empire2_id
+      * are distinct and allied. */
+    bool            Allied(int empire1_id, int empire2_id) const;
+
+    /** Returns true iff the empire with id \a sharing_empire_id shares what it
+      * detects with the empire with id \a receiving_empire_id. */
+    bool            SharesVisibility(int sharing_empire_id, int receiving_empire_id) const;
+
+    /** Returns the status the empire with id \a proposing_empire_id has
+      * proposed to the empire with id \a receiving_empire_id and that has not
+      * yet been accepted, or INVALID_DIPLOMATIC_STATUS if there is none. */
+    DiplomaticStatus    ProposedDiplomaticStatus(int proposing_empire_id, int receiving_empire_id) const;
+
+    mutable DiplomaticStatusChangedSignalType DiplomaticStatusChangedSignal;
     //@}
 
     /** \name Mutators */ //@{
@@ -66,18 +98,64 @@ public:
     /** Adds the given empire to the manager. */
     void            InsertEmpire(Empire* empire);
 
+    /** Sets the (symmetric) diplomatic status between the empires with ids
+      * \a empire1_id and \a empire2_id.  Declaring war also ends any
+      * visibility sharing between the two empires. */
+    void            SetDiplomaticStatus(int empire1_id, int empire2_id, DiplomaticStatus status);
+
+    /** Handles the empire with id \a proposing_empire_id asking for diplomatic
+      * status \a status with the empire with id \a receiving_empire_id.
+      * Moving to a more hostile status takes effect immediately.  Moving to a
+      * friendlier status is recorded as a proposal, and takes effect once the
+      * other empire has proposed the same status in return. */
+    void            ProposeDiplomaticStatus(int proposing_empire_id, int receiving_empire_id, DiplomaticStatus status);
+
+    /** Sets whether the empire with id \a sharing_empire_id shares what it
+      * detects with the empire with id \a receiving_empire_id.  Sharing is
+      * one-directional. */
+    void            SetVisibilitySharing(int sharing_empire_id, int receiving_empire_id, bool share);
+
     /** Removes and deletes all empires from the manager. */
     void            Clear();
     //@}
 
 
 private:
+    /** Returns the position in m_diplo_statuses and m_visibility_sharing of
+      * the entry for the ordered pair of empires, or -1 if either empire is
+      * not known to this manager. */
+    int             PairIndex(int empire1_id, int empire2_id) const;
+
+    /** Assigns \a empire_id a row and column in the diplomacy matrices,
+      * keeping existing entries.  The matrices are allocated with spare rows
+      * and columns, so they only need to be reallocated when the number of
+      * empires passes m_diplo_capacity. */
+    void            AddDiplomacyEntries(int empire_id);
+
     std::map<int, Empire*>  m_empire_map;
     std::set<int>           m_eliminated_empires;
 
+    /** Dense row / column of each empire in the diplomacy matrices, indexed
+      * by empire id; -1 for ids with no empire. */
+    std::vector<int>            m_empire_indices;
+    /** Row-major matrix of DiplomaticStatus values between pairs of empires,
+      * with m_diplo_capacity entries per row. */
+    std::vector<unsigned char>  m_diplo_statuses;
+    /** Row-major matrix; nonzero at [sharer][receiver] if sharer shares its
+      * visibility with receiver. */
+    std::vector<unsigned char>  m_visibility_sharing;
+    std::size_t                 m_num_diplo_empires;
+    std::size_t                 m_diplo_capacity;
+
+    /** Unaccepted proposals of friendlier statuses, keyed by (proposing
+      * empire id, receiving empire id). */
+    std::map<std::pair<int, int>, DiplomaticStatus> m_diplo_proposals;
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
 };
 
+BOOST_CLASS_VERSION(EmpireManager, 2)
+
 #endif // _EmpireManager_h_
@@ -650,9 +650,10 @@ void EncyclopediaDetailPanel::Refresh() {
 
         // objects that have special
         std::vector<const UniverseObject*> objects_with_special;
-        for (ObjectMap::const_iterator obj_it = objects.const_begin(); obj_it != objects.const_end(); ++obj_it)
-            if (obj_it->second->Specials().find(m_items_it->second) != obj_it->second->Specials().end())
-                objects_with_special.push_back(obj_it->second);
+        const std::set<int>& object_ids = objects.SpecialObjectIDs(FindSpecialID(m_items_it->second));
+        for (std::set<int>::const_iterator id_it = object_ids.begin(); id_it != object_ids.end(); ++id_it)
+            if (const UniverseObject* obj = objects.Object(*id_it))
+                objects_with_special.push_back(obj);
 
         if (!objects_with_special.empty()) {
             detailed_description += "\n\n" + UserString("OBJECTS_WITH_SPECIAL");
@@ -710,10 +711,10 @@ void EncyclopediaDetailPanel::Refresh() {
             detailed_description += UserString("NO_CAPITAL");
 
         // Planets
-        std::vector<const UniverseObject*> empire_planets = objects.FindObjects(OwnedVisitor<Planet>(empire_id));
+        std::vector<const Planet*> empire_planets = objects.FindOwnedObjects<Planet>(empire_id);
         if (!empire_planets.empty()) {
             detailed_description += "\n\n" + UserString("OWNED_PLANETS");
-            for (std::vector<const UniverseObject*>::const_iterator planet_it = empire_planets.begin();
+            for (std::vector<const Planet*>::const_iterator planet_it = empire_planets.begin();
                  planet_it != empire_planets.end(); ++planet_it)
             {
                 const UniverseObject* obj = *planet_it;
@@ -724,10 +725,10 @@ void EncyclopediaDetailPanel::Refresh() {
         }
 
         // Fleets
-        std::vector<const UniverseObject*> empire_fleets = objects.FindObjects(OwnedVisitor<Fleet>(empire_id));
+        std::vector<const Fleet*> empire_fleets = objects.FindOwnedObjects<Fleet>(empire_id);
         if (!empire_fleets.empty()) {
             detailed_description += "\n\n" + UserString("OWNED_FLEETS") + "\n";
-            for (std::vector<const UniverseObject*>::const_iterator fleet_it = empire_fleets.begin();
+            for (std::vector<const Fleet*>::const_iterator fleet_it = empire_fleets.begin();
                  fleet_it != empire_fleets.end(); ++fleet_it)
             {
                 const UniverseObject* obj = *fleet_it;
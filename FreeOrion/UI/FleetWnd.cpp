@@ -1573,7 +1573,6 @@ public:
         SetColWidth(0, GG::X0);
         LockColWidths();
 
-        const std::set<int>& this_client_known_destroyed_objects = GetUniverse().EmpireKnownDestroyedObjectIDs(HumanClientApp::GetApp()->EmpireID());
 
         std::set<int> new_selected_ship_ids;
 
@@ -1581,7 +1580,7 @@ public:
             int ship_id = *it;
 
             // skip known destroyed objects
-            if (this_client_known_destroyed_objects.find(ship_id) != this_client_known_destroyed_objects.end())
+            if (GetUniverse().EmpireKnowsObjectDestroyed(ship_id, HumanClientApp::GetApp()->EmpireID()))
                 continue;
 
             ShipRow* row = new ShipRow(GG::X1, row_size.y, ship_id);
@@ -2117,7 +2116,6 @@ void FleetWnd::Refresh()
 {
     const ObjectMap& objects = GetUniverse().Objects(); // objects visisble to this client's empire
     int this_client_empire_id = HumanClientApp::GetApp()->EmpireID();
-    const std::set<int>& this_client_known_destroyed_objects = GetUniverse().EmpireKnownDestroyedObjectIDs(this_client_empire_id);
 
     // save selected fleet(s) and ships(s)
     std::set<int> initially_selected_fleets = this->SelectedFleetIDs();
@@ -2128,7 +2126,7 @@ void FleetWnd::Refresh()
 
     // skip nonexistant systems
     if (m_system_id != UniverseObject::INVALID_OBJECT_ID &&
-        this_client_known_destroyed_objects.find(m_system_id) != this_client_known_destroyed_objects.end())
+        GetUniverse().EmpireKnowsObjectDestroyed(m_system_id, this_client_empire_id))
     {
         m_system_connection.disconnect();
         return;
@@ -2142,7 +2140,7 @@ void FleetWnd::Refresh()
         for (std::vector<const Fleet*>::const_iterator it = all_fleets.begin(); it != all_fleets.end(); ++it) {
             const Fleet* fleet = *it;
             if (fleet->SystemID() != m_system_id ||
-                this_client_known_destroyed_objects.find(fleet->ID()) != this_client_known_destroyed_objects.end())
+                GetUniverse().EmpireKnowsObjectDestroyed(fleet->ID(), this_client_empire_id))
             {
                 // skip fleets that aren't actually in this system, or that
                 // don't actually exist anymore...
@@ -2160,7 +2158,7 @@ void FleetWnd::Refresh()
         for (std::set<int>::const_iterator it = m_fleet_ids.begin(); it != m_fleet_ids.end(); ++it) {
             int fleet_id = *it;
 
-            if (this_client_known_destroyed_objects.find(fleet_id) != this_client_known_destroyed_objects.end()) {
+            if (GetUniverse().EmpireKnowsObjectDestroyed(fleet_id, this_client_empire_id)) {
                 // skip fleets that don't actually exist anymore...
                 continue;
             }
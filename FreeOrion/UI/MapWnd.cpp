@@ -1432,7 +1432,6 @@ void MapWnd::RenderVisibilityRadii() {
     const double STEALTH_THRESHOLD = GetOptionsDB().Get<double>("UI.detection-range-stealth-threshold");    // how much to deduct from detection to compensate for potential target stealth, and also the minimum detection to consider showing
 
     int client_empire_id = HumanClientApp::GetApp()->EmpireID();
-    const std::set<int>& known_destroyed_object_ids = GetUniverse().EmpireKnownDestroyedObjectIDs(client_empire_id);
     const ObjectMap& known_objects = GetUniverse().EmpireKnownObjects(client_empire_id);
 
     // for each map position and empire, find max value of detection range at that position
@@ -1440,7 +1439,7 @@ void MapWnd::RenderVisibilityRadii() {
     for (ObjectMap::const_iterator it = known_objects.const_begin(); it != known_objects.const_end(); ++it) {
         // skip destroyed objects
         int object_id = it->first;
-        if (known_destroyed_object_ids.find(object_id) != known_destroyed_object_ids.end())
+        if (GetUniverse().EmpireKnowsObjectDestroyed(object_id, client_empire_id))
             continue;
 
         const UniverseObject* obj = it->second;
@@ -1682,7 +1681,6 @@ void MapWnd::InitTurn()
 
     boost::timer timer;
 
-    const std::set<int>& this_client_known_destroyed_objects = universe.EmpireKnownDestroyedObjectIDs(HumanClientApp::GetApp()->EmpireID());
 
     //std::map<int, std::set<int> > this_client_known_starlanes;
     //if (this_client_empire)
@@ -1692,14 +1690,14 @@ void MapWnd::InitTurn()
     std::set<int> this_client_known_systems;
     std::vector<int> all_system_ids = known_objects.FindObjectIDs<System>();
     for (std::vector<int>::const_iterator it = all_system_ids.begin(); it != all_system_ids.end(); ++it)
-        if (this_client_known_destroyed_objects.find(*it) == this_client_known_destroyed_objects.end())
+        if (!universe.EmpireKnowsObjectDestroyed(*it, HumanClientApp::GetApp()->EmpireID()))
             this_client_known_systems.insert(*it);
 
     // get ids of all not-destroyed objects known to this empire.
     std::set<int> this_client_known_objects;
     std::vector<int> all_object_ids = known_objects.FindObjectIDs();
     for (std::vector<int>::const_iterator it = all_object_ids.begin(); it != all_object_ids.end(); ++it)
-        if (this_client_known_destroyed_objects.find(*it) == this_client_known_destroyed_objects.end())
+        if (!universe.EmpireKnowsObjectDestroyed(*it, HumanClientApp::GetApp()->EmpireID()))
             this_client_known_objects.insert(*it);
 
     Logger().debugStream() << "MapWnd::InitTurn getting known starlanes and visible systems and visible objects time: " << (timer.elapsed() * 1000.0);
@@ -1864,7 +1862,6 @@ void MapWnd::InitTurnRendering()
     m_system_icons.clear();
 
 
-    const std::set<int>& this_client_known_destroyed_objects = GetUniverse().EmpireKnownDestroyedObjectIDs(HumanClientApp::GetApp()->EmpireID());
 
     // create system icons
     std::vector<const System*> systems = known_objects.FindObjects<System>();
@@ -1872,7 +1869,7 @@ void MapWnd::InitTurnRendering()
         const System* start_system = systems[i];
 
         // skip known destroyed objects
-        if (this_client_known_destroyed_objects.find(start_system->ID()) != this_client_known_destroyed_objects.end())
+        if (GetUniverse().EmpireKnowsObjectDestroyed(start_system->ID(), HumanClientApp::GetApp()->EmpireID()))
             continue;
 
         // create new system icon
@@ -2075,7 +2072,6 @@ void MapWnd::InitStarlaneRenderingBuffers()
 
     int empire_id = HumanClientApp::GetApp()->EmpireID();
     EmpireManager& manager = HumanClientApp::GetApp()->Empires();
-    const std::set<int>& this_client_known_destroyed_objects = GetUniverse().EmpireKnownDestroyedObjectIDs(HumanClientApp::GetApp()->EmpireID());
 
 
     // calculate in-universe apparent starlane endpoints and create buffers for starlane rendering
@@ -2085,7 +2081,7 @@ void MapWnd::InitStarlaneRenderingBuffers()
         int system_id = it->first;
 
         // skip systems that don't actually exist
-        if (this_client_known_destroyed_objects.find(system_id) != this_client_known_destroyed_objects.end())
+        if (GetUniverse().EmpireKnowsObjectDestroyed(system_id, HumanClientApp::GetApp()->EmpireID()))
             continue;
 
         const System* start_system = GetEmpireKnownObject<System>(system_id, empire_id);
@@ -2102,7 +2098,7 @@ void MapWnd::InitStarlaneRenderingBuffers()
             int lane_end_sys_id = lane_it->first;
 
             // skip lanes to systems that don't actually exist
-            if (this_client_known_destroyed_objects.find(lane_end_sys_id) != this_client_known_destroyed_objects.end())
+            if (GetUniverse().EmpireKnowsObjectDestroyed(lane_end_sys_id, HumanClientApp::GetApp()->EmpireID()))
                 continue;
 
             const System* dest_system = GetEmpireKnownObject<System>(lane_it->first, empire_id);
@@ -2860,14 +2856,13 @@ void MapWnd::RefreshFleetButtons()
     // be grouped by empire owner and buttons created
     const ObjectMap& objects = GetUniverse().Objects();
 
-    const std::set<int>& this_client_known_destroyed_objects = GetUniverse().EmpireKnownDestroyedObjectIDs(HumanClientApp::GetApp()->EmpireID());
 
     // for each system, each empire's fleets that are ordered to move, but still at the system: "departing fleets"
     std::map<const System*, std::map<int, std::vector<const Fleet*> > > departing_fleets;
     std::vector<const UniverseObject*> departing_fleet_objects = objects.FindObjects(OrderedMovingFleetVisitor());
     for (std::vector<const UniverseObject*>::iterator it = departing_fleet_objects.begin(); it != departing_fleet_objects.end(); ++it) {
         // skip known destroyed objects
-        if (this_client_known_destroyed_objects.find((*it)->ID()) != this_client_known_destroyed_objects.end())
+        if (GetUniverse().EmpireKnowsObjectDestroyed((*it)->ID(), HumanClientApp::GetApp()->EmpireID()))
             continue;
 
         const Fleet* fleet = universe_object_cast<const Fleet*>(*it);
@@ -2894,7 +2889,7 @@ void MapWnd::RefreshFleetButtons()
     std::vector<const UniverseObject*> stationary_fleet_objects = objects.FindObjects(StationaryFleetVisitor());
     for (std::vector<const UniverseObject*>::iterator it = stationary_fleet_objects.begin(); it != stationary_fleet_objects.end(); ++it) {
         // skip known destroyed objects
-        if (this_client_known_destroyed_objects.find((*it)->ID()) != this_client_known_destroyed_objects.end())
+        if (GetUniverse().EmpireKnowsObjectDestroyed((*it)->ID(), HumanClientApp::GetApp()->EmpireID()))
             continue;
 
         const Fleet* fleet = universe_object_cast<const Fleet*>(*it);
@@ -2921,7 +2916,7 @@ void MapWnd::RefreshFleetButtons()
     std::vector<const UniverseObject*> moving_fleet_objects = objects.FindObjects(MovingFleetVisitor());
     for (std::vector<const UniverseObject*>::iterator it = moving_fleet_objects.begin(); it != moving_fleet_objects.end(); ++it) {
         // skip known destroyed objects
-        if (this_client_known_destroyed_objects.find((*it)->ID()) != this_client_known_destroyed_objects.end())
+        if (GetUniverse().EmpireKnowsObjectDestroyed((*it)->ID(), HumanClientApp::GetApp()->EmpireID()))
             continue;
 
         const Fleet* fleet = universe_object_cast<const Fleet*>(*it);
@@ -4338,7 +4333,7 @@ bool MapWnd::ZoomToHomeSystem()
 bool MapWnd::ZoomToPrevOwnedSystem()
 {
     // TODO: go through these in some sorted order (the sort method used in the SidePanel system name drop-list)
-    std::vector<int> vec = GetUniverse().Objects().FindObjectIDs(OwnedVisitor<System>(HumanClientApp::GetApp()->EmpireID()));
+    std::vector<int> vec = GetUniverse().Objects().FindOwnedObjectIDs<System>(HumanClientApp::GetApp()->EmpireID());
     std::vector<int>::iterator it = std::find(vec.begin(), vec.end(), m_current_owned_system);
     if (it == vec.end()) {
         m_current_owned_system = vec.empty() ? UniverseObject::INVALID_OBJECT_ID : vec.back();
@@ -4357,7 +4352,7 @@ bool MapWnd::ZoomToPrevOwnedSystem()
 bool MapWnd::ZoomToNextOwnedSystem()
 {
     // TODO: go through these in some sorted order (the sort method used in the SidePanel system name drop-list)
-    std::vector<int> vec = GetUniverse().Objects().FindObjectIDs(OwnedVisitor<System>(HumanClientApp::GetApp()->EmpireID()));
+    std::vector<int> vec = GetUniverse().Objects().FindOwnedObjectIDs<System>(HumanClientApp::GetApp()->EmpireID());
     std::vector<int>::iterator it = std::find(vec.begin(), vec.end(), m_current_owned_system);
     if (it == vec.end()) {
         m_current_owned_system = vec.empty() ? UniverseObject::INVALID_OBJECT_ID : vec.front();
@@ -4415,7 +4410,7 @@ bool MapWnd::ZoomToNextIdleFleet()
 
 bool MapWnd::ZoomToPrevFleet()
 {
-    std::vector<int> vec = GetUniverse().Objects().FindObjectIDs(OwnedVisitor<Fleet>(HumanClientApp::GetApp()->EmpireID()));
+    std::vector<int> vec = GetUniverse().Objects().FindOwnedObjectIDs<Fleet>(HumanClientApp::GetApp()->EmpireID());
     std::vector<int>::iterator it = std::find(vec.begin(), vec.end(), m_current_fleet_id);
     if (it == vec.end()) {
         m_current_fleet_id = vec.empty() ? UniverseObject::INVALID_OBJECT_ID : vec.back();
@@ -4433,7 +4428,7 @@ bool MapWnd::ZoomToPrevFleet()
 
 bool MapWnd::ZoomToNextFleet()
 {
-    std::vector<int> vec = GetUniverse().Objects().FindObjectIDs(OwnedVisitor<Fleet>(HumanClientApp::GetApp()->EmpireID()));
+    std::vector<int> vec = GetUniverse().Objects().FindOwnedObjectIDs<Fleet>(HumanClientApp::GetApp()->EmpireID());
     std::vector<int>::iterator it = std::find(vec.begin(), vec.end(), m_current_fleet_id);
     if (it == vec.end()) {
         m_current_fleet_id = vec.empty() ? UniverseObject::INVALID_OBJECT_ID : vec.front();
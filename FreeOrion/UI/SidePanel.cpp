@@ -2177,14 +2177,13 @@ void SidePanel::RefreshImpl()
     // that aren't visible this turn to this client's player.  Also need to
     // make sure that a known object isn't also known to be destroyed, in which
     // case it shouldn't be shown.
-    const std::set<int>& destroyed_object_ids = GetUniverse().EmpireKnownDestroyedObjectIDs(app_empire_id);
     std::vector<int> known_system_planet_ids;
     std::vector<const Planet*> all_planets = objects.FindObjects<Planet>();
     for (std::vector<const Planet*>::const_iterator it = all_planets.begin(); it != all_planets.end(); ++it) {
         const Planet* planet = *it;
         int planet_id = planet->ID();
         if (planet->SystemID() == s_system_id) {
-            if (destroyed_object_ids.find(planet_id) == destroyed_object_ids.end()) // to be displayed, planet should not be in set of known destroyed objects
+            if (!GetUniverse().EmpireKnowsObjectDestroyed(planet_id, app_empire_id)) // to be displayed, planet should not be in set of known destroyed objects
                 known_system_planet_ids.push_back(planet_id);
         }
     }
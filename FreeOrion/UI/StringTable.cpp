@@ -12,6 +12,7 @@
 // static(s)
 const std::string StringTable_::S_DEFAULT_FILENAME = "eng_stringtable.txt";
 const std::string StringTable_::S_ERROR_STRING = "ERROR: ";
+const StringTable_::Handle StringTable_::INVALID_HANDLE = static_cast<StringTable_::Handle>(-1);
 
 // StringTable
 StringTable_::StringTable_():
@@ -27,20 +28,32 @@ StringTable_::~StringTable_()
 
 bool StringTable_::StringExists(const std::string& index) const
 {
-    return m_strings.find(index) != m_strings.end();
+    return m_index.find(index) != m_index.end();
 }
 
 const std::string& StringTable_::operator[] (const std::string& index) const
 {
     static std::string error_retval;
-    std::map<std::string, std::string>::const_iterator it = m_strings.find(index);
-    return it == m_strings.end() ? error_retval = S_ERROR_STRING + index : it->second;
+    boost::unordered_map<std::string, Handle>::const_iterator it = m_index.find(index);
+    return it == m_index.end() ? error_retval = S_ERROR_STRING + index : m_strings[it->second];
+}
+
+StringTable_::Handle StringTable_::StringHandle(const std::string& index) const
+{
+    boost::unordered_map<std::string, Handle>::const_iterator it = m_index.find(index);
+    return it == m_index.end() ? INVALID_HANDLE : it->second;
+}
+
+const std::string& StringTable_::String(Handle handle) const
+{
+    return handle < m_strings.size() ? m_strings[handle] : S_ERROR_STRING;
 }
 
 void StringTable_::Load()
 {
     std::ifstream ifs(m_filename.c_str());
     std::string file_contents;
+    std::map<std::string, std::string> strings;
 
     //skip byte order mark (BOM)
     static const int UTF8_BOM[3] = {0x00EF, 0x00BB, 0x00BF};
@@ -111,9 +124,9 @@ void StringTable_::Load()
                     else if (it->regex_id() == SINGLE_LINE_VALUE.regex_id() ||
                              it->regex_id() == MULTI_LINE_VALUE.regex_id()) {
                         assert(key != "");
-                        if (m_strings.find(key) == m_strings.end()) {
-                            m_strings[key] = it->str();
-                            boost::algorithm::replace_all(m_strings[key], "\\n", "\n");
+                        if (strings.find(key) == strings.end()) {
+                            strings[key] = it->str();
+                            boost::algorithm::replace_all(strings[key], "\\n", "\n");
                         } else {
                             Logger().errorStream() << "Duplicate string ID found: '" << key
                                                    << "' in file: '" << m_filename
@@ -133,12 +146,13 @@ void StringTable_::Load()
     } catch (std::exception& e) {
         Logger().errorStream() << "Exception caught regex parsing Stringtable: " << e.what();
         std::cerr << "Exception caught regex parsing Stringtable: " << e.what() << std::endl;
+        Index(strings);
         return;
     }
 
     if (well_formed) {
         // recursively expand keys -- replace [[KEY]] by the text resulting from expanding everything in the definition for KEY
-        for (std::map<std::string, std::string>::iterator map_it = m_strings.begin(); map_it != m_strings.end(); ++map_it)
+        for (std::map<std::string, std::string>::iterator map_it = strings.begin(); map_it != strings.end(); ++map_it)
         {
             std::size_t position = 0; // position in the definition string, past the already processed part
             smatch match;
@@ -148,8 +162,8 @@ void StringTable_::Load()
                 position += match.position();
                 if (cyclic_reference_check.find(match[1]) == cyclic_reference_check.end()) {
                     cyclic_reference_check.insert(match[1]);
-                    std::map<std::string, std::string>::iterator map_lookup_it = m_strings.find(match[1]);
-                    if (map_lookup_it != m_strings.end()) {
+                    std::map<std::string, std::string>::iterator map_lookup_it = strings.find(match[1]);
+                    if (map_lookup_it != strings.end()) {
                         const std::string substitution = map_lookup_it->second;
                         map_it->second.replace(position, match.length(), substitution);
                         // replace recursively -- do not skip past substitution
@@ -165,14 +179,14 @@ void StringTable_::Load()
         }
 
         // nonrecursively replace references -- convert [[type REF]] to <type REF>string for REF</type>
-        for (std::map<std::string, std::string>::iterator map_it = m_strings.begin(); map_it != m_strings.end(); ++map_it)
+        for (std::map<std::string, std::string>::iterator map_it = strings.begin(); map_it != strings.end(); ++map_it)
         {
             std::size_t position = 0; // position in the definition string, past the already processed part
             smatch match;
             while (regex_search(map_it->second.begin() + position, map_it->second.end(), match, REFERENCE)) {
                 position += match.position();
-                std::map<std::string, std::string>::iterator map_lookup_it = m_strings.find(match[2]);
-                if (map_lookup_it != m_strings.end()) {
+                std::map<std::string, std::string>::iterator map_lookup_it = strings.find(match[2]);
+                if (map_lookup_it != strings.end()) {
                     const std::string substitution =
                         '<' + match[1].str() + ' ' + match[2].str() + '>' + map_lookup_it->second + "</" + match[1].str() + '>';
                     map_it->second.replace(position, match.length(), substitution);
@@ -186,4 +200,18 @@ void StringTable_::Load()
     } else {
         Logger().errorStream() << "StringTable file \"" << m_filename << "\" is malformed";
     }
+
+    Index(strings);
+}
+
+void StringTable_::Index(const std::map<std::string, std::string>& strings)
+{
+    m_strings.clear();
+    m_index.clear();
+    m_strings.reserve(strings.size());
+    m_index.rehash(strings.size());
+    for (std::map<std::string, std::string>::const_iterator it = strings.begin(); it != strings.end(); ++it) {
+        m_index[it->first] = m_strings.size();
+        m_strings.push_back(it->second);
+    }
 }
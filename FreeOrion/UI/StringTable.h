@@ -4,9 +4,11 @@
 #define StringTable__h_
 
 #include <boost/lexical_cast.hpp>
+#include <boost/unordered_map.hpp>
 
 #include <string>
 #include <map>
+#include <vector>
 #include <fstream>
 
 // HACK! StringTable is renamed to StringTable_ because freeimage defines
@@ -48,9 +50,16 @@
 //! <br>
 //! TESTFOUR<br>
 //! test four<br>
+//!
+//! Once loaded, the table is immutable.  Strings are stored in a flat array
+//! and indexed by a hash map, so lookups by key are constant-time on average.
+//! Each string also has a stable Handle (its position in the array) that can
+//! be looked up once and then used to retrieve the string without hashing.
 class StringTable_
 {
 public:
+    typedef std::size_t Handle;     //!< stable identifier of a string within a loaded StringTable_
+
     //! \names Structors
     //!@{
     StringTable_();  //!< default construction, uses S_DEFAULT_FILENAME
@@ -70,6 +79,14 @@ public:
     //! @return true iff a string exists with that index, false otherwise
     bool StringExists(const std::string& index) const;              //!< Looks up a string at index and returns if the string is present.
 
+    //! @param index The index of the string to lookup
+    //! @return The handle of the string at index, or INVALID_HANDLE if there is no such string
+    Handle StringHandle(const std::string& index) const;            //!< Looks up the stable handle of the string at index.
+
+    //! @param handle A handle previously returned by StringHandle()
+    //! @return The string with the given handle, or S_ERROR_STRING if the handle is invalid
+    const std::string& String(Handle handle) const;                 //!< Returns the string with the given handle.
+
     //! @param index The index of the string to lookup
     //! @return The string found at index in the table
     inline const std::string& String(const std::string& index) const { return operator[] (index); } //!< Interface to operator() \see StringTable_::operator[]
@@ -81,19 +98,22 @@ public:
     //!@{
     static const std::string S_DEFAULT_FILENAME; //!< the default file used if none specified
     static const std::string S_ERROR_STRING;     //!< A string that gets returned when invalid indices are used
+    static const Handle      INVALID_HANDLE;     //!< returned by StringHandle() for indices not in the table
     //!@}
 
 private:
     //! \name Internal Functions
     //!@{
     void Load();    //!< Loads the String table file from m_filename
+    void Index(const std::map<std::string, std::string>& strings);  //!< Replaces the contents of the table with \a strings
     //!@}
 
     //! \name Data Members
     //!@{
     std::string m_filename;    //!< the name of the file this StringTable_ was constructed with
     std::string m_language;    //!< A string containing the name of the language used
-    std::map<std::string, std::string> m_strings;  //!< The strings in the table
+    std::vector<std::string>                    m_strings;  //!< The strings in the table, indexed by Handle
+    boost::unordered_map<std::string, Handle>   m_index;    //!< The handles of the strings in the table, by string index
     //!@}
     
 };
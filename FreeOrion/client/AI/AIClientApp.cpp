@@ -113,12 +113,11 @@ void AIClientApp::Run()
     while (1) {
         if (!Networking().Connected())
             break;
-        if (Networking().MessageAvailable()) {
-            Message msg;
-            Networking().GetMessage(msg);
-            HandleMessage(msg);
-        } else {
-            Sleep(250);
+        if (Networking().WaitForMessage(boost::posix_time::milliseconds(250))) {
+            std::list<Message> messages;
+            Networking().GetMessages(messages);
+            for (std::list<Message>::const_iterator it = messages.begin(); it != messages.end(); ++it)
+                HandleMessage(*it);
         }
     }
 }
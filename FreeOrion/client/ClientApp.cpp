@@ -13,17 +13,18 @@
 ClientApp* ClientApp::s_app = 0;
 
 ClientApp::ClientApp() :
-    m_universe(),
+    m_game(),
     m_empire_id(ALL_EMPIRES),
-    m_current_turn(INVALID_GAME_TURN)
+    m_orders_streamed(false)
 {
 #ifdef FREEORION_BUILD_HUMAN
-    EmpireEliminatedSignal.connect(boost::bind(&Universe::HandleEmpireElimination, &m_universe, _1));
+    EmpireEliminatedSignal.connect(boost::bind(&Universe::HandleEmpireElimination, &m_game.m_universe, _1));
 #endif
 
     if (s_app)
         throw std::runtime_error("Attempted to construct a second instance of ClientApp");
     s_app = this;
+    GameContext::SetDefault(&m_game);
 }
 
 ClientApp::~ClientApp()
@@ -36,13 +37,13 @@ int ClientApp::EmpireID() const
 { return m_empire_id; }
 
 int ClientApp::CurrentTurn() const
-{ return m_current_turn; }
+{ return m_game.m_current_turn; }
 
 const Universe& ClientApp::GetUniverse() const
-{ return m_universe; }
+{ return m_game.m_universe; }
 
 const EmpireManager& ClientApp::Empires() const
-{ return m_empires; }
+{ return m_game.m_empires; }
 
 const OrderSet& ClientApp::Orders() const
 { return m_orders; }
@@ -57,7 +58,7 @@ const Empire* ClientApp::GetPlayerEmpire(int player_id) const
 {
     std::map<int, PlayerInfo>::const_iterator it = m_player_info.find(player_id);
     if (it != m_player_info.end())
-        return m_empires.Lookup(it->second.empire_id);
+        return m_game.m_empires.Lookup(it->second.empire_id);
     return 0;
 }
 
@@ -65,7 +66,7 @@ Empire* ClientApp::GetPlayerEmpire(int player_id)
 {
     std::map<int, PlayerInfo>::const_iterator it = m_player_info.find(player_id);
     if (it != m_player_info.end())
-        return m_empires.Lookup(it->second.empire_id);
+        return m_game.m_empires.Lookup(it->second.empire_id);
     return 0;
 }
 
@@ -84,8 +85,23 @@ const std::map<int, PlayerInfo>& ClientApp::Players() const
 
 void ClientApp::StartTurn()
 {
-    m_networking.SendMessage(TurnOrdersMessage(m_networking.PlayerID(), m_orders));
+    // if orders have been streamed during the turn, the server only needs the
+    // remaining changes, and otherwise it needs all the orders
+    if (m_orders_streamed)
+        m_networking.SendMessage(TurnPartialOrdersMessage(m_networking.PlayerID(), m_orders, true));
+    else
+        m_networking.SendMessage(TurnOrdersMessage(m_networking.PlayerID(), m_orders));
     m_orders.Reset();
+    m_orders_streamed = false;
+}
+
+void ClientApp::SendPartialOrders()
+{
+    if (!m_orders.HasChanges())
+        return;
+    m_networking.SendMessage(TurnPartialOrdersMessage(m_networking.PlayerID(), m_orders, false));
+    m_orders.ClearChanges();
+    m_orders_streamed = true;
 }
 
 void ClientApp::SendCombatSetup()
@@ -101,10 +117,10 @@ void ClientApp::StartCombatTurn()
 }
 
 Universe& ClientApp::GetUniverse()
-{ return m_universe; }
+{ return m_game.m_universe; }
 
 EmpireManager& ClientApp::Empires()
-{ return m_empires; }
+{ return m_game.m_empires; }
 
 OrderSet& ClientApp::Orders()
 { return m_orders; }
@@ -144,10 +160,10 @@ void ClientApp::SetEmpireID(int id)
 { m_empire_id = id; }
 
 void ClientApp::SetCurrentTurn(int turn)
-{ m_current_turn = turn; }
+{ m_game.m_current_turn = turn; }
 
 int& ClientApp::EmpireIDRef()
 { return m_empire_id; }
 
 int& ClientApp::CurrentTurnRef()
-{ return m_current_turn; }
+{ return m_game.m_current_turn; }
@@ -7,6 +7,7 @@
 #include "../network/Message.h"
 #include "../universe/Universe.h"
 #include "../util/AppInterface.h"
+#include "../util/GameContext.h"
 #include "../util/OrderSet.h"
 
 #include <string>
@@ -45,6 +46,7 @@ public:
 
     /** \name Mutators */ //@{
     virtual void            StartTurn();         ///< encodes order sets and sends turn orders message
+    void                    SendPartialOrders(); ///< sends orders issued or rescinded since the last call to the server, so they can be validated before the turn ends; does nothing if there are none
     virtual void            SendCombatSetup();   ///< encodes and sends combat setup orders message
     virtual void            StartCombatTurn();   ///< encodes combat order sets and sends combat turn orders message
 
@@ -79,13 +81,12 @@ protected:
     int& CurrentTurnRef();          ///< returns the current game turn
     //@}
 
-    Universe                  m_universe;
-    EmpireManager             m_empires;
+    GameContext               m_game;           ///< the universe, empires and current turn as known to this client
     OrderSet                  m_orders;
     CombatOrderSet            m_combat_orders;
     ClientNetworking          m_networking;
     int                       m_empire_id;
-    int                       m_current_turn;
+    bool                      m_orders_streamed; ///< true iff SendPartialOrders() has sent orders to the server during the current turn
     std::map<int, PlayerInfo> m_player_info;    ///< indexed by player id, contains info about all players in the game
 
 private:
@@ -0,0 +1,390 @@
+#include "BotClientApp.h"
+
+#include "../../util/Directories.h"
+#include "../../util/MultiplayerCommon.h"
+#include "../../util/OptionsDB.h"
+#include "../../util/Order.h"
+#include "../../util/OrderSet.h"
+#include "../../util/Random.h"
+#include "../../util/Serialize.h"
+#include "../../network/Message.h"
+#include "../../universe/Fleet.h"
+#include "../../universe/Species.h"
+#include "../../universe/Universe.h"
+#include "../../Empire/Empire.h"
+
+#include <log4cpp/Appender.hh>
+#include <log4cpp/Category.hh>
+#include <log4cpp/PatternLayout.hh>
+#include <log4cpp/FileAppender.hh>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/timer.hpp>
+
+
+namespace {
+    // command-line options
+    void AddOptions(OptionsDB& db) {
+        db.Add<std::string>("bot-name",         "Player name of this bot; also names its log and default report file.", "Bot");
+        db.Add<std::string>("bot-server",       "Address of the server to connect to.",                                 "localhost");
+        db.AddFlag("bot-host",                  "Host a new multiplayer game, instead of joining one.");
+        db.Add<int>("bot-players",              "Number of players, including the host, to wait for before starting the game.  Used only with --bot-host.", 2, RangedValidator<int>(1, 64));
+        db.Add<int>("bot-galaxy-size",          "Number of systems in the galaxy.  Used only with --bot-host.",        100, RangedValidator<int>(10, 10000));
+        db.Add<int>("bot-turns",                "Number of turn updates to receive before disconnecting.",             10, RangedValidator<int>(1, 10000));
+        db.Add<std::string>("bot-orders",       "Orders to issue each turn: \"none\", or \"random\" to move each idle fleet to a random adjacent system.", "random");
+        db.Add<int>("bot-seed",                 "Random seed used for orders; 0 seeds from the clock.",                0);
+        db.Add<std::string>("bot-report",       "File to which per-turn timings are written; defaults to <bot-name>_report.csv in the user directory.", "");
+    }
+    bool temp_bool = RegisterOptions(&AddOptions);
+
+    /** Returns \a t as microseconds since the epoch, so that times recorded
+      * by bots running on the same machine can be compared. */
+    long long MicrosecondsSinceEpoch(const boost::posix_time::ptime& t) {
+        static const boost::posix_time::ptime EPOCH(boost::gregorian::date(1970, 1, 1));
+        return (t - EPOCH).total_microseconds();
+    }
+}
+
+////////////////////////////////////////////////
+// BotClientApp::TurnRecord
+////////////////////////////////////////////////
+BotClientApp::TurnRecord::TurnRecord() :
+    turn(INVALID_GAME_TURN),
+    orders_sent(),
+    update_received(),
+    extract_seconds(0.0),
+    update_bytes(0),
+    orders(0)
+{}
+
+////////////////////////////////////////////////
+// BotClientApp
+////////////////////////////////////////////////
+// static member(s)
+BotClientApp*  BotClientApp::s_app = 0;
+
+BotClientApp::BotClientApp() :
+    m_player_name(GetOptionsDB().Get<std::string>("bot-name")),
+    m_host(GetOptionsDB().Get<bool>("bot-host")),
+    m_game_started(false),
+    m_done(false),
+    m_turns_played(0),
+    m_orders_sent(),
+    m_turn_records()
+{
+    if (s_app)
+        throw std::runtime_error("Attempted to construct a second instance of singleton class BotClientApp");
+
+    s_app = this;
+
+    const std::string BOTCLIENT_LOG_FILENAME((GetUserDir() / (m_player_name + ".log")).string());
+
+    // a platform-independent way to erase the old log
+    std::ofstream temp(BOTCLIENT_LOG_FILENAME.c_str());
+    temp.close();
+
+    // establish debug logging
+    log4cpp::Appender* appender = new log4cpp::FileAppender("FileAppender", BOTCLIENT_LOG_FILENAME);
+    log4cpp::PatternLayout* layout = new log4cpp::PatternLayout();
+    layout->setConversionPattern("%d %p Bot : %m%n");
+    appender->setLayout(layout);
+    Logger().setAdditivity(false);  // make appender the only appender used...
+    Logger().setAppender(appender);
+    Logger().setAdditivity(true);   // ...but allow the addition of others later
+    Logger().setPriority(PriorityValue(GetOptionsDB().Get<std::string>("log-level")));
+    Logger().debug(m_player_name + " logger initialized.");
+
+    int seed = GetOptionsDB().Get<int>("bot-seed");
+    if (seed)
+        Seed(static_cast<unsigned int>(seed));
+    else
+        ClockSeed();
+}
+
+BotClientApp::~BotClientApp()
+{ Logger().debug("Shutting down " + m_player_name + " logger..."); }
+
+void BotClientApp::operator()()
+{ Run(); }
+
+BotClientApp* BotClientApp::GetApp()
+{ return s_app; }
+
+void BotClientApp::Run()
+{
+    if (!Connect()) {
+        Logger().fatalStream() << "BotClientApp::Run : Failed to connect to server at "
+                               << GetOptionsDB().Get<std::string>("bot-server") << ".  Exiting.";
+        return;
+    }
+
+    if (m_host)
+        m_networking.SendMessage(HostMPGameMessage(m_player_name));
+    else
+        m_networking.SendMessage(JoinGameMessage(m_player_name, Networking::CLIENT_TYPE_HUMAN_PLAYER, true));
+
+    // respond to messages until done or disconnected
+    while (!m_done) {
+        if (!m_networking.Connected()) {
+            Logger().errorStream() << "BotClientApp::Run : Disconnected from server after "
+                                   << m_turns_played << " turns";
+            break;
+        }
+        if (m_networking.WaitForMessage(boost::posix_time::milliseconds(250))) {
+            std::list<Message> messages;
+            m_networking.GetMessages(messages);
+            for (std::list<Message>::const_iterator it = messages.begin(); it != messages.end() && !m_done; ++it)
+                HandleMessage(*it);
+        }
+    }
+
+    WriteReport();
+    if (m_networking.Connected())
+        m_networking.DisconnectFromServer();
+}
+
+bool BotClientApp::Connect()
+{
+    const std::string& server = GetOptionsDB().Get<std::string>("bot-server");
+    const int MAX_TRIES = 10;
+    for (int tries = 0; tries < MAX_TRIES; ++tries) {
+        Logger().debugStream() << "Attempting to contact server";
+        bool connected = (server == "localhost") ?
+            m_networking.ConnectToLocalHostServer() :
+            m_networking.ConnectToServer(server);
+        if (connected)
+            return true;
+        Logger().errorStream() << "Server contact attempt " << tries + 1 << " failed";
+    }
+    return false;
+}
+
+void BotClientApp::HandleMessage(const Message& msg)
+{
+    switch (msg.Type()) {
+    case Message::ERROR: {
+        std::string problem;
+        bool fatal = false;
+        ExtractMessageData(msg, problem, fatal);
+        Logger().errorStream() << "BotClientApp::HandleMessage : Received ERROR message from server: " << problem;
+        if (fatal)
+            m_done = true;
+        break;
+    }
+
+    case Message::HOST_MP_GAME:
+        m_networking.SetPlayerID(msg.ReceivingPlayer());
+        m_networking.SetHostPlayerID(msg.ReceivingPlayer());
+        Logger().debugStream() << "BotClientApp::HandleMessage : Hosting game as player " << msg.ReceivingPlayer();
+        break;
+
+    case Message::JOIN_GAME:
+        if (msg.SendingPlayer() == Networking::INVALID_PLAYER_ID && PlayerID() == Networking::INVALID_PLAYER_ID) {
+            m_networking.SetPlayerID(msg.ReceivingPlayer());
+            Logger().debugStream() << "BotClientApp::HandleMessage : Joined game as player " << msg.ReceivingPlayer();
+        }
+        break;
+
+    case Message::HOST_ID: {
+        int host_id = Networking::INVALID_PLAYER_ID;
+        try {
+            host_id = boost::lexical_cast<int>(msg.Text());
+        } catch (...) {
+            Logger().errorStream() << "BotClientApp::HandleMessage for HOST_ID : Couldn't parse message text: " << msg.Text();
+        }
+        m_networking.SetHostPlayerID(host_id);
+        break;
+    }
+
+    case Message::LOBBY_UPDATE:
+        HandleLobbyUpdate(msg);
+        break;
+
+    case Message::GAME_START:
+        if (msg.SendingPlayer() == Networking::INVALID_PLAYER_ID)
+            HandleTurnStart(msg, true);
+        break;
+
+    case Message::TURN_UPDATE:
+        if (msg.SendingPlayer() == Networking::INVALID_PLAYER_ID)
+            HandleTurnStart(msg, false);
+        break;
+
+    case Message::TURN_PARTIAL_UPDATE:
+        if (msg.SendingPlayer() == Networking::INVALID_PLAYER_ID)
+            ExtractMessageData(msg, EmpireIDRef(), GetUniverse());
+        break;
+
+    case Message::SAVE_GAME:
+        m_networking.SendMessage(ClientSaveDataMessage(PlayerID(), Orders()));
+        break;
+
+    case Message::COMBAT_START: {
+        CombatData combat_data;
+        std::vector<CombatSetupGroup> setup_groups;
+        Universe::ShipDesignMap foreign_designs;
+        ExtractMessageData(msg, combat_data, setup_groups, foreign_designs);
+        SendCombatSetup();
+        break;
+    }
+
+    case Message::COMBAT_TURN_UPDATE: {
+        CombatData combat_data;
+        ExtractMessageData(msg, combat_data);
+        StartCombatTurn();
+        break;
+    }
+
+    case Message::END_GAME:
+        Logger().debugStream() << "BotClientApp::HandleMessage : Received END_GAME";
+        m_done = true;
+        break;
+
+    case Message::LOBBY_CHAT:
+    case Message::TURN_PROGRESS:
+    case Message::PLAYER_STATUS:
+    case Message::COMBAT_END:
+    case Message::PLAYER_CHAT:
+    case Message::VICTORY_DEFEAT:
+    case Message::PLAYER_ELIMINATED:
+        break;
+
+    default:
+        Logger().errorStream() << "BotClientApp::HandleMessage : Received unknown Message type code " << msg.Type();
+        break;
+    }
+}
+
+void BotClientApp::HandleLobbyUpdate(const Message& msg)
+{
+    if (!m_host || m_game_started)
+        return;
+
+    MultiplayerLobbyData lobby_data;
+    ExtractMessageData(msg, lobby_data);
+
+    int expected_players = GetOptionsDB().Get<int>("bot-players");
+    Logger().debugStream() << "BotClientApp::HandleLobbyUpdate : " << lobby_data.m_players.size()
+                           << " of " << expected_players << " players in lobby";
+    if (static_cast<int>(lobby_data.m_players.size()) < expected_players)
+        return;
+
+    lobby_data.m_new_game = true;
+    lobby_data.m_size = GetOptionsDB().Get<int>("bot-galaxy-size");
+    m_networking.SendMessage(LobbyUpdateMessage(PlayerID(), lobby_data));
+    m_networking.SendMessage(StartMPGameMessage(PlayerID()));
+    m_game_started = true;
+}
+
+void BotClientApp::HandleTurnStart(const Message& msg, bool game_start)
+{
+    TurnRecord record;
+    record.update_received = boost::posix_time::microsec_clock::universal_time();
+    record.orders_sent = m_orders_sent;
+    record.update_bytes = msg.Size();
+
+    boost::timer timer;
+    if (game_start) {
+        bool single_player_game;        // ignored
+        bool loaded_game_data;          // ignored
+        bool ui_data_available;         // ignored
+        SaveGameUIData ui_data;         // ignored
+        bool state_string_available;    // ignored
+        std::string save_state_string;  // ignored
+        ExtractMessageData(msg,                     single_player_game,     EmpireIDRef(),
+                           CurrentTurnRef(),        Empires(),              GetUniverse(),
+                           GetSpeciesManager(),     m_player_info,          Orders(),
+                           loaded_game_data,        ui_data_available,      ui_data,
+                           state_string_available,  save_state_string);
+        m_game_started = true;
+    } else {
+        ExtractMessageData(msg,                     EmpireIDRef(),          CurrentTurnRef(),
+                           Empires(),               GetUniverse(),          GetSpeciesManager(),
+                           m_player_info);
+    }
+    record.extract_seconds = timer.elapsed();
+    record.turn = CurrentTurn();
+
+    if (GetOptionsDB().Get<int>("bot-turns") <= ++m_turns_played) {
+        m_done = true;
+    } else {
+        record.orders = IssueOrders();
+        EndTurn();
+    }
+
+    Logger().debugStream() << "BotClientApp::HandleTurnStart : turn " << record.turn << ": update of "
+                           << record.update_bytes << " bytes extracted in " << record.extract_seconds
+                           << " s; issued " << record.orders << " orders";
+    m_turn_records.push_back(record);
+}
+
+int BotClientApp::IssueOrders()
+{
+    if (GetOptionsDB().Get<std::string>("bot-orders") != "random")
+        return 0;
+
+    int empire_id = EmpireID();
+    const Universe& universe = GetUniverse();
+    std::vector<const Fleet*> fleets = universe.Objects().FindOwnedObjects<Fleet>(empire_id);
+
+    int orders = 0;
+    for (std::vector<const Fleet*>::const_iterator it = fleets.begin(); it != fleets.end(); ++it) {
+        const Fleet* fleet = *it;
+        int system_id = fleet->SystemID();
+        if (system_id == UniverseObject::INVALID_OBJECT_ID ||
+            (fleet->FinalDestinationID() != UniverseObject::INVALID_OBJECT_ID && fleet->FinalDestinationID() != system_id))
+        { continue; }
+
+        std::map<double, int> neighbors = universe.ImmediateNeighbors(system_id, empire_id);
+        if (neighbors.empty())
+            continue;
+        std::map<double, int>::const_iterator neighbor_it = neighbors.begin();
+        std::advance(neighbor_it, RandSmallInt(0, static_cast<int>(neighbors.size()) - 1));
+
+        Orders().IssueOrder(OrderPtr(new FleetMoveOrder(empire_id, fleet->ID(), system_id, neighbor_it->second)));
+        ++orders;
+    }
+    return orders;
+}
+
+void BotClientApp::EndTurn()
+{
+    m_orders_sent = boost::posix_time::microsec_clock::universal_time();
+    StartTurn();
+}
+
+void BotClientApp::WriteReport() const
+{
+    std::string report_filename = GetOptionsDB().Get<std::string>("bot-report");
+    if (report_filename.empty())
+        report_filename = (GetUserDir() / (m_player_name + "_report.csv")).string();
+
+    // write to a temporary file that is renamed once complete, so that the
+    // report never appears partially written to whoever is waiting for it
+    boost::filesystem::path report_path(report_filename);
+    boost::filesystem::path temp_path(report_filename + ".tmp");
+    {
+        boost::filesystem::ofstream ofs(temp_path);
+        ofs << "player,turn,orders_sent_us,update_received_us,latency_ms,extract_ms,update_bytes,orders\n";
+        for (std::vector<TurnRecord>::const_iterator it = m_turn_records.begin(); it != m_turn_records.end(); ++it) {
+            bool have_orders_sent = !it->orders_sent.is_not_a_date_time();
+            ofs << m_player_name << ','
+                << it->turn << ','
+                << (have_orders_sent ? MicrosecondsSinceEpoch(it->orders_sent) : 0) << ','
+                << MicrosecondsSinceEpoch(it->update_received) << ','
+                << (have_orders_sent ? (it->update_received - it->orders_sent).total_microseconds() / 1000.0 : 0.0) << ','
+                << it->extract_seconds * 1000.0 << ','
+                << it->update_bytes << ','
+                << it->orders << '\n';
+        }
+    }
+    try {
+        if (boost::filesystem::exists(report_path))
+            boost::filesystem::remove(report_path);
+        boost::filesystem::rename(temp_path, report_path);
+    } catch (const std::exception& e) {
+        Logger().errorStream() << "BotClientApp::WriteReport : Unable to write " << report_filename << ": " << e.what();
+    }
+}
@@ -0,0 +1,67 @@
+// -*- C++ -*-
+#ifndef _BotClientApp_h_
+#define _BotClientApp_h_
+
+#include "../ClientApp.h"
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <vector>
+
+
+/** the application framework for a headless "bot" FreeOrion client, used to
+    load test the server.  A bot joins a multiplayer game over the network, or
+    hosts one and starts it once the expected number of players have joined.
+    It then deserializes each turn update it receives, issues orders, and ends
+    its turn immediately, for a set number of turns.  It needs neither a GPU
+    nor Python.  The time each turn update took to arrive after the bot's
+    orders were sent is written to a report file when the bot exits. */
+class BotClientApp : public ClientApp
+{
+public:
+    /** \name Structors */ //@{
+    BotClientApp();
+    ~BotClientApp();
+    //@}
+
+    /** \name Mutators */ //@{
+    void                operator()();   ///< external interface to Run()
+    //@}
+
+    static BotClientApp*GetApp();       ///< returns a BotClientApp pointer to the singleton instance of the app
+
+private:
+    /** Timings and sizes recorded for one turn. */
+    struct TurnRecord
+    {
+        TurnRecord();
+
+        int                         turn;
+        boost::posix_time::ptime    orders_sent;        ///< when the orders that ended the previous turn were sent
+        boost::posix_time::ptime    update_received;    ///< when the update that started this turn was received
+        double                      extract_seconds;    ///< time taken to deserialize the update
+        std::size_t                 update_bytes;       ///< size of the update message
+        int                         orders;             ///< number of orders issued this turn
+    };
+
+    void                Run();          ///< connects to the server and handles messages until done or disconnected
+    bool                Connect();
+    void                HandleMessage(const Message& msg);
+    void                HandleLobbyUpdate(const Message& msg);
+    void                HandleTurnStart(const Message& msg, bool game_start);
+    int                 IssueOrders();  ///< issues this turn's orders, according to the bot-orders option, and returns how many were issued
+    void                EndTurn();
+    void                WriteReport() const;
+
+    std::string                 m_player_name;
+    bool                        m_host;
+    bool                        m_game_started;
+    bool                        m_done;
+    int                         m_turns_played;
+    boost::posix_time::ptime    m_orders_sent;
+    std::vector<TurnRecord>     m_turn_records;
+
+    static BotClientApp*s_app;
+};
+
+#endif // _BotClientApp_h_
@@ -0,0 +1,282 @@
+#include "../../util/Directories.h"
+#include "../../util/MultiplayerCommon.h"
+#include "../../util/Process.h"
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+
+/* Load test driver: starts freeoriond and a number of freeorionbot clients on
+   this machine, waits for the bots to play the requested number of turns,
+   and summarizes the timings they report.  One bot hosts the game; the rest
+   join it.  Per-bot reports and a per-turn summary are left in the loadtest
+   directory under the user directory. */
+
+namespace {
+    const std::string BOT_NAME_PREFIX = "LoadTestBot_";
+
+    struct LoadTestSettings
+    {
+        LoadTestSettings() :
+            clients(4),
+            turns(10),
+            galaxy_size(100),
+            orders("random")
+        {}
+
+        int         clients;
+        int         turns;
+        int         galaxy_size;
+        std::string orders;
+    };
+
+    /** One line of a bot's report; see BotClientApp::WriteReport(). */
+    struct BotTurnRecord
+    {
+        BotTurnRecord() :
+            orders_sent_us(0),
+            update_received_us(0),
+            extract_ms(0.0),
+            update_bytes(0)
+        {}
+
+        long long   orders_sent_us;
+        long long   update_received_us;
+        double      extract_ms;
+        std::size_t update_bytes;
+    };
+
+    /** Timings of one turn, over all bots. */
+    struct TurnSummary
+    {
+        TurnSummary() :
+            last_orders_sent_us(0),
+            first_update_us(0),
+            last_update_us(0),
+            total_extract_ms(0.0),
+            total_update_bytes(0),
+            bots(0)
+        {}
+
+        long long   last_orders_sent_us;
+        long long   first_update_us;
+        long long   last_update_us;
+        double      total_extract_ms;
+        std::size_t total_update_bytes;
+        int         bots;
+    };
+
+    const int MIN_CLIENTS = 1;
+    const int MAX_CLIENTS = 64;
+    const int MIN_GALAXY_SIZE = 10;
+    const int MAX_GALAXY_SIZE = 10000;
+
+    void print_help()
+    {
+        std::cout << "Usage: freeorionloadtest clients [turns [galaxy_size [none|random]]]\n"
+                  << "Starts freeoriond and the given number of freeorionbot clients, which play the given number\n"
+                  << "of turns (default 10) in a galaxy of the given size (default 100), issuing no orders or\n"
+                  << "random fleet moves (the default), then prints the time the server took to send each turn's\n"
+                  << "update after the last bot's orders arrived.\n"
+                  << "clients must be from " << MIN_CLIENTS << " to " << MAX_CLIENTS << ", and galaxy_size from "
+                  << MIN_GALAXY_SIZE << " to " << MAX_GALAXY_SIZE << "." << std::endl;
+    }
+
+    std::string ExecutablePath(const std::string& name)
+    {
+#ifdef FREEORION_WIN32
+        return (GetBinDir() / (name + ".exe")).string();
+#else
+        return (GetBinDir() / name).string();
+#endif
+    }
+
+    boost::filesystem::path ReportPath(const boost::filesystem::path& report_dir, int bot)
+    { return report_dir / (BOT_NAME_PREFIX + boost::lexical_cast<std::string>(bot) + "_report.csv"); }
+
+    Process StartBot(const LoadTestSettings& settings, const boost::filesystem::path& report_dir, int bot)
+    {
+        const std::string BOT_CLIENT_EXE = ExecutablePath("freeorionbot");
+        std::vector<std::string> args;
+        args.push_back("\"" + BOT_CLIENT_EXE + "\"");
+        args.push_back("--bot-name");
+        args.push_back(BOT_NAME_PREFIX + boost::lexical_cast<std::string>(bot));
+        if (bot == 0) {
+            args.push_back("--bot-host");
+            args.push_back("--bot-players");
+            args.push_back(boost::lexical_cast<std::string>(settings.clients));
+            args.push_back("--bot-galaxy-size");
+            args.push_back(boost::lexical_cast<std::string>(settings.galaxy_size));
+        }
+        args.push_back("--bot-turns");
+        args.push_back(boost::lexical_cast<std::string>(settings.turns));
+        args.push_back("--bot-orders");
+        args.push_back(settings.orders);
+        args.push_back("--bot-seed");
+        args.push_back(boost::lexical_cast<std::string>(bot + 1));
+        args.push_back("--bot-report");
+        args.push_back(ReportPath(report_dir, bot).string());
+        return Process(BOT_CLIENT_EXE, args);
+    }
+
+    /** Reads the report of one bot, adding its turns to \a records. */
+    bool ReadReport(const boost::filesystem::path& path, std::map<int, std::vector<BotTurnRecord> >& records)
+    {
+        boost::filesystem::ifstream ifs(path);
+        if (!ifs)
+            return false;
+        std::string line;
+        std::getline(ifs, line); // header
+        while (std::getline(ifs, line)) {
+            std::vector<std::string> fields;
+            std::string::size_type start = 0;
+            for (std::string::size_type comma = line.find(','); comma != std::string::npos; comma = line.find(',', start)) {
+                fields.push_back(line.substr(start, comma - start));
+                start = comma + 1;
+            }
+            fields.push_back(line.substr(start));
+            if (fields.size() != 8)
+                continue;
+            try {
+                BotTurnRecord record;
+                int turn =                  boost::lexical_cast<int>(fields[1]);
+                record.orders_sent_us =     boost::lexical_cast<long long>(fields[2]);
+                record.update_received_us = boost::lexical_cast<long long>(fields[3]);
+                record.extract_ms =         boost::lexical_cast<double>(fields[5]);
+                record.update_bytes =       boost::lexical_cast<std::size_t>(fields[6]);
+                records[turn].push_back(record);
+            } catch (const boost::bad_lexical_cast&) {
+                std::cerr << "Skipping malformed line in " << path.string() << ": " << line << std::endl;
+            }
+        }
+        return true;
+    }
+
+    int RunLoadTest(const LoadTestSettings& settings)
+    {
+        boost::filesystem::path report_dir = GetUserDir() / "loadtest";
+        boost::filesystem::create_directories(report_dir);
+        for (int bot = 0; bot < settings.clients; ++bot) {
+            if (boost::filesystem::exists(ReportPath(report_dir, bot)))
+                boost::filesystem::remove(ReportPath(report_dir, bot));
+        }
+
+        const std::string SERVER_EXE = ExecutablePath("freeoriond");
+        std::vector<std::string> server_args;
+        server_args.push_back("\"" + SERVER_EXE + "\"");
+        Process server(SERVER_EXE, server_args);
+
+        // the host bot must have set up the multiplayer lobby before the
+        // others join it; starting a process already waits a second
+        std::vector<Process> bots;
+        for (int bot = 0; bot < settings.clients; ++bot)
+            bots.push_back(StartBot(settings, report_dir, bot));
+
+        // wait for every bot to write its report.  the whole game should take
+        // no more than a minute per turn, plus a minute to set up
+        const int TIMEOUT_SECONDS = 60 * (settings.turns + 1);
+        int finished_bots = 0;
+        for (int seconds = 0; seconds < TIMEOUT_SECONDS && finished_bots < settings.clients; ++seconds) {
+            Sleep(1000);
+            finished_bots = 0;
+            for (int bot = 0; bot < settings.clients; ++bot) {
+                if (boost::filesystem::exists(ReportPath(report_dir, bot)))
+                    ++finished_bots;
+            }
+        }
+        server.Kill();
+        if (finished_bots < settings.clients)
+            std::cerr << "Only " << finished_bots << " of " << settings.clients << " bots finished in "
+                      << TIMEOUT_SECONDS << " seconds" << std::endl;
+
+        std::map<int, std::vector<BotTurnRecord> > records;
+        for (int bot = 0; bot < settings.clients; ++bot)
+            ReadReport(ReportPath(report_dir, bot), records);
+        if (records.empty()) {
+            std::cerr << "No bot reports found in " << report_dir.string() << std::endl;
+            return 1;
+        }
+
+        std::map<int, TurnSummary> summaries;
+        for (std::map<int, std::vector<BotTurnRecord> >::const_iterator it = records.begin(); it != records.end(); ++it) {
+            TurnSummary& summary = summaries[it->first];
+            for (std::vector<BotTurnRecord>::const_iterator record_it = it->second.begin(); record_it != it->second.end(); ++record_it) {
+                summary.last_orders_sent_us = std::max(summary.last_orders_sent_us, record_it->orders_sent_us);
+                summary.first_update_us = summary.bots ? std::min(summary.first_update_us, record_it->update_received_us) : record_it->update_received_us;
+                summary.last_update_us = std::max(summary.last_update_us, record_it->update_received_us);
+                summary.total_extract_ms += record_it->extract_ms;
+                summary.total_update_bytes += record_it->update_bytes;
+                ++summary.bots;
+            }
+        }
+
+        // the server's turn time runs from the arrival of the last orders
+        // of a turn to the sending of the first update of the next one.  all
+        // bots run on this machine, so their clocks can be compared
+        boost::filesystem::path summary_path = report_dir / "summary.csv";
+        boost::filesystem::ofstream ofs(summary_path);
+        ofs << "turn,bots,turn_ms,update_spread_ms,mean_extract_ms,mean_update_bytes\n";
+        std::cout << std::setw(6) << "turn" << std::setw(6) << "bots" << std::setw(12) << "turn ms"
+                  << std::setw(12) << "spread ms" << std::setw(12) << "extract ms" << std::setw(14) << "update bytes" << "\n";
+        for (std::map<int, TurnSummary>::const_iterator it = summaries.begin(); it != summaries.end(); ++it) {
+            const TurnSummary& summary = it->second;
+            double turn_ms = summary.last_orders_sent_us ? (summary.first_update_us - summary.last_orders_sent_us) / 1000.0 : 0.0;
+            double spread_ms = (summary.last_update_us - summary.first_update_us) / 1000.0;
+            double extract_ms = summary.total_extract_ms / summary.bots;
+            std::size_t update_bytes = summary.total_update_bytes / summary.bots;
+            ofs << it->first << ',' << summary.bots << ',' << turn_ms << ',' << spread_ms << ','
+                << extract_ms << ',' << update_bytes << '\n';
+            std::cout << std::setw(6) << it->first << std::setw(6) << summary.bots
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(12) << turn_ms << std::setw(12) << spread_ms << std::setw(12) << extract_ms
+                      << std::setw(14) << update_bytes << "\n";
+        }
+        std::cout << "Reports written to " << report_dir.string() << std::endl;
+
+        return finished_bots < settings.clients ? 1 : 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    InitDirs(argv[0]);
+
+    if (argc < 2 || 5 < argc) {
+        print_help();
+        return 1;
+    }
+
+    LoadTestSettings settings;
+    try {
+        settings.clients = boost::lexical_cast<int>(argv[1]);
+        if (3 <= argc)
+            settings.turns = boost::lexical_cast<int>(argv[2]);
+        if (4 <= argc)
+            settings.galaxy_size = boost::lexical_cast<int>(argv[3]);
+    } catch (const boost::bad_lexical_cast&) {
+        print_help();
+        return 1;
+    }
+    if (5 <= argc)
+        settings.orders = argv[4];
+    if (settings.clients < MIN_CLIENTS || MAX_CLIENTS < settings.clients || settings.turns < 1 ||
+        settings.galaxy_size < MIN_GALAXY_SIZE || MAX_GALAXY_SIZE < settings.galaxy_size ||
+        (settings.orders != "none" && settings.orders != "random"))
+    {
+        print_help();
+        return 1;
+    }
+
+    try {
+        return RunLoadTest(settings);
+    } catch (const std::exception& e) {
+        std::cerr << "freeorionloadtest caught exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -453,7 +453,7 @@ void HumanClientApp::MultiPlayerGame()
         m_networking.SendMessage(HostMPGameMessage(server_connect_wnd.Result().first));
         m_fsm->process_event(HostMPGameRequested());
     } else {
-        m_networking.SendMessage(JoinGameMessage(server_connect_wnd.Result().first, Networking::CLIENT_TYPE_HUMAN_PLAYER));
+        m_networking.SendMessage(JoinGameMessage(server_connect_wnd.Result().first, Networking::CLIENT_TYPE_HUMAN_PLAYER, true));
         m_fsm->process_event(JoinMPGameRequested());
     }
     m_connected = true;
@@ -723,6 +723,8 @@ void HumanClientApp::HandleSystemEvents()
         Message msg;
         m_networking.GetMessage(msg);
         HandleMessage(msg);
+    } else if (m_orders.HasChanges() && m_fsm->state_cast<const PlayingTurn*>()) {
+        SendPartialOrders();
     }
 }
 
@@ -819,6 +821,7 @@ void HumanClientApp::StartGame()
 {
     m_game_started = true;
     Orders().Reset();
+    m_orders_streamed = false;
 }
 
 void HumanClientApp::Autosave()
@@ -890,9 +893,10 @@ void HumanClientApp::EndGame(bool suppress_FSM_reset)
     SetEmpireID(ALL_EMPIRES);
     m_ui->GetMapWnd()->Sanitize();
 
-    m_universe.Clear();
-    m_empires.Clear();
+    m_game.m_universe.Clear();
+    m_game.m_empires.Clear();
     m_orders.Reset();
+    m_orders_streamed = false;
     m_combat_orders.clear();
 
     if (!suppress_FSM_reset)
@@ -11,6 +11,7 @@
 #include "../universe/ShipDesign.h"
 #include "../universe/System.h"
 #include "../Empire/Empire.h"
+#include "../Empire/EmpireManager.h"
 
 #include "../util/Random.h"
 #include "../util/AppInterface.h"
@@ -380,8 +381,8 @@ void AutoResolveCombat(CombatInfo& combat_info) {
 
 
     // map from empire to set of IDs of objects that empire's objects
-    // could target.  presently valid targets are objects not owned by
-    // the empire, that are not systems or fleets
+    // could target.  presently valid targets are objects owned by empires
+    // (or monsters) at war with the empire, that are not systems or fleets
     std::map<int, std::vector<int> > empire_valid_targets;
     for (std::vector<int>::const_iterator object_it = all_combat_object_IDs.begin(); object_it != all_combat_object_IDs.end(); ++object_it) {
         int object_id = *object_it;
@@ -395,7 +396,7 @@ void AutoResolveCombat(CombatInfo& combat_info) {
              empire_it != combat_info.empire_ids.end(); ++empire_it)
         {
             int empire_id = *empire_it;
-            if (empire_id != owner) {
+            if (Empires().AtWar(empire_id, owner)) {
                 empire_valid_targets[empire_id].push_back(object_id);
             }
         }
@@ -445,7 +446,7 @@ void AutoResolveCombat(CombatInfo& combat_info) {
 
         // get valid targets set for attacker owner
         std::map<int, std::vector<int> >::iterator target_vec_it = empire_valid_targets.find(attacker_owner_id);
-        if (target_vec_it == empire_valid_targets.end()) {
+        if (target_vec_it == empire_valid_targets.end() || target_vec_it->second.empty()) {
             Logger().debugStream() << "couldn't find target set for owner with id: " << attacker_owner_id;
             continue;
         }
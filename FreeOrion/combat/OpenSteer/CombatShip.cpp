@@ -3,6 +3,7 @@
 #include "../../universe/Enums.h"
 #include "../../universe/ShipDesign.h"
 #include "../../universe/System.h"
+#include "../../util/AppInterface.h"
 #include "../CombatEventListener.h"
 #include "CombatFighter.h"
 #include "Missile.h"
@@ -403,35 +404,36 @@ void CombatShip::Init(const OpenSteer::Vec3& position_, const OpenSteer::Vec3& d
 
     double PD_minus_non_PD = 0.0;
     const std::vector<std::string>& part_names = GetShip().Design()->Parts();
+    const std::vector<const PartType*>& part_types = GetShip().Design()->PartTypes();
     for (std::size_t i = 0; i < part_names.size(); ++i) {
         if (part_names[i].empty())
             continue;
 
-        const PartType* part = GetPartType(part_names[i]);
-        assert(part);
+        const PartType* part = part_types[i];
+        if (!part) {
+            Logger().errorStream() << "CombatShip::Init couldn't get part with name " << part_names[i];
+            continue;
+        }
         if (part->Class() == PC_POINT_DEFENSE) {
-            const std::string& part_name = part->Name();
-            double damage = GetShip().GetMeter(METER_DAMAGE, part_name)->Current();
+            double damage = GetShip().GetPartMeter(i, METER_DAMAGE)->Current();
             m_raw_PD_strength +=
                 damage *
-                GetShip().GetMeter(METER_ROF, part_name)->Current() *
-                GetShip().GetMeter(METER_RANGE, part_name)->Current();
+                GetShip().GetPartMeter(i, METER_ROF)->Current() *
+                GetShip().GetPartMeter(i, METER_RANGE)->Current();
             PD_minus_non_PD += damage;
         } else if (part->Class() == PC_SHORT_RANGE) {
-            const std::string& part_name = part->Name();
-            double damage = GetShip().GetMeter(METER_DAMAGE, part_name)->Current();
+            double damage = GetShip().GetPartMeter(i, METER_DAMAGE)->Current();
             m_raw_SR_strength +=
                 damage *
-                GetShip().GetMeter(METER_ROF, part_name)->Current() *
-                GetShip().GetMeter(METER_RANGE, part_name)->Current();
+                GetShip().GetPartMeter(i, METER_ROF)->Current() *
+                GetShip().GetPartMeter(i, METER_RANGE)->Current();
             PD_minus_non_PD -= damage;
         } else if (part->Class() == PC_MISSILES) {
-            const std::string& part_name = part->Name();
-            double damage = GetShip().GetMeter(METER_DAMAGE, part_name)->Current();
+            double damage = GetShip().GetPartMeter(i, METER_DAMAGE)->Current();
             m_raw_LR_strength +=
                 damage *
-                GetShip().GetMeter(METER_ROF, part_name)->Current() *
-                GetShip().GetMeter(METER_RANGE, part_name)->Current();
+                GetShip().GetPartMeter(i, METER_ROF)->Current() *
+                GetShip().GetPartMeter(i, METER_RANGE)->Current();
             PD_minus_non_PD -= damage;
         }
     }
@@ -127,7 +127,7 @@ ClientNetworking::ClientNetworking() :
     m_host_player_id(Networking::INVALID_PLAYER_ID),
     m_io_service(),
     m_socket(m_io_service),
-    m_incoming_messages(m_mutex),
+    m_incoming_messages(m_mutex, boost::bind(&ClientNetworking::ResumeReading, this)),
     m_connected(false),
     m_cancel_retries(false)
 {}
@@ -268,6 +268,21 @@ void ClientNetworking::GetMessage(Message& message)
                                << message;
 }
 
+void ClientNetworking::GetMessages(std::list<Message>& messages)
+{
+    std::list<Message> received;
+    m_incoming_messages.PopAll(received);
+    if (TRACE_EXECUTION) {
+        for (std::list<Message>::const_iterator it = received.begin(); it != received.end(); ++it)
+            Logger().debugStream() << "ClientNetworking::GetMessages() : received message "
+                                   << *it;
+    }
+    messages.splice(messages.end(), received);
+}
+
+bool ClientNetworking::WaitForMessage(boost::posix_time::time_duration timeout)
+{ return m_incoming_messages.WaitForMessage(timeout); }
+
 void ClientNetworking::SendSynchronousMessage(Message message, Message& response_message)
 {
     if (TRACE_EXECUTION)
@@ -357,8 +372,17 @@ void ClientNetworking::HandleMessageBodyRead(boost::system::error_code error,
     } else {
         assert(static_cast<int>(bytes_transferred) <= m_incoming_header[4]);
         if (static_cast<int>(bytes_transferred) == m_incoming_header[4]) {
-            m_incoming_messages.PushBack(m_incoming_message);
-            AsyncReadMessage();
+            bool keep_reading = true;
+            if (DecompressMessage(m_incoming_message))
+                keep_reading = m_incoming_messages.PushBack(m_incoming_message);
+            else
+                Logger().errorStream() << "ClientNetworking::HandleMessageBodyRead(): dropping "
+                                       << MessageTypeStr(m_incoming_message.Type())
+                                       << " message with corrupt compressed text";
+            // when the incoming queue is full, leave further messages in the
+            // socket until ResumeReading() is called
+            if (keep_reading)
+                AsyncReadMessage();
         }
     }
 }
@@ -392,6 +416,9 @@ void ClientNetworking::AsyncReadMessage()
                                         boost::asio::placeholders::bytes_transferred));
 }
 
+void ClientNetworking::ResumeReading()
+{ m_io_service.post(boost::bind(&ClientNetworking::AsyncReadMessage, this)); }
+
 void ClientNetworking::HandleMessageWrite(boost::system::error_code error,
                                           std::size_t bytes_transferred)
 {
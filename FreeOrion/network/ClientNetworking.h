@@ -19,9 +19,9 @@
     is created and terminates when the client is connected to and disconnected
     from the server, respectively.  The entire public interface is safe to
     call from the main thread at all times.  Note that the main thread must
-    periodically request the next incoming message; the arrival of incoming
-    messages is never explicitly signalled to the main thread.  The same
-    applies to unintentional disconnects from the server.  The client must
+    periodically request the next incoming message, or block in
+    WaitForMessage() until one arrives.  Unintentional disconnects from the
+    server are never explicitly signalled to the main thread.  The client must
     periodically check Connected().
 
     The ClientNetworking has three modes of operation.  First, it can discover
@@ -93,6 +93,14 @@ public:
         case. */
     void GetMessage(Message& message);
 
+    /** Removes all incoming messages from the incoming message queue and
+        appends them, in the order received, to \a messages. */
+    void GetMessages(std::list<Message>& messages);
+
+    /** Blocks until there is at least one incoming message available or \a
+        timeout has elapsed.  Returns true iff a message is available. */
+    bool WaitForMessage(boost::posix_time::time_duration timeout);
+
     /** Sends \a message to the server, then blocks until it sees the first
         synchronous response from the server. */
     void SendSynchronousMessage(Message message, Message& response_message);
@@ -108,7 +116,7 @@ public:
     //@}
 
 private:
-    typedef boost::array<int, 5> MessageHeaderBuffer;
+    typedef boost::array<int, 6> MessageHeaderBuffer;
 
     void HandleException(const boost::system::system_error& error);
     void HandleConnection(boost::asio::ip::tcp::resolver::iterator* it,
@@ -121,6 +129,7 @@ private:
     void HandleMessageHeaderRead(boost::system::error_code error,
                                  std::size_t bytes_transferred);
     void AsyncReadMessage();
+    void ResumeReading();
     void HandleMessageWrite(boost::system::error_code error,
                             std::size_t bytes_transferred);
     void AsyncWriteMessage();
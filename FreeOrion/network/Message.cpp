@@ -10,6 +10,7 @@
 #include "../universe/Universe.h"
 #include "../universe/Species.h"
 #include "../util/OptionsDB.h"
+#include "../util/OrderSet.h"
 #include "../util/Serialize.h"
 #ifdef FREEORION_BUILD_SERVER
 #  include "../server/ServerApp.h"
@@ -23,17 +24,91 @@
 #include <boost/serialization/set.hpp>
 #include <boost/serialization/vector.hpp>
 #include <boost/serialization/weak_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/timer.hpp>
 
 #include <zlib.h>
 
+#include <cstring>
 #include <iostream>
+#include <new>
 #include <stdexcept>
 #include <sstream>
 #include <map>
 
 
 namespace {
+    const std::size_t MIN_MESSAGE_STORAGE_SIZE = 4096;  ///< smallest block allocated for message text
+    const std::size_t MAX_POOLED_BLOCKS = 8;            ///< at most this many free blocks are kept for reuse
+
+    /** Free blocks of message text storage, available for reuse.  Messages are
+        created and destroyed in both the main and networking threads, so
+        access is guarded by a mutex. */
+    struct MessageStoragePool
+    {
+        boost::mutex                                    mutex;
+        std::vector<std::pair<char*, std::size_t> >     blocks; // block and its capacity
+    };
+
+    MessageStoragePool& StoragePool()
+    {
+        // never destroyed, so that messages outliving static destruction can
+        // still return their storage
+        static MessageStoragePool* pool = new MessageStoragePool();
+        return *pool;
+    }
+
+    /** Deleter for pooled message storage; returns the block to the pool, or
+        frees it if the pool is full. */
+    struct ReturnToStoragePool
+    {
+        ReturnToStoragePool(std::size_t capacity) : m_capacity(capacity) {}
+        void operator()(char* block) const
+        {
+            MessageStoragePool& pool = StoragePool();
+            boost::mutex::scoped_lock lock(pool.mutex);
+            if (pool.blocks.size() < MAX_POOLED_BLOCKS) {
+                pool.blocks.push_back(std::make_pair(block, m_capacity));
+            } else {
+                // replace the smallest pooled block if this one is bigger
+                std::vector<std::pair<char*, std::size_t> >::iterator smallest = pool.blocks.begin();
+                for (std::vector<std::pair<char*, std::size_t> >::iterator it = pool.blocks.begin(); it != pool.blocks.end(); ++it)
+                    if (it->second < smallest->second)
+                        smallest = it;
+                if (smallest->second < m_capacity) {
+                    std::swap(smallest->first, block);
+                    smallest->second = m_capacity;
+                }
+                delete[] block;
+            }
+        }
+        std::size_t m_capacity;
+    };
+
+    /** Returns a block of at least \a size chars, from the pool if a large
+        enough block is available.  \a capacity is set to the block's actual
+        size. */
+    boost::shared_array<char> AcquireMessageStorage(std::size_t size, std::size_t& capacity)
+    {
+        {
+            MessageStoragePool& pool = StoragePool();
+            boost::mutex::scoped_lock lock(pool.mutex);
+            // use the smallest pooled block that is large enough
+            std::vector<std::pair<char*, std::size_t> >::iterator best = pool.blocks.end();
+            for (std::vector<std::pair<char*, std::size_t> >::iterator it = pool.blocks.begin(); it != pool.blocks.end(); ++it)
+                if (size <= it->second && (best == pool.blocks.end() || it->second < best->second))
+                    best = it;
+            if (best != pool.blocks.end()) {
+                std::pair<char*, std::size_t> block = *best;
+                pool.blocks.erase(best);
+                capacity = block.second;
+                return boost::shared_array<char>(block.first, ReturnToStoragePool(capacity));
+            }
+        }
+        capacity = std::max(size, MIN_MESSAGE_STORAGE_SIZE);
+        return boost::shared_array<char>(new char[capacity], ReturnToStoragePool(capacity));
+    }
+
     const std::string MESSAGE_SCOPE_PREFIX = "Message::";
     const std::string DUMMY_EMPTY_MESSAGE = "Lathanda";
     const std::string ACKNOWLEDGEMENT = "ACK";
@@ -66,6 +141,7 @@ namespace GG {
     GG_ENUM_MAP_INSERT(Message::TURN_UPDATE)
     GG_ENUM_MAP_INSERT(Message::TURN_PARTIAL_UPDATE)
     GG_ENUM_MAP_INSERT(Message::TURN_ORDERS)
+    GG_ENUM_MAP_INSERT(Message::TURN_PARTIAL_ORDERS)
     GG_ENUM_MAP_INSERT(Message::TURN_PROGRESS)
     GG_ENUM_MAP_INSERT(Message::PLAYER_STATUS)
     GG_ENUM_MAP_INSERT(Message::CLIENT_SAVE_DATA)
@@ -151,6 +227,86 @@ std::ostream& operator<<(std::ostream& os, const Message& msg)
     return os;
 }
 
+////////////////////////////////////////////////
+// MessageStreamBuf
+////////////////////////////////////////////////
+MessageStreamBuf::MessageStreamBuf() :
+    m_storage(),
+    m_capacity(0)
+{}
+
+std::size_t MessageStreamBuf::Size() const
+{ return pptr() - pbase(); }
+
+boost::shared_array<char> MessageStreamBuf::Release(std::size_t& size)
+{
+    size = Size();
+    boost::shared_array<char> retval;
+    retval.swap(m_storage);
+    m_capacity = 0;
+    setp(0, 0);
+    return retval;
+}
+
+MessageStreamBuf::int_type MessageStreamBuf::overflow(int_type c)
+{
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+    Grow(Size() + 1);
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    return c;
+}
+
+std::streamsize MessageStreamBuf::xsputn(const char* s, std::streamsize n)
+{
+    if (n <= 0)
+        return 0;
+    if (epptr() - pptr() < n)
+        Grow(Size() + n);
+    std::memcpy(pptr(), s, n);
+    pbump(static_cast<int>(n));
+    return n;
+}
+
+void MessageStreamBuf::Grow(std::size_t min_capacity)
+{
+    std::size_t size = Size();
+    std::size_t new_capacity = 0;
+    boost::shared_array<char> new_storage = AcquireMessageStorage(std::max(min_capacity, 2 * m_capacity), new_capacity);
+    if (size)
+        std::memcpy(new_storage.get(), m_storage.get(), size);
+    m_storage.swap(new_storage);
+    m_capacity = new_capacity;
+    setp(m_storage.get(), m_storage.get() + m_capacity);
+    pbump(static_cast<int>(size));
+}
+
+////////////////////////////////////////////////
+// MessageOStream
+////////////////////////////////////////////////
+MessageOStream::MessageOStream() :
+    std::ostream(0)
+{ rdbuf(&m_buf); }
+
+MessageStreamBuf& MessageOStream::Buffer()
+{ return m_buf; }
+
+////////////////////////////////////////////////
+// MessageIStream
+////////////////////////////////////////////////
+MessageIStream::ViewStreamBuf::ViewStreamBuf(const char* data, std::size_t size)
+{
+    // the get area is never written to, so casting away const is safe
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+}
+
+MessageIStream::MessageIStream(const Message& message) :
+    std::istream(0),
+    m_buf(message.Data(), message.Size())
+{ rdbuf(&m_buf); }
+
 ////////////////////////////////////////////////
 // Message
 ////////////////////////////////////////////////
@@ -159,6 +315,7 @@ Message::Message() :
     m_sending_player(0),
     m_receiving_player(0),
     m_synchronous_response(false),
+    m_compressed(false),
     m_message_size(0),
     m_message_text()
 {}
@@ -172,10 +329,30 @@ Message::Message(MessageType type,
     m_sending_player(sending_player),
     m_receiving_player(receiving_player),
     m_synchronous_response(synchronous_response),
+    m_compressed(false),
     m_message_size(text.size()),
     m_message_text(new char[text.size()])
 { std::copy(text.begin(), text.end(), m_message_text.get()); }
 
+Message::Message(MessageType type,
+                 int sending_player,
+                 int receiving_player,
+                 MessageOStream& text,
+                 bool synchronous_response/* = false*/) :
+    m_type(type),
+    m_sending_player(sending_player),
+    m_receiving_player(receiving_player),
+    m_synchronous_response(synchronous_response),
+    m_compressed(false),
+    m_message_size(0),
+    m_message_text()
+{
+    text.flush();
+    std::size_t size = 0;
+    m_message_text = text.Buffer().Release(size);
+    m_message_size = size;
+}
+
 Message::MessageType Message::Type() const
 { return m_type; }
 
@@ -188,6 +365,9 @@ int Message::ReceivingPlayer() const
 bool Message::SynchronousResponse() const
 { return m_synchronous_response; }
 
+bool Message::Compressed() const
+{ return m_compressed; }
+
 std::size_t Message::Size() const
 { return m_message_size; }
 
@@ -200,7 +380,8 @@ std::string Message::Text() const
 void Message::Resize(std::size_t size)
 {
     m_message_size = size;
-    m_message_text.reset(new char[m_message_size]);
+    std::size_t capacity = 0;
+    m_message_text = AcquireMessageStorage(m_message_size, capacity);
 }
 
 char* Message::Data()
@@ -212,6 +393,7 @@ void Message::Swap(Message& rhs)
     std::swap(m_sending_player, rhs.m_sending_player);
     std::swap(m_receiving_player, rhs.m_receiving_player);
     std::swap(m_synchronous_response, rhs.m_synchronous_response);
+    std::swap(m_compressed, rhs.m_compressed);
     std::swap(m_message_size, rhs.m_message_size);
     std::swap(m_message_text, rhs.m_message_text);
 }
@@ -238,6 +420,7 @@ void BufferToHeader(const int* header_buf, Message& message)
     message.m_receiving_player = header_buf[2];
     message.m_synchronous_response = header_buf[3];
     message.m_message_size = header_buf[4];
+    message.m_compressed = header_buf[5];
 }
 
 void HeaderToBuffer(const Message& message, int* header_buf)
@@ -247,6 +430,75 @@ void HeaderToBuffer(const Message& message, int* header_buf)
     header_buf[2] = message.ReceivingPlayer();
     header_buf[3] = message.SynchronousResponse();
     header_buf[4] = message.Size();
+    header_buf[5] = message.Compressed();
+}
+
+bool CompressMessage(Message& message, std::size_t min_size/* = MESSAGE_COMPRESSION_THRESHOLD*/)
+{
+    if (message.m_compressed || message.Size() < min_size)
+        return false;
+
+    // compressed text is the uncompressed size followed by the zlib stream
+    uLong source_size = message.Size();
+    uLongf compressed_size = compressBound(source_size);
+    std::size_t capacity = 0;
+    boost::shared_array<char> compressed_text = AcquireMessageStorage(sizeof(int) + compressed_size, capacity);
+    int uncompressed_size = message.m_message_size;
+    std::memcpy(compressed_text.get(), &uncompressed_size, sizeof(int));
+
+    int result = compress2(reinterpret_cast<Bytef*>(compressed_text.get() + sizeof(int)), &compressed_size,
+                           reinterpret_cast<const Bytef*>(message.Data()), source_size, Z_BEST_SPEED);
+    if (result != Z_OK) {
+        Logger().errorStream() << "CompressMessage failed to compress " << MessageTypeStr(message.Type())
+                               << " message; zlib error " << result;
+        return false;
+    }
+    if (sizeof(int) + compressed_size >= source_size)
+        return false;   // incompressible; send as-is
+
+    message.m_message_text = compressed_text;
+    message.m_message_size = sizeof(int) + compressed_size;
+    message.m_compressed = true;
+    return true;
+}
+
+bool DecompressMessage(Message& message)
+{
+    if (!message.m_compressed)
+        return true;
+
+    int uncompressed_size = -1;
+    if (sizeof(int) <= message.Size())
+        std::memcpy(&uncompressed_size, message.Data(), sizeof(int));
+    if (uncompressed_size < 0 || MAX_MESSAGE_SIZE < static_cast<std::size_t>(uncompressed_size)) {
+        Logger().errorStream() << "DecompressMessage got " << MessageTypeStr(message.Type())
+                               << " message with invalid compressed text header";
+        return false;
+    }
+
+    std::size_t capacity = 0;
+    boost::shared_array<char> text;
+    try {
+        text = AcquireMessageStorage(uncompressed_size, capacity);
+    } catch (const std::bad_alloc&) {
+        Logger().errorStream() << "DecompressMessage couldn't allocate " << uncompressed_size << " bytes for "
+                               << MessageTypeStr(message.Type()) << " message";
+        return false;
+    }
+    uLongf dest_size = uncompressed_size;
+    int result = uncompress(reinterpret_cast<Bytef*>(text.get()), &dest_size,
+                            reinterpret_cast<const Bytef*>(message.Data() + sizeof(int)),
+                            message.Size() - sizeof(int));
+    if (result != Z_OK || dest_size != static_cast<uLongf>(uncompressed_size)) {
+        Logger().errorStream() << "DecompressMessage failed to decompress " << MessageTypeStr(message.Type())
+                               << " message; zlib error " << result;
+        return false;
+    }
+
+    message.m_message_text = text;
+    message.m_message_size = uncompressed_size;
+    message.m_compressed = false;
+    return true;
 }
 
 ////////////////////////////////////////////////
@@ -254,34 +506,34 @@ void HeaderToBuffer(const Message& message, int* header_buf)
 ////////////////////////////////////////////////
 Message ErrorMessage(const std::string& problem, bool fatal/* = true*/)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(problem)
            << BOOST_SERIALIZATION_NVP(fatal);
     }
-    return Message(Message::ERROR, Networking::INVALID_PLAYER_ID, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::ERROR, Networking::INVALID_PLAYER_ID, Networking::INVALID_PLAYER_ID, os);
 }
 
 Message ErrorMessage(int player_id, const std::string& problem, bool fatal/* = true*/)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(problem)
            << BOOST_SERIALIZATION_NVP(fatal);
     }
-    return Message(Message::ERROR, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::ERROR, Networking::INVALID_PLAYER_ID, player_id, os);
 }
 
 Message HostSPGameMessage(const SinglePlayerSetupData& setup_data)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(setup_data);
     }
-    return Message(Message::HOST_SP_GAME, Networking::INVALID_PLAYER_ID, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::HOST_SP_GAME, Networking::INVALID_PLAYER_ID, Networking::INVALID_PLAYER_ID, os);
 }
 
 Message HostMPGameMessage(const std::string& host_player_name)
@@ -289,15 +541,17 @@ Message HostMPGameMessage(const std::string& host_player_name)
     return Message(Message::HOST_MP_GAME, Networking::INVALID_PLAYER_ID, Networking::INVALID_PLAYER_ID, host_player_name);
 }
 
-Message JoinGameMessage(const std::string& player_name, Networking::ClientType client_type)
+Message JoinGameMessage(const std::string& player_name, Networking::ClientType client_type,
+                        bool accepts_compressed_messages/* = false*/)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(player_name)
-           << BOOST_SERIALIZATION_NVP(client_type);
+           << BOOST_SERIALIZATION_NVP(client_type)
+           << BOOST_SERIALIZATION_NVP(accepts_compressed_messages);
     }
-    return Message(Message::JOIN_GAME, Networking::INVALID_PLAYER_ID, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::JOIN_GAME, Networking::INVALID_PLAYER_ID, Networking::INVALID_PLAYER_ID, os);
 }
 
 Message HostIDMessage(int host_player_id)
@@ -311,13 +565,13 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
                          const Universe& universe, const SpeciesManager& species,
                          const std::map<int, PlayerInfo>& players)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(single_player_game)
            << BOOST_SERIALIZATION_NVP(empire_id)
            << BOOST_SERIALIZATION_NVP(current_turn);
-        Universe::s_encoding_empire = empire_id;
+        Universe::SetEncodingEmpire(empire_id);
         oa << BOOST_SERIALIZATION_NVP(empires)
            << BOOST_SERIALIZATION_NVP(species);
         Serialize(oa, universe);
@@ -325,7 +579,7 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
         oa << BOOST_SERIALIZATION_NVP(players)
            << BOOST_SERIALIZATION_NVP(loaded_game_data);
     }
-    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, os);
 }
 
 Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
@@ -334,13 +588,13 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
                          const std::map<int, PlayerInfo>& players,
                          const OrderSet& orders, const SaveGameUIData* ui_data)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(single_player_game)
            << BOOST_SERIALIZATION_NVP(empire_id)
            << BOOST_SERIALIZATION_NVP(current_turn);
-        Universe::s_encoding_empire = empire_id;
+        Universe::SetEncodingEmpire(empire_id);
         oa << BOOST_SERIALIZATION_NVP(empires)
            << BOOST_SERIALIZATION_NVP(species);
         Serialize(oa, universe);
@@ -355,7 +609,7 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
         bool save_state_string_available = false;
         oa << BOOST_SERIALIZATION_NVP(save_state_string_available);
     }
-    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, os);
 }
 
 Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
@@ -364,13 +618,13 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
                          const std::map<int, PlayerInfo>& players,
                          const OrderSet& orders, const std::string* save_state_string)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(single_player_game)
            << BOOST_SERIALIZATION_NVP(empire_id)
            << BOOST_SERIALIZATION_NVP(current_turn);
-        Universe::s_encoding_empire = empire_id;
+        Universe::SetEncodingEmpire(empire_id);
         oa << BOOST_SERIALIZATION_NVP(empires)
            << BOOST_SERIALIZATION_NVP(species);
         Serialize(oa, universe);
@@ -385,7 +639,7 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
         if (save_state_string_available)
             oa << boost::serialization::make_nvp("save_state_string", *save_state_string);
     }
-    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, os);
 }
 
 Message HostSPAckMessage(int player_id)
@@ -405,66 +659,82 @@ Message JoinAckMessage(int player_id)
 
 Message TurnOrdersMessage(int sender, const OrderSet& orders)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         Serialize(oa, orders);
     }
-    return Message(Message::TURN_ORDERS, sender, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::TURN_ORDERS, sender, Networking::INVALID_PLAYER_ID, os);
+}
+
+Message TurnPartialOrdersMessage(int sender, const OrderSet& orders, bool turn_complete)
+{
+    MessageOStream os;
+    {
+        FREEORION_OARCHIVE_TYPE oa(os);
+        OrderSet issued_orders = orders.Subset(orders.IssuedOrderIDs());
+        const std::set<int>& rescinded_order_ids = orders.RescindedOrderIDs();
+        int num_orders = orders.size();
+        Serialize(oa, issued_orders);
+        oa << BOOST_SERIALIZATION_NVP(rescinded_order_ids)
+           << BOOST_SERIALIZATION_NVP(turn_complete)
+           << BOOST_SERIALIZATION_NVP(num_orders);
+    }
+    return Message(Message::TURN_PARTIAL_ORDERS, sender, Networking::INVALID_PLAYER_ID, os);
 }
 
 Message TurnProgressMessage(Message::TurnProgressPhase phase_id, int player_id)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(phase_id);
     }
-    return Message(Message::TURN_PROGRESS, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::TURN_PROGRESS, Networking::INVALID_PLAYER_ID, player_id, os);
 }
 
 Message PlayerStatusMessage(int player_id, int about_player_id, Message::PlayerStatus player_status)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(about_player_id)
            << BOOST_SERIALIZATION_NVP(player_status);
     }
-    return Message(Message::PLAYER_STATUS, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::PLAYER_STATUS, Networking::INVALID_PLAYER_ID, player_id, os);
 }
 
 Message TurnUpdateMessage(int player_id, int empire_id, int current_turn,
                           const EmpireManager& empires, const Universe& universe,
                           const SpeciesManager& species, const std::map<int, PlayerInfo>& players)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
-        Universe::s_encoding_empire = empire_id;
+        Universe::SetEncodingEmpire(empire_id);
         oa << BOOST_SERIALIZATION_NVP(current_turn)
            << BOOST_SERIALIZATION_NVP(empires)
            << BOOST_SERIALIZATION_NVP(species);
         Serialize(oa, universe);
         oa << BOOST_SERIALIZATION_NVP(players);
     }
-    return Message(Message::TURN_UPDATE, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::TURN_UPDATE, Networking::INVALID_PLAYER_ID, player_id, os);
 }
 
 Message TurnPartialUpdateMessage(int player_id, int empire_id, const Universe& universe)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
-        Universe::s_encoding_empire = empire_id;
+        Universe::SetEncodingEmpire(empire_id);
         Serialize(oa, universe);
     }
-    return Message(Message::TURN_PARTIAL_UPDATE, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::TURN_PARTIAL_UPDATE, Networking::INVALID_PLAYER_ID, player_id, os);
 }
 
 Message ClientSaveDataMessage(int sender, const OrderSet& orders, const SaveGameUIData& ui_data)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         Serialize(oa, orders);
@@ -474,12 +744,12 @@ Message ClientSaveDataMessage(int sender, const OrderSet& orders, const SaveGame
            << BOOST_SERIALIZATION_NVP(ui_data)
            << BOOST_SERIALIZATION_NVP(save_state_string_available);
     }
-    return Message(Message::CLIENT_SAVE_DATA, sender, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::CLIENT_SAVE_DATA, sender, Networking::INVALID_PLAYER_ID, os);
 }
 
 Message ClientSaveDataMessage(int sender, const OrderSet& orders, const std::string& save_state_string)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         Serialize(oa, orders);
@@ -489,12 +759,12 @@ Message ClientSaveDataMessage(int sender, const OrderSet& orders, const std::str
            << BOOST_SERIALIZATION_NVP(save_state_string_available)
            << BOOST_SERIALIZATION_NVP(save_state_string);
     }
-    return Message(Message::CLIENT_SAVE_DATA, sender, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::CLIENT_SAVE_DATA, sender, Networking::INVALID_PLAYER_ID, os);
 }
 
 Message ClientSaveDataMessage(int sender, const OrderSet& orders)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         Serialize(oa, orders);
@@ -503,7 +773,7 @@ Message ClientSaveDataMessage(int sender, const OrderSet& orders)
         oa << BOOST_SERIALIZATION_NVP(ui_data_available)
            << BOOST_SERIALIZATION_NVP(save_state_string_available);
     }
-    return Message(Message::CLIENT_SAVE_DATA, sender, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::CLIENT_SAVE_DATA, sender, Networking::INVALID_PLAYER_ID, os);
 }
 
 Message RequestNewObjectIDMessage(int sender)
@@ -551,37 +821,37 @@ Message SingleRecipientChatMessage(int sender, int receiver, const std::string&
 Message VictoryDefeatMessage(int receiver, Message::VictoryOrDefeat victory_or_defeat,
                              const std::string& reason_string, int empire_id)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(victory_or_defeat)
            << BOOST_SERIALIZATION_NVP(reason_string)
            << BOOST_SERIALIZATION_NVP(empire_id);
     }
-    return Message(Message::VICTORY_DEFEAT, Networking::INVALID_PLAYER_ID, receiver, os.str());
+    return Message(Message::VICTORY_DEFEAT, Networking::INVALID_PLAYER_ID, receiver, os);
 }
 
 Message PlayerEliminatedMessage(int receiver, int empire_id, const std::string& empire_name)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(empire_id)
            << BOOST_SERIALIZATION_NVP(empire_name);
     }
-    return Message(Message::PLAYER_ELIMINATED, Networking::INVALID_PLAYER_ID, receiver, os.str());
+    return Message(Message::PLAYER_ELIMINATED, Networking::INVALID_PLAYER_ID, receiver, os);
 }
 
 Message EndGameMessage(int receiver, Message::EndGameReason reason,
                        const std::string& reason_player_name/* = ""*/)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(reason)
            << BOOST_SERIALIZATION_NVP(reason_player_name);
     }
-    return Message(Message::END_GAME, Networking::INVALID_PLAYER_ID, receiver, os.str());
+    return Message(Message::END_GAME, Networking::INVALID_PLAYER_ID, receiver, os);
 }
 
 ////////////////////////////////////////////////
@@ -589,22 +859,22 @@ Message EndGameMessage(int receiver, Message::EndGameReason reason,
 ////////////////////////////////////////////////
 Message LobbyUpdateMessage(int sender, const MultiplayerLobbyData& lobby_data)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(lobby_data);
     }
-    return Message(Message::LOBBY_UPDATE, sender, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::LOBBY_UPDATE, sender, Networking::INVALID_PLAYER_ID, os);
 }
 
 Message ServerLobbyUpdateMessage(int receiver, const MultiplayerLobbyData& lobby_data)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(lobby_data);
     }
-    return Message(Message::LOBBY_UPDATE, Networking::INVALID_PLAYER_ID, receiver, os.str());
+    return Message(Message::LOBBY_UPDATE, Networking::INVALID_PLAYER_ID, receiver, os);
 }
 
 Message LobbyChatMessage(int sender, int receiver, const std::string& data)
@@ -627,26 +897,26 @@ Message ServerCombatStartMessage(int receiver, int empire_id,
                                  const std::vector<CombatSetupGroup>& setup_groups,
                                  const ShipDesignMap& foreign_designs)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
-        Universe::s_encoding_empire = empire_id;
+        Universe::SetEncodingEmpire(empire_id);
         oa << BOOST_SERIALIZATION_NVP(combat_data)
            << BOOST_SERIALIZATION_NVP(setup_groups)
            << BOOST_SERIALIZATION_NVP(foreign_designs);
     }
-    return Message(Message::COMBAT_START, Networking::INVALID_PLAYER_ID, receiver, os.str());
+    return Message(Message::COMBAT_START, Networking::INVALID_PLAYER_ID, receiver, os);
 }
 
 Message ServerCombatUpdateMessage(int receiver, int empire_id, const CombatData& combat_data)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
-        Universe::s_encoding_empire = empire_id;
+        Universe::SetEncodingEmpire(empire_id);
         oa << BOOST_SERIALIZATION_NVP(combat_data);
     }
-    return Message(Message::COMBAT_TURN_UPDATE, Networking::INVALID_PLAYER_ID, receiver, os.str());
+    return Message(Message::COMBAT_TURN_UPDATE, Networking::INVALID_PLAYER_ID, receiver, os);
 }
 
 Message ServerCombatEndMessage(int receiver)
@@ -654,12 +924,12 @@ Message ServerCombatEndMessage(int receiver)
 
 Message CombatTurnOrdersMessage(int sender, const CombatOrderSet& combat_orders)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         FREEORION_OARCHIVE_TYPE oa(os);
         oa << BOOST_SERIALIZATION_NVP(combat_orders);
     }
-    return Message(Message::COMBAT_TURN_ORDERS, sender, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::COMBAT_TURN_ORDERS, sender, Networking::INVALID_PLAYER_ID, os);
 }
 
 ////////////////////////////////////////////////
@@ -668,7 +938,7 @@ Message CombatTurnOrdersMessage(int sender, const CombatOrderSet& combat_orders)
 void ExtractMessageData(const Message& msg, std::string& problem, bool& fatal)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         ia >> BOOST_SERIALIZATION_NVP(problem)
            >> BOOST_SERIALIZATION_NVP(fatal);
@@ -684,7 +954,7 @@ void ExtractMessageData(const Message& msg, std::string& problem, bool& fatal)
 void ExtractMessageData(const Message& msg, MultiplayerLobbyData& lobby_data)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         ia >> BOOST_SERIALIZATION_NVP(lobby_data);
     } catch (const std::exception& err) {
@@ -704,12 +974,12 @@ void ExtractMessageData(const Message& msg, bool& single_player_game, int& empir
                         std::string& save_state_string)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         ia >> BOOST_SERIALIZATION_NVP(single_player_game)
            >> BOOST_SERIALIZATION_NVP(empire_id)
            >> BOOST_SERIALIZATION_NVP(current_turn);
-        Universe::s_encoding_empire = empire_id;
+        Universe::SetEncodingEmpire(empire_id);
 
         boost::timer deserialize_timer;
         ia >> BOOST_SERIALIZATION_NVP(empires);
@@ -749,16 +1019,18 @@ void ExtractMessageData(const Message& msg, bool& single_player_game, int& empir
     }
 }
 
-void ExtractMessageData(const Message& msg, std::string& player_name, Networking::ClientType& client_type)
+void ExtractMessageData(const Message& msg, std::string& player_name, Networking::ClientType& client_type,
+                        bool& accepts_compressed_messages)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         ia >> BOOST_SERIALIZATION_NVP(player_name)
-           >> BOOST_SERIALIZATION_NVP(client_type);
+           >> BOOST_SERIALIZATION_NVP(client_type)
+           >> BOOST_SERIALIZATION_NVP(accepts_compressed_messages);
     } catch (const std::exception& err) {
         Logger().errorStream() << "ExtractMessageData(const Message& msg, std::string& player_name, "
-                               << "Networking::ClientType client_type) failed!  Message:\n"
+                               << "Networking::ClientType client_type, bool& accepts_compressed_messages) failed!  Message:\n"
                                << msg.Text() << "\n"
                                << "Error: " << err.what();
         throw err;
@@ -768,7 +1040,7 @@ void ExtractMessageData(const Message& msg, std::string& player_name, Networking
 void ExtractMessageData(const Message& msg, OrderSet& orders)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         Deserialize(ia, orders);
     } catch (const std::exception& err) {
@@ -780,14 +1052,34 @@ void ExtractMessageData(const Message& msg, OrderSet& orders)
     }
 }
 
+void ExtractMessageData(const Message& msg, OrderSet& issued_orders, std::set<int>& rescinded_order_ids,
+                        bool& turn_complete, int& num_orders)
+{
+    try {
+        MessageIStream is(msg);
+        FREEORION_IARCHIVE_TYPE ia(is);
+        Deserialize(ia, issued_orders);
+        ia >> BOOST_SERIALIZATION_NVP(rescinded_order_ids)
+           >> BOOST_SERIALIZATION_NVP(turn_complete)
+           >> BOOST_SERIALIZATION_NVP(num_orders);
+    } catch (const std::exception& err) {
+        Logger().errorStream() << "ExtractMessageData(const Message& msg, OrderSet& issued_orders, "
+                               << "std::set<int>& rescinded_order_ids, bool& turn_complete, int& num_orders) failed!  "
+                               << "Message:\n"
+                               << msg.Text() << "\n"
+                               << "Error: " << err.what();
+        throw err;
+    }
+}
+
 void ExtractMessageData(const Message& msg, int empire_id, int& current_turn,
                         EmpireManager& empires, Universe& universe,
                         SpeciesManager& species, std::map<int, PlayerInfo>& players)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
-        Universe::s_encoding_empire = empire_id;
+        Universe::SetEncodingEmpire(empire_id);
         ia >> BOOST_SERIALIZATION_NVP(current_turn)
            >> BOOST_SERIALIZATION_NVP(empires)
            >> BOOST_SERIALIZATION_NVP(species);
@@ -806,9 +1098,9 @@ void ExtractMessageData(const Message& msg, int empire_id, int& current_turn,
 void ExtractMessageData(const Message& msg, int empire_id, Universe& universe)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
-        Universe::s_encoding_empire = empire_id;
+        Universe::SetEncodingEmpire(empire_id);
         Deserialize(ia, universe);
     } catch (const std::exception& err) {
         Logger().errorStream() << "ExtractMessageData(const Message& msg, int empire_id, "
@@ -824,7 +1116,7 @@ void ExtractMessageData(const Message& msg, OrderSet& orders, bool& ui_data_avai
                         std::string& save_state_string)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         Deserialize(ia, orders);
         ia >> BOOST_SERIALIZATION_NVP(ui_data_available);
@@ -847,7 +1139,7 @@ void ExtractMessageData(const Message& msg, OrderSet& orders, bool& ui_data_avai
 void ExtractMessageData(const Message& msg, Message::TurnProgressPhase& phase_id)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         ia >> BOOST_SERIALIZATION_NVP(phase_id);
     } catch (const std::exception& err) {
@@ -862,7 +1154,7 @@ void ExtractMessageData(const Message& msg, Message::TurnProgressPhase& phase_id
 void ExtractMessageData(const Message& msg, int& about_player_id, Message::PlayerStatus& status)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         ia >> BOOST_SERIALIZATION_NVP(about_player_id)
            >> BOOST_SERIALIZATION_NVP(status);
@@ -878,7 +1170,7 @@ void ExtractMessageData(const Message& msg, int& about_player_id, Message::Playe
 void ExtractMessageData(const Message& msg, SinglePlayerSetupData& setup_data)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         ia >> BOOST_SERIALIZATION_NVP(setup_data);
     } catch (const std::exception& err) {
@@ -894,7 +1186,7 @@ void ExtractMessageData(const Message& msg, Message::EndGameReason& reason,
                         std::string& reason_player_name)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         ia >> BOOST_SERIALIZATION_NVP(reason)
            >> BOOST_SERIALIZATION_NVP(reason_player_name);
@@ -910,7 +1202,7 @@ void ExtractMessageData(const Message& msg, Message::EndGameReason& reason,
 void ExtractMessageData(const Message& msg, int& empire_id, std::string& empire_name)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         ia >> BOOST_SERIALIZATION_NVP(empire_id)
            >> BOOST_SERIALIZATION_NVP(empire_name);
@@ -927,7 +1219,7 @@ void ExtractMessageData(const Message& msg, Message::VictoryOrDefeat& victory_or
                         std::string& reason_string, int& empire_id)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         ia >> BOOST_SERIALIZATION_NVP(victory_or_defeat)
            >> BOOST_SERIALIZATION_NVP(reason_string)
@@ -947,7 +1239,7 @@ void ExtractMessageData(const Message& msg, CombatData& combat_data,
                         ShipDesignMap& foreign_designs)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         ia >> BOOST_SERIALIZATION_NVP(combat_data)
            >> BOOST_SERIALIZATION_NVP(setup_groups)
@@ -965,7 +1257,7 @@ void ExtractMessageData(const Message& msg, CombatData& combat_data,
 void ExtractMessageData(const Message& msg, CombatOrderSet& order_set)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         ia >> BOOST_SERIALIZATION_NVP(order_set);
     } catch (const std::exception& err) {
@@ -980,7 +1272,7 @@ void ExtractMessageData(const Message& msg, CombatOrderSet& order_set)
 void ExtractMessageData(const Message& msg, CombatData& combat_data)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         ia >> BOOST_SERIALIZATION_NVP(combat_data);
     } catch (const std::exception& err) {
@@ -996,7 +1288,7 @@ void ExtractMessageData(const Message& msg, System*& system,
                         std::map<int, UniverseObject*>& combat_universe)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         FREEORION_IARCHIVE_TYPE ia(is);
         ia >> BOOST_SERIALIZATION_NVP(system);
         Deserialize(ia, combat_universe);
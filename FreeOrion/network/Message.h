@@ -16,8 +16,11 @@
 #undef int64_t
 #endif
 
+#include <istream>
+#include <ostream>
 #include <string>
 #include <map>
+#include <set>
 #include <vector>
 
 struct CombatData;
@@ -45,6 +48,86 @@ void BufferToHeader(const int* header_buf, Message& message);
 /** Fills \a header_buf from the relevant portions of \a message. */
 void HeaderToBuffer(const Message& message, int* header_buf);
 
+/** Messages whose text is at least this many bytes are compressed before
+    being sent to connections that accept compressed messages. */
+const std::size_t MESSAGE_COMPRESSION_THRESHOLD = 16 * 1024;
+
+/** The largest message text, compressed or not, that will be accepted from
+    a connection.  Larger sizes in message headers are taken as corruption,
+    rather than being allocated. */
+const std::size_t MAX_MESSAGE_SIZE = 256 * 1024 * 1024;
+
+/** Compresses the text of \a message in place and marks it as compressed, if
+    it is not already compressed, is at least \a min_size bytes long, and
+    compression actually makes it smaller.  Returns true iff \a message was
+    compressed. */
+bool CompressMessage(Message& message, std::size_t min_size = MESSAGE_COMPRESSION_THRESHOLD);
+
+/** Restores the original text of \a message if it was compressed by
+    CompressMessage().  Returns false and leaves \a message unchanged if its
+    compressed text is corrupt, would decompress to more than
+    MAX_MESSAGE_SIZE bytes, or can't be allocated; returns true otherwise. */
+bool DecompressMessage(Message& message);
+
+/** A growable char buffer that serialization archives can write into
+    directly, and whose contents a Message can adopt without copying.  Storage
+    is drawn from, and returned to, a small pool of blocks shared by all
+    messages, so that repeatedly building large messages doesn't repeatedly
+    allocate and fault in fresh memory. */
+class MessageStreamBuf : public std::streambuf
+{
+public:
+    /** \name Structors */ //@{
+    MessageStreamBuf(); ///< Default ctor.
+    //@}
+
+    /** \name Accessors */ //@{
+    std::size_t Size() const;       ///< Returns the number of chars written so far.
+    //@}
+
+    /** \name Mutators */ //@{
+    /** Hands off the written chars, setting \a size to their number, and
+        leaves this buffer empty. */
+    boost::shared_array<char> Release(std::size_t& size);
+    //@}
+
+protected:
+    virtual int_type        overflow(int_type c);
+    virtual std::streamsize xsputn(const char* s, std::streamsize n);
+
+private:
+    void Grow(std::size_t min_capacity);
+
+    boost::shared_array<char>   m_storage;
+    std::size_t                 m_capacity;
+};
+
+/** An output stream that writes into a MessageStreamBuf.  Used in place of
+    std::ostringstream when serializing the contents of a Message. */
+class MessageOStream : public std::ostream
+{
+public:
+    MessageOStream();
+    MessageStreamBuf& Buffer();
+private:
+    MessageStreamBuf m_buf;
+};
+
+/** An input stream that reads directly from the text of a Message, without
+    copying it.  The Message must outlive the stream. */
+class MessageIStream : public std::istream
+{
+public:
+    explicit MessageIStream(const Message& message);
+private:
+    class ViewStreamBuf : public std::streambuf
+    {
+    public:
+        ViewStreamBuf(const char* data, std::size_t size);
+    };
+    ViewStreamBuf m_buf;
+};
+
 /** Encapsulates a variable-length char buffer containing a message to be passed among the server and one or more
     clients.  Note that std::string is often thread unsafe on many platforms, so a dynamically allocated char array is
     used instead.  (It was feared that using another STL container of char might misbehave as well.) */
@@ -70,6 +153,7 @@ public:
         TURN_UPDATE,            ///< sent to a client when the server updates the client Universes and Empires, and sends the SitReps each turn; indicates to the receiver that a new turn has begun
         TURN_PARTIAL_UPDATE,    ///< sent to a client when the server updates part of the client gamestate after partially processing a turn, such as after fleet movement but before the rest of the turn is processed.  Does NOT indicate a new turn has begun.
         TURN_ORDERS,            ///< sent to the server by a client that has orders to be processed at the end of a turn
+        TURN_PARTIAL_ORDERS,    ///< sent to the server by a client during a turn with the orders issued and rescinded since the last such message, so the server can validate them before the turn ends; the last one of a turn takes the place of TURN_ORDERS
         TURN_PROGRESS,          ///< sent to clients to display a turn progress message
         PLAYER_STATUS,          ///< sent to clients to inform them that a player has some status, such as having finished playing a turn and submitted orders, or is resolving combat, or is playing a turn normally
         CLIENT_SAVE_DATA,       ///< sent to the server in response to a server request for the data needed to create a save file
@@ -126,6 +210,14 @@ public:
             int receiving_player,
             const std::string& text,
             bool synchronous_response = false);
+
+    /** Ctor that takes over the contents of \a text without copying them,
+        leaving \a text empty. */
+    Message(MessageType message_type,
+            int sending_player,
+            int receiving_player,
+            MessageOStream& text,
+            bool synchronous_response = false);
     //@}
 
     /** \name Accessors */ //@{
@@ -133,6 +225,7 @@ public:
     int         SendingPlayer() const;      ///< Returns the ID of the sending player.
     int         ReceivingPlayer() const;    ///< Returns the ID of the receiving player.
     bool        SynchronousResponse() const;///< Returns true if this message is in reponse to a synchronous message
+    bool        Compressed() const;         ///< Returns true if the underlying buffer holds compressed text; see DecompressMessage()
     std::size_t Size() const;               ///< Returns the size of the underlying buffer.
     const char* Data() const;               ///< Returns the underlying buffer.
     std::string Text() const;               ///< Returns the underlying buffer as a std::string.
@@ -149,11 +242,14 @@ private:
     int           m_sending_player;
     int           m_receiving_player;
     bool          m_synchronous_response;
+    bool          m_compressed;
     int           m_message_size;
 
     boost::shared_array<char> m_message_text;
 
     friend void BufferToHeader(const int* header_buf, Message& message);
+    friend bool CompressMessage(Message& message, std::size_t min_size);
+    friend bool DecompressMessage(Message& message);
 };
 
 bool operator==(const Message& lhs, const Message& rhs);
@@ -193,8 +289,10 @@ Message HostSPGameMessage(const SinglePlayerSetupData& setup_data);
 /** creates a minimal HOST_MP_GAME message used to initiate multiplayer "lobby" setup*/
 Message HostMPGameMessage(const std::string& host_player_name);
 
-/** creates a JOIN_GAME message.  The sender's player name and client type are sent in the message.*/
-Message JoinGameMessage(const std::string& player_name, Networking::ClientType client_type);
+/** creates a JOIN_GAME message.  The sender's player name and client type are sent in the message, as well as
+    whether the sender can decompress large messages sent to it; see CompressMessage().*/
+Message JoinGameMessage(const std::string& player_name, Networking::ClientType client_type,
+                        bool accepts_compressed_messages = false);
 
 /** creates a HOST_ID message.  The player ID of the host is sent in the message. */
 Message HostIDMessage(int host_player_id);
@@ -231,6 +329,13 @@ Message JoinAckMessage(int player_id);
 /** creates a TURN_ORDERS message. */
 Message TurnOrdersMessage(int sender, const OrderSet& orders);
 
+/** creates a TURN_PARTIAL_ORDERS message, containing the orders in \a orders
+    issued and rescinded since its last ClearChanges().  If \a turn_complete
+    is true, the sender has finished its turn, and the server should process
+    the orders it has received so far, of which there should be as many as
+    there are in \a orders. */
+Message TurnPartialOrdersMessage(int sender, const OrderSet& orders, bool turn_complete);
+
 /** creates a TURN_PROGRESS message. */
 Message TurnProgressMessage(Message::TurnProgressPhase phase_id, int player_id = Networking::INVALID_PLAYER_ID);
 
@@ -354,10 +459,14 @@ void ExtractMessageData(const Message& msg, bool& single_player_game, int& empir
                         SaveGameUIData& ui_data, bool& save_state_string_available,
                         std::string& save_state_string);
 
-void ExtractMessageData(const Message& msg, std::string& player_name, Networking::ClientType& client_type);
+void ExtractMessageData(const Message& msg, std::string& player_name, Networking::ClientType& client_type,
+                        bool& accepts_compressed_messages);
 
 void ExtractMessageData(const Message& msg, OrderSet& orders);
 
+void ExtractMessageData(const Message& msg, OrderSet& issued_orders, std::set<int>& rescinded_order_ids,
+                        bool& turn_complete, int& num_orders);
+
 void ExtractMessageData(const Message& msg, int empire_id, int& current_turn, EmpireManager& empires,
                         Universe& universe, SpeciesManager& species, std::map<int, PlayerInfo>& players);
 
@@ -3,16 +3,15 @@
 #include "Message.h"
 
 
-namespace {
-    struct SynchronousResponseMessage
-    {
-        bool operator()(const Message& message) const
-            { return message.SynchronousResponse(); }
-    };
-}
+const std::size_t MessageQueue::DEFAULT_MAX_SIZE;
 
-MessageQueue::MessageQueue(boost::mutex& monitor) :
-    m_monitor(monitor)
+MessageQueue::MessageQueue(boost::mutex& monitor, const ResumeReadingFn& resume_reading,
+                           std::size_t max_size/* = DEFAULT_MAX_SIZE*/) :
+    m_max_size(max_size),
+    m_synchronous_response_waiters(0),
+    m_reading_stopped(false),
+    m_monitor(monitor),
+    m_resume_reading(resume_reading)
 {}
 
 bool MessageQueue::Empty() const
@@ -31,32 +30,78 @@ void MessageQueue::Clear()
 {
     boost::mutex::scoped_lock lock(m_monitor);
     m_queue.clear();
+    m_synchronous_responses.clear();
+    m_reading_stopped = false;
 }
 
-void MessageQueue::PushBack(Message& message)
+bool MessageQueue::PushBack(Message& message)
 {
     boost::mutex::scoped_lock lock(m_monitor);
+    if (message.SynchronousResponse()) {
+        m_synchronous_responses.push_back(Message());
+        swap(m_synchronous_responses.back(), message);
+        m_have_synchronous_response.notify_one();
+        return true;
+    }
     m_queue.push_back(Message());
     swap(m_queue.back(), message);
-    if (m_queue.back().SynchronousResponse())
-        m_have_synchronous_response.notify_one();
+    m_have_message.notify_all();
+    if (m_queue.size() < m_max_size || m_synchronous_response_waiters)
+        return true;
+    m_reading_stopped = true;
+    return false;
 }
 
 void MessageQueue::PopFront(Message& message)
+{
+    bool resume = false;
+    {
+        boost::mutex::scoped_lock lock(m_monitor);
+        swap(message, m_queue.front());
+        m_queue.pop_front();
+        resume = m_reading_stopped;
+        m_reading_stopped = false;
+    }
+    if (resume)
+        m_resume_reading();
+}
+
+void MessageQueue::PopAll(std::list<Message>& messages)
+{
+    bool resume = false;
+    {
+        boost::mutex::scoped_lock lock(m_monitor);
+        if (m_queue.empty())
+            return;
+        messages.splice(messages.end(), m_queue);
+        resume = m_reading_stopped;
+        m_reading_stopped = false;
+    }
+    if (resume)
+        m_resume_reading();
+}
+
+bool MessageQueue::WaitForMessage(const boost::posix_time::time_duration& timeout) const
 {
     boost::mutex::scoped_lock lock(m_monitor);
-    swap(message, m_queue.front());
-    m_queue.pop_front();
+    if (m_queue.empty())
+        m_have_message.timed_wait(lock, timeout);
+    return !m_queue.empty();
 }
 
 void MessageQueue::EraseFirstSynchronousResponse(Message& message)
 {
     boost::mutex::scoped_lock lock(m_monitor);
-    std::list<Message>::iterator it = std::find_if(m_queue.begin(), m_queue.end(), SynchronousResponseMessage());
-    while (it == m_queue.end()) {
-        m_have_synchronous_response.wait(lock);
-        it = std::find_if(m_queue.begin(), m_queue.end(), SynchronousResponseMessage());
+    ++m_synchronous_response_waiters;
+    if (m_reading_stopped) {
+        m_reading_stopped = false;
+        lock.unlock();
+        m_resume_reading();
+        lock.lock();
     }
-    swap(message, *it);
-    m_queue.erase(it);
+    while (m_synchronous_responses.empty())
+        m_have_synchronous_response.wait(lock);
+    --m_synchronous_response_waiters;
+    swap(message, m_synchronous_responses.front());
+    m_synchronous_responses.pop_front();
 }
@@ -2,6 +2,8 @@
 #ifndef _MessageQueue_h_
 #define _MessageQueue_h_
 
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/function.hpp>
 #include <boost/thread/condition.hpp>
 #include <boost/thread/mutex.hpp>
 
@@ -10,35 +12,71 @@
 
 class Message;
 
-/** A thread-safe message queue.  The entire public interface is guarded with mutex locks. */
+/** A thread-safe, bounded message queue.  The entire public interface is
+    guarded with mutex locks.  Synchronous response messages are kept apart
+    from regular messages, so that they can be retrieved without searching
+    the regular messages, and do not count against the size limit.
+
+    PushBack() never blocks, so it is safe to call from the thread that
+    reads from the network.  Instead, it returns false once the queue is
+    full, and the caller should stop reading more messages.  When the queue
+    has space again, the resume-reading function passed to the constructor
+    is called from the thread that made the space, and the caller may read
+    again.  While another thread is waiting in EraseFirstSynchronousResponse(),
+    the queue never asks for reading to stop, since the response may arrive
+    only after other messages. */
 class MessageQueue
 {
 public:
-    MessageQueue(boost::mutex& monitor);
+    typedef boost::function<void ()> ResumeReadingFn;
+
+    MessageQueue(boost::mutex& monitor, const ResumeReadingFn& resume_reading,
+                 std::size_t max_size = DEFAULT_MAX_SIZE);
 
-    /** Returns true iff the queue is empty. */
+    /** Returns true iff the queue contains no regular messages. */
     bool Empty() const;
 
-    /** Returns the number of messages in the queue. */
+    /** Returns the number of regular messages in the queue. */
     std::size_t Size() const;
 
-    /** Empties the queue. */
+    /** Empties the queue, including any synchronous responses.  Reading is
+        assumed to be restarted by the caller, so the resume-reading function
+        is not called. */
     void Clear();
 
-    /** Adds \a message to the end of the queue. */
-    void PushBack(Message& message);
+    /** Adds \a message to the end of the queue, and returns false if the
+        caller should stop reading messages until told to resume; see
+        above. */
+    bool PushBack(Message& message);
 
     /** Returns the front message in the queue. */
     void PopFront(Message& message);
 
+    /** Moves all regular messages in the queue, in order, to the end of \a
+        messages. */
+    void PopAll(std::list<Message>& messages);
+
+    /** Blocks the calling thread until there is at least one regular message
+        in the queue or \a timeout has elapsed.  Returns true iff the queue is
+        not empty. */
+    bool WaitForMessage(const boost::posix_time::time_duration& timeout) const;
+
     /** Returns the first synchronous repsonse message in the queue.  If no such message is found, this function blocks
         the calling thread until a synchronous response element is added. */
     void EraseFirstSynchronousResponse(Message& message);
 
+    static const std::size_t DEFAULT_MAX_SIZE = 1024;
+
 private:
-    std::list<Message> m_queue;
-    boost::condition   m_have_synchronous_response;
-    boost::mutex&      m_monitor;
+    std::list<Message>          m_queue;
+    std::list<Message>          m_synchronous_responses;
+    std::size_t                 m_max_size;
+    int                         m_synchronous_response_waiters;
+    bool                        m_reading_stopped;
+    mutable boost::condition    m_have_message;
+    boost::condition            m_have_synchronous_response;
+    boost::mutex&               m_monitor;
+    ResumeReadingFn             m_resume_reading;
 };
 
 
@@ -35,7 +35,7 @@ private:
 namespace {
     void WriteMessage(boost::asio::ip::tcp::socket& socket, const Message& message)
     {
-        int header_buf[5];
+        int header_buf[6];
         HeaderToBuffer(message, header_buf);
         std::vector<boost::asio::const_buffer> buffers;
         buffers.push_back(boost::asio::buffer(header_buf));
@@ -64,6 +64,7 @@ PlayerConnection::PlayerConnection(boost::asio::io_service& io_service,
     m_ID(INVALID_PLAYER_ID),
     m_new_connection(true),
     m_client_type(Networking::INVALID_CLIENT_TYPE),
+    m_accepts_compressed_messages(false),
     m_nonplayer_message_callback(nonplayer_message_callback),
     m_player_message_callback(player_message_callback),
     m_disconnected_callback(disconnected_callback)
@@ -84,11 +85,25 @@ const std::string& PlayerConnection::PlayerName() const
 Networking::ClientType PlayerConnection::GetClientType() const
 { return m_client_type; }
 
+bool PlayerConnection::AcceptsCompressedMessages() const
+{ return m_accepts_compressed_messages; }
+
+std::size_t PlayerConnection::IncomingMessageBufferSize() const
+{ return HEADER_SIZE + m_incoming_message.Size(); }
+
 void PlayerConnection::Start()
 { AsyncReadMessage(); }
 
 void PlayerConnection::SendMessage(const Message& message)
-{ WriteMessage(m_socket, message); }
+{
+    if (m_accepts_compressed_messages && MESSAGE_COMPRESSION_THRESHOLD <= message.Size()) {
+        Message compressed_message(message);
+        CompressMessage(compressed_message);
+        WriteMessage(m_socket, compressed_message);
+    } else {
+        WriteMessage(m_socket, message);
+    }
+}
 
 void PlayerConnection::EstablishPlayer(int id, const std::string& player_name, Networking::ClientType client_type)
 {
@@ -120,6 +135,9 @@ void PlayerConnection::EstablishPlayer(int id, const std::string& player_name, N
     m_client_type = client_type;
 }
 
+void PlayerConnection::SetAcceptsCompressedMessages(bool accepts_compressed_messages)
+{ m_accepts_compressed_messages = accepts_compressed_messages; }
+
 void PlayerConnection::SetClientType(Networking::ClientType client_type)
 {
     m_client_type = client_type;
@@ -153,6 +171,25 @@ void PlayerConnection::HandleMessageBodyRead(boost::system::error_code error,
     } else {
         assert(static_cast<int>(bytes_transferred) <= m_incoming_header_buffer[4]);
         if (static_cast<int>(bytes_transferred) == m_incoming_header_buffer[4]) {
+            // clients only send compressed messages if they have said they
+            // handle compression, so anything else is corrupt; the
+            // connection is dropped rather than trying to resynchronize
+            if (m_incoming_message.Compressed() && !m_accepts_compressed_messages) {
+                Logger().errorStream() << "PlayerConnection::HandleMessageBodyRead(): disconnecting after "
+                                       << MessageTypeStr(m_incoming_message.Type())
+                                       << " message compressed without negotiating compression";
+                m_incoming_message = Message();
+                EventSignal(boost::bind(m_disconnected_callback, shared_from_this()));
+                return;
+            }
+            if (!DecompressMessage(m_incoming_message)) {
+                Logger().errorStream() << "PlayerConnection::HandleMessageBodyRead(): disconnecting after "
+                                       << MessageTypeStr(m_incoming_message.Type())
+                                       << " message with corrupt compressed text";
+                m_incoming_message = Message();
+                EventSignal(boost::bind(m_disconnected_callback, shared_from_this()));
+                return;
+            }
             //if (TRACE_EXECUTION)
                 //Logger().debugStream() << "PlayerConnection::HandleMessageBodyRead(): "
                 //                       << "received message " << m_incoming_message;
@@ -199,6 +236,15 @@ void PlayerConnection::HandleMessageHeaderRead(boost::system::error_code error,
         assert(static_cast<int>(bytes_transferred) <= HEADER_SIZE);
         if (static_cast<int>(bytes_transferred) == HEADER_SIZE) {
             BufferToHeader(m_incoming_header_buffer.c_array(), m_incoming_message);
+            if (m_incoming_header_buffer[4] < 0 ||
+                MAX_MESSAGE_SIZE < static_cast<std::size_t>(m_incoming_header_buffer[4]))
+            {
+                Logger().errorStream() << "PlayerConnection::HandleMessageHeaderRead(): disconnecting after "
+                                       << "message header with invalid size " << m_incoming_header_buffer[4];
+                m_incoming_message = Message();
+                EventSignal(boost::bind(m_disconnected_callback, shared_from_this()));
+                return;
+            }
             m_incoming_message.Resize(m_incoming_header_buffer[4]);
             boost::asio::async_read(
                 m_socket,
@@ -181,13 +181,22 @@ public:
     /** Returns the type of client associated with this connection (AI client,
       * human client, ...) */
     Networking::ClientType GetClientType() const;
+
+    /** Returns true iff the client on this connection has indicated that it
+      * can decompress large messages; see CompressMessage(). */
+    bool AcceptsCompressedMessages() const;
+
+    /** Returns the number of bytes held by this connection's buffers for the
+      * message it is currently receiving. */
+    std::size_t IncomingMessageBufferSize() const;
     //@}
 
     /** \name Mutators */ //@{
     /** Starts the connection reading incoming messages on its socket. */
     void Start();
 
-    /** Sends \a message to out on the connection. */
+    /** Sends \a message to out on the connection.  Large messages are
+      * compressed if AcceptsCompressedMessages() is true. */
     void SendMessage(const Message& message);
 
     /** Establishes a connection as a player with a specific name and id.
@@ -196,6 +205,9 @@ public:
 
     /** Sets this connection's client type. */
     void SetClientType(Networking::ClientType client_type);
+
+    /** Sets whether large messages sent on this connection are compressed. */
+    void SetAcceptsCompressedMessages(bool accepts_compressed_messages);
     //@}
 
     mutable boost::signal<void (const NullaryFn&)> EventSignal;
@@ -208,7 +220,7 @@ public:
                   ConnectionFn disconnected_callback);
 
 private:
-    typedef boost::array<int, 5> MessageHeaderBuffer;
+    typedef boost::array<int, 6> MessageHeaderBuffer;
 
     PlayerConnection(boost::asio::io_service& io_service,
                      MessageAndConnectionFn nonplayer_message_callback,
@@ -227,6 +239,7 @@ private:
     std::string                     m_player_name;
     bool                            m_new_connection;
     Networking::ClientType          m_client_type;
+    bool                            m_accepts_compressed_messages;
 
     MessageAndConnectionFn m_nonplayer_message_callback;
     MessageAndConnectionFn m_player_message_callback;
@@ -0,0 +1,838 @@
+#include "../Message.h"
+
+#include "../../Empire/Empire.h"
+#include "../../Empire/EmpireManager.h"
+#include "../../parse/Parse.h"
+#include "../../server/SaveLoad.h"
+#include "../../server/ServerApp.h"
+#include "../../universe/Building.h"
+#include "../../universe/Fleet.h"
+#include "../../universe/MemoryReport.h"
+#include "../../universe/Planet.h"
+#include "../../universe/Ship.h"
+#include "../../universe/ShipDesign.h"
+#include "../../universe/Special.h"
+#include "../../universe/Species.h"
+#include "../../universe/System.h"
+#include "../../universe/Universe.h"
+#include "../../util/AppInterface.h"
+#include "../../util/Directories.h"
+#include "../../util/MultiplayerCommon.h"
+#include "../../util/OptionsDB.h"
+#include "../../util/Order.h"
+#include "../../util/OrderSet.h"
+#include "../../util/Random.h"
+#include "../../util/Serialize.h"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/timer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+
+namespace {
+    void print_help()
+    {
+        std::cout << "Usage: network_test compression_round_trip|join_game_round_trip|memory_estimate|special_index|diplomacy|movement_threads|turn_update_benchmark <save file>\n"
+                  << "       network_test serialization_round_trip [systems planets_per_system fleets_per_empire "
+                  << "ships_per_fleet buildings_per_planet empires]" << std::endl;
+    }
+
+    /** Returns true iff \a message survives compression and decompression
+      * unchanged, and is only marked compressed when that is worthwhile. */
+    bool CheckCompressionRoundTrip(const Message& message, bool expect_compressed)
+    {
+        Message compressed(message);
+        bool was_compressed = CompressMessage(compressed);
+        if (was_compressed != expect_compressed || compressed.Compressed() != expect_compressed) {
+            std::cerr << "message of size " << message.Size() << " compressed: " << was_compressed
+                      << " expected: " << expect_compressed << std::endl;
+            return false;
+        }
+        if (was_compressed && message.Size() <= compressed.Size()) {
+            std::cerr << "compressed message not smaller than original" << std::endl;
+            return false;
+        }
+
+        // send header and text through a buffer, as the networking code does
+        int header_buf[6];
+        HeaderToBuffer(compressed, header_buf);
+        Message received;
+        BufferToHeader(header_buf, received);
+        received.Resize(received.Size());
+        std::copy(compressed.Data(), compressed.Data() + compressed.Size(), received.Data());
+
+        if (!DecompressMessage(received)) {
+            std::cerr << "failed to decompress message of size " << message.Size() << std::endl;
+            return false;
+        }
+        if (received.Compressed() || received != message) {
+            std::cerr << "decompressed message differs from original of size " << message.Size() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    int CompressionRoundTrip()
+    {
+        bool success = true;
+
+        // small messages are never compressed
+        success &= CheckCompressionRoundTrip(Message(Message::TURN_UPDATE, 1, 2, "short text"), false);
+        success &= CheckCompressionRoundTrip(Message(Message::TURN_UPDATE, 1, 2, ""), false);
+
+        // large repetitive messages are
+        std::string repetitive;
+        while (repetitive.size() < 4 * MESSAGE_COMPRESSION_THRESHOLD)
+            repetitive += "<m_meters><item><first>2</first><second><m_current_value>1.5</m_current_value></second></item>";
+        success &= CheckCompressionRoundTrip(Message(Message::TURN_UPDATE, 1, 2, repetitive), true);
+        success &= CheckCompressionRoundTrip(Message(Message::GAME_START, 1, 2, repetitive, true), true);
+
+        // large incompressible messages are sent as-is
+        std::string random_text(4 * MESSAGE_COMPRESSION_THRESHOLD, '\0');
+        for (std::string::iterator it = random_text.begin(); it != random_text.end(); ++it)
+            *it = static_cast<char>(RandSmallInt(0, 255));
+        success &= CheckCompressionRoundTrip(Message(Message::TURN_UPDATE, 1, 2, random_text), false);
+
+        // corrupt compressed text is rejected without modifying the message
+        Message corrupt(Message::TURN_UPDATE, 1, 2, repetitive);
+        CompressMessage(corrupt);
+        std::fill(corrupt.Data() + sizeof(int), corrupt.Data() + corrupt.Size(), 'x');
+        if (DecompressMessage(corrupt) || !corrupt.Compressed()) {
+            std::cerr << "corrupt compressed message was not rejected" << std::endl;
+            success = false;
+        }
+
+        // as is a claimed uncompressed size too large to be allocated
+        Message oversized(Message::TURN_UPDATE, 1, 2, repetitive);
+        CompressMessage(oversized);
+        int oversized_size = static_cast<int>(MAX_MESSAGE_SIZE + 1);
+        std::memcpy(oversized.Data(), &oversized_size, sizeof(int));
+        if (DecompressMessage(oversized) || !oversized.Compressed()) {
+            std::cerr << "compressed message with oversized header was not rejected" << std::endl;
+            success = false;
+        }
+
+        return success ? 0 : 1;
+    }
+
+    int JoinGameRoundTrip()
+    {
+        bool success = true;
+        for (int accepts = 0; accepts < 2; ++accepts) {
+            Message message = JoinGameMessage("player", Networking::CLIENT_TYPE_HUMAN_PLAYER, accepts);
+            std::string player_name;
+            Networking::ClientType client_type = Networking::INVALID_CLIENT_TYPE;
+            bool accepts_compressed_messages = !accepts;
+            ExtractMessageData(message, player_name, client_type, accepts_compressed_messages);
+            if (player_name != "player" || client_type != Networking::CLIENT_TYPE_HUMAN_PLAYER ||
+                accepts_compressed_messages != static_cast<bool>(accepts))
+            {
+                std::cerr << "JOIN_GAME message round trip failed" << std::endl;
+                success = false;
+            }
+        }
+        return success ? 0 : 1;
+    }
+
+    /** Loads the game saved in \a filename and reports the size of, and time
+      * spent compressing and decompressing, each empire's TURN_UPDATE. */
+    int TurnUpdateBenchmark(const std::string& filename)
+    {
+        parse::init();
+        ServerApp server;
+
+        ServerSaveGameData server_save_game_data;
+        std::vector<PlayerSaveGameData> player_save_game_data;
+        LoadGame(filename, server_save_game_data, player_save_game_data,
+                 GetUniverse(), Empires(), GetSpeciesManager());
+
+        const std::map<int, PlayerInfo> players;
+        std::size_t total_size = 0;
+        std::size_t total_compressed_size = 0;
+        double total_compress_time = 0.0;
+        double total_decompress_time = 0.0;
+        bool success = true;
+
+        for (EmpireManager::const_iterator it = Empires().begin(); it != Empires().end(); ++it) {
+            int empire_id = it->first;
+            Message message = TurnUpdateMessage(empire_id, empire_id, server_save_game_data.m_current_turn,
+                                                Empires(), GetUniverse(), GetSpeciesManager(), players);
+            Message compressed(message);
+
+            boost::timer timer;
+            CompressMessage(compressed);
+            double compress_time = timer.elapsed();
+            timer.restart();
+            Message decompressed(compressed);
+            success &= DecompressMessage(decompressed) && decompressed == message;
+            double decompress_time = timer.elapsed();
+
+            std::cout << "empire " << empire_id << ": " << message.Size() << " -> " << compressed.Size()
+                      << " bytes; compress " << compress_time << " s, decompress " << decompress_time << " s"
+                      << std::endl;
+
+            total_size += message.Size();
+            total_compressed_size += compressed.Size();
+            total_compress_time += compress_time;
+            total_decompress_time += decompress_time;
+        }
+
+        std::cout << "total: " << total_size << " -> " << total_compressed_size
+                  << " bytes; compress " << total_compress_time << " s, decompress "
+                  << total_decompress_time << " s" << std::endl;
+
+        return success ? 0 : 1;
+    }
+
+    /** Sizes of the synthetic universe built by BuildSyntheticGame(). */
+    struct SyntheticGameSize {
+        SyntheticGameSize() :
+            systems(100),
+            planets_per_system(3),
+            fleets_per_empire(20),
+            ships_per_fleet(5),
+            buildings_per_planet(1),
+            empires(4)
+        {}
+        int systems;
+        int planets_per_system;
+        int fleets_per_empire;
+        int ships_per_fleet;
+        int buildings_per_planet;
+        int empires;
+    };
+
+    /** Fills the server's universe and empires with a game of the given
+      * \a size, issuing one order per fleet into \a orders, and returns
+      * information about a player for each empire. */
+    std::map<int, PlayerInfo> BuildSyntheticGame(const SyntheticGameSize& size, OrderSet& orders)
+    {
+        Universe& universe = GetUniverse();
+        std::map<int, PlayerInfo> players;
+
+        for (int empire_id = 0; empire_id < size.empires; ++empire_id) {
+            std::string name = "Empire " + boost::lexical_cast<std::string>(empire_id);
+            std::string player_name = "Player " + boost::lexical_cast<std::string>(empire_id);
+            Empires().CreateEmpire(empire_id, name, player_name, GG::Clr(255, 255, 255, 255));
+            players[empire_id] = PlayerInfo(player_name, empire_id, Networking::CLIENT_TYPE_AI_PLAYER, empire_id == 0);
+        }
+        // make some of the empires neighbours at war, and others allies
+        for (int empire_id = 1; empire_id < size.empires; ++empire_id)
+            Empires().SetDiplomaticStatus(empire_id - 1, empire_id, empire_id % 2 ? DIPLO_WAR : DIPLO_ALLIED);
+
+        const std::map<std::string, int>& generic_design_ids = GetPredefinedShipDesignManager().AddShipDesignsToUniverse();
+        int design_id = generic_design_ids.empty() ? ShipDesign::INVALID_DESIGN_ID : generic_design_ids.begin()->second;
+        std::string building_type_name = GetBuildingTypeManager().begin() == GetBuildingTypeManager().end() ?
+            "" : GetBuildingTypeManager().begin()->first;
+
+        // systems on a grid, with starlanes to their neighbours
+        std::vector<System*> systems;
+        int grid_width = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(size.systems))));
+        for (int i = 0; i < size.systems; ++i) {
+            double x = Universe::UniverseWidth() * (0.5 + i % grid_width) / (grid_width + 1);
+            double y = Universe::UniverseWidth() * (0.5 + i / grid_width) / (size.systems / grid_width + 2);
+            System* system = new System(STAR_YELLOW, std::max(1, size.planets_per_system),
+                                        "System " + boost::lexical_cast<std::string>(i), x, y);
+            universe.Insert(system);
+            if (i % grid_width && !systems.empty()) {
+                system->AddStarlane(systems.back()->ID());
+                systems.back()->AddStarlane(system->ID());
+            }
+            if (grid_width <= i) {
+                system->AddStarlane(systems[i - grid_width]->ID());
+                systems[i - grid_width]->AddStarlane(system->ID());
+            }
+            systems.push_back(system);
+        }
+
+        // planets, some owned by each empire and some unowned, with buildings on the owned ones
+        int planet_count = 0;
+        for (std::vector<System*>::iterator it = systems.begin(); it != systems.end(); ++it) {
+            for (int orbit = 0; orbit < size.planets_per_system; ++orbit, ++planet_count) {
+                Planet* planet = new Planet(PT_TERRAN, SZ_MEDIUM);
+                int planet_id = universe.Insert(planet);
+                (*it)->Insert(planet, orbit);
+                int owner = planet_count % (size.empires + 1);
+                if (owner == size.empires)
+                    continue;
+                planet->SetOwner(owner);
+                for (int b = 0; b < size.buildings_per_planet; ++b) {
+                    Building* building = new Building(owner, building_type_name, owner);
+                    int building_id = universe.Insert(building);
+                    planet->AddBuilding(building_id);
+                }
+                planet->Rename("Planet " + boost::lexical_cast<std::string>(planet_id));
+            }
+        }
+
+        // fleets of ships, spread over the systems
+        if (design_id != ShipDesign::INVALID_DESIGN_ID && !systems.empty()) {
+            int fleet_count = 0;
+            for (int empire_id = 0; empire_id < size.empires; ++empire_id) {
+                for (int f = 0; f < size.fleets_per_empire; ++f, ++fleet_count) {
+                    System* system = systems[(fleet_count * 7) % systems.size()];
+                    Fleet* fleet = new Fleet("Fleet", system->X(), system->Y(), empire_id);
+                    int fleet_id = universe.Insert(fleet);
+                    system->Insert(fleet);
+                    for (int s = 0; s < size.ships_per_fleet; ++s) {
+                        Ship* ship = new Ship(empire_id, design_id, "", empire_id);
+                        int ship_id = universe.Insert(ship);
+                        fleet->AddShip(ship_id);
+                    }
+                    orders.IssueOrder(OrderPtr(new RenameOrder(empire_id, fleet_id,
+                                                               "Fleet " + boost::lexical_cast<std::string>(fleet_id))));
+                }
+            }
+        } else {
+            std::cerr << "no ship design available; synthetic universe has no fleets" << std::endl;
+        }
+
+        universe.UpdateEmpireObjectVisibilities();
+        universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+
+        return players;
+    }
+
+    void Save(FREEORION_OARCHIVE_TYPE& oa, const Universe& universe)
+    { Serialize(oa, universe); }
+
+    void Save(FREEORION_OARCHIVE_TYPE& oa, const EmpireManager& empires)
+    { oa << BOOST_SERIALIZATION_NVP(empires); }
+
+    void Save(FREEORION_OARCHIVE_TYPE& oa, const OrderSet& orders)
+    { Serialize(oa, orders); }
+
+    void Load(FREEORION_IARCHIVE_TYPE& ia, Universe& universe)
+    { Deserialize(ia, universe); }
+
+    void Load(FREEORION_IARCHIVE_TYPE& ia, EmpireManager& empires)
+    { ia >> BOOST_SERIALIZATION_NVP(empires); }
+
+    void Load(FREEORION_IARCHIVE_TYPE& ia, OrderSet& orders)
+    { Deserialize(ia, orders); }
+
+    template <class T>
+    std::string SaveToString(const T& t)
+    {
+        std::ostringstream os;
+        {
+            FREEORION_OARCHIVE_TYPE oa(os);
+            Save(oa, t);
+        }
+        return os.str();
+    }
+
+    template <class T>
+    void LoadFromString(const std::string& text, T& t)
+    {
+        std::istringstream is(text);
+        FREEORION_IARCHIVE_TYPE ia(is);
+        Load(ia, t);
+    }
+
+    void ReportRoundTrip(const std::string& name, std::size_t size, double save_time, double load_time)
+    {
+        std::cout << name << ": " << size << " bytes; save " << save_time
+                  << " s, load " << load_time << " s" << std::endl;
+    }
+
+    /** Saves \a original as encoded for \a encoding_empire, loads the result
+      * into a new T, and returns true iff saving that again gives the same
+      * bytes. */
+    template <class T>
+    bool CheckSerializationRoundTrip(const std::string& name, const T& original, int encoding_empire)
+    {
+        Universe::SetEncodingEmpire(encoding_empire);
+
+        boost::timer timer;
+        std::string text = SaveToString(original);
+        double save_time = timer.elapsed();
+
+        T loaded;
+        timer.restart();
+        try {
+            LoadFromString(text, loaded);
+        } catch (const std::exception& e) {
+            std::cerr << name << ": load failed: " << e.what() << std::endl;
+            return false;
+        }
+        double load_time = timer.elapsed();
+
+        ReportRoundTrip(name, text.size(), save_time, load_time);
+
+        Universe::SetEncodingEmpire(encoding_empire);
+        if (SaveToString(loaded) != text) {
+            std::cerr << name << ": saving the loaded copy gave different data" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /** Builds \a empire_id's TURN_UPDATE, extracts it as a client would, and
+      * returns true iff building the message again from the extracted data
+      * gives the same message. */
+    bool CheckTurnUpdateRoundTrip(int empire_id, const std::map<int, PlayerInfo>& players)
+    {
+        const std::string name = "TURN_UPDATE for empire " + boost::lexical_cast<std::string>(empire_id);
+        int current_turn = CurrentTurn();
+
+        boost::timer timer;
+        Message message = TurnUpdateMessage(empire_id, empire_id, current_turn, Empires(), GetUniverse(),
+                                            GetSpeciesManager(), players);
+        double save_time = timer.elapsed();
+
+        int loaded_turn = INVALID_GAME_TURN;
+        EmpireManager loaded_empires;
+        Universe loaded_universe;
+        std::map<int, PlayerInfo> loaded_players;
+        timer.restart();
+        try {
+            ExtractMessageData(message, empire_id, loaded_turn, loaded_empires, loaded_universe,
+                               GetSpeciesManager(), loaded_players);
+        } catch (const std::exception& e) {
+            std::cerr << name << ": extraction failed: " << e.what() << std::endl;
+            return false;
+        }
+        double load_time = timer.elapsed();
+
+        ReportRoundTrip(name, message.Size(), save_time, load_time);
+
+        Message rebuilt = TurnUpdateMessage(empire_id, empire_id, loaded_turn, loaded_empires, loaded_universe,
+                                            GetSpeciesManager(), loaded_players);
+        if (rebuilt != message) {
+            std::cerr << name << ": rebuilding the extracted data gave a different message" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /** Builds a synthetic game of the given \a size, and reports the size of,
+      * and time spent saving and loading, the universe as encoded for all
+      * empires and for each empire, the empires, the orders and each empire's
+      * TURN_UPDATE, checking that each survives a round trip. */
+    int SerializationRoundTrip(const SyntheticGameSize& size)
+    {
+        parse::init();
+        ServerApp server;
+
+        OrderSet orders;
+        std::map<int, PlayerInfo> players = BuildSyntheticGame(size, orders);
+        std::cout << GetUniverse().Objects().NumObjects() << " objects, " << size.empires << " empires, "
+                  << std::distance(orders.begin(), orders.end()) << " orders" << std::endl;
+
+        bool success = true;
+        success &= CheckSerializationRoundTrip("universe for all empires", GetUniverse(), ALL_EMPIRES);
+        for (EmpireManager::const_iterator it = Empires().begin(); it != Empires().end(); ++it)
+            success &= CheckSerializationRoundTrip("universe for empire " + boost::lexical_cast<std::string>(it->first),
+                                                   GetUniverse(), it->first);
+        success &= CheckSerializationRoundTrip("empires", Empires(), ALL_EMPIRES);
+        success &= CheckSerializationRoundTrip("orders", orders, ALL_EMPIRES);
+        for (EmpireManager::const_iterator it = Empires().begin(); it != Empires().end(); ++it)
+            success &= CheckTurnUpdateRoundTrip(it->first, players);
+
+        return success ? 0 : 1;
+    }
+
+    /** Stores the memory estimated for the objects of the server's universe in
+      * \a objects_bytes, and returns true iff it covers at least the objects
+      * themselves and not much more, and the number of objects reported is
+      * correct. */
+    bool CheckObjectsMemoryEstimate(std::size_t& objects_bytes)
+    {
+        MemoryReport report;
+        GetUniverse().GetMemoryReport(report);
+        std::cout << report.Dump();
+
+        const MemoryReport::Entry* objects = report.Find("objects");
+        if (!objects) {
+            std::cerr << "memory report has no objects entry" << std::endl;
+            return false;
+        }
+        objects_bytes = objects->bytes;
+
+        const ObjectMap& object_map = GetUniverse().Objects();
+        if (objects->items != static_cast<std::size_t>(object_map.NumObjects())) {
+            std::cerr << "memory report counts " << objects->items << " objects, universe has "
+                      << object_map.NumObjects() << std::endl;
+            return false;
+        }
+
+        std::size_t num_objects = object_map.NumObjects();
+        std::size_t min_bytes =
+            object_map.FindObjects<System>().size() * sizeof(System) +
+            object_map.FindObjects<Planet>().size() * sizeof(Planet) +
+            object_map.FindObjects<Building>().size() * sizeof(Building) +
+            object_map.FindObjects<Fleet>().size() * sizeof(Fleet) +
+            object_map.FindObjects<Ship>().size() * sizeof(Ship);
+        // meters, specials, names, contents and index nodes of a synthetic
+        // object take well under this
+        const std::size_t MAX_EXTRA_BYTES_PER_OBJECT = 2048;
+        if (objects->bytes < min_bytes || min_bytes + num_objects * MAX_EXTRA_BYTES_PER_OBJECT < objects->bytes) {
+            std::cerr << "estimated " << objects->bytes << " bytes for " << num_objects
+                      << " objects, which take at least " << min_bytes << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /** Builds synthetic games of a given size and of twice that size, and
+      * checks that the memory estimates for their objects are plausible and
+      * grow in proportion to the number of objects. */
+    int ObjectMemoryEstimates()
+    {
+        parse::init();
+        ServerApp server;
+
+        bool success = true;
+
+        SyntheticGameSize size;
+        OrderSet orders;
+        BuildSyntheticGame(size, orders);
+        std::size_t num_objects = GetUniverse().Objects().NumObjects();
+        std::size_t bytes = 0;
+        success &= CheckObjectsMemoryEstimate(bytes);
+
+        GetUniverse().Clear();
+        Empires().Clear();
+
+        SyntheticGameSize double_size;
+        double_size.systems *= 2;
+        double_size.fleets_per_empire *= 2;
+        OrderSet double_orders;
+        BuildSyntheticGame(double_size, double_orders);
+        std::size_t double_num_objects = GetUniverse().Objects().NumObjects();
+        std::size_t double_bytes = 0;
+        success &= CheckObjectsMemoryEstimate(double_bytes);
+
+        double object_ratio = static_cast<double>(double_num_objects) / std::max<std::size_t>(1, num_objects);
+        double bytes_ratio = static_cast<double>(double_bytes) / std::max<std::size_t>(1, bytes);
+        std::cout << num_objects << " -> " << double_num_objects << " objects, "
+                  << bytes << " -> " << double_bytes << " bytes" << std::endl;
+        if (bytes_ratio < 0.9 * object_ratio || 1.1 * object_ratio < bytes_ratio) {
+            std::cerr << "doubling the universe multiplied the objects by " << object_ratio
+                      << " but their estimated memory by " << bytes_ratio << std::endl;
+            success = false;
+        }
+
+        return success ? 0 : 1;
+    }
+
+    /** Returns true iff the objects of \a objects that have the special named
+      * \a name are exactly those with ids in \a expected_ids, according to
+      * both the objects and the per-special index. */
+    bool CheckSpecialObjects(const ObjectMap& objects, const std::string& name, const std::set<int>& expected_ids)
+    {
+        bool success = true;
+        if (objects.SpecialObjectIDs(FindSpecialID(name)) != expected_ids) {
+            std::cerr << "index of objects with special " << name << " is wrong" << std::endl;
+            success = false;
+        }
+        for (ObjectMap::const_iterator it = objects.const_begin(); it != objects.const_end(); ++it) {
+            bool expected = expected_ids.find(it->first) != expected_ids.end();
+            if (it->second->HasSpecial(name) != expected ||
+                (it->second->SpecialAddedOnTurn(name) != INVALID_GAME_TURN) != expected)
+            {
+                std::cerr << "object " << it->first << " special " << name << " expected: " << expected << std::endl;
+                success = false;
+            }
+        }
+        return success;
+    }
+
+    /** Adds and removes specials on objects of a synthetic game, and checks
+      * that the objects and the per-special index agree, and that specials
+      * survive serialization by name. */
+    int SpecialIndex()
+    {
+        parse::init();
+        ServerApp server;
+
+        OrderSet orders;
+        BuildSyntheticGame(SyntheticGameSize(), orders);
+        ObjectMap& objects = GetUniverse().Objects();
+
+        const std::string FIRST_SPECIAL = "TEST_SPECIAL_A";
+        const std::string SECOND_SPECIAL = "TEST_SPECIAL_B";
+        std::set<int> first_ids, second_ids;
+        int count = 0;
+        for (ObjectMap::iterator it = objects.begin(); it != objects.end(); ++it, ++count) {
+            // add in reverse name order, to check objects keep specials sorted
+            if (count % 3 == 0) {
+                it->second->AddSpecial(SECOND_SPECIAL);
+                second_ids.insert(it->first);
+            }
+            if (count % 2 == 0) {
+                it->second->AddSpecial(FIRST_SPECIAL);
+                first_ids.insert(it->first);
+            }
+        }
+
+        bool success = true;
+        success &= CheckSpecialObjects(objects, FIRST_SPECIAL, first_ids);
+        success &= CheckSpecialObjects(objects, SECOND_SPECIAL, second_ids);
+
+        // removing a special, and adding one already present, update only
+        // the affected objects
+        int removed_id = *second_ids.begin();
+        objects.Object(removed_id)->RemoveSpecial(SECOND_SPECIAL);
+        objects.Object(removed_id)->RemoveSpecial(SECOND_SPECIAL);
+        objects.Object(removed_id)->AddSpecial(FIRST_SPECIAL);
+        second_ids.erase(removed_id);
+        first_ids.insert(removed_id);
+        success &= CheckSpecialObjects(objects, FIRST_SPECIAL, first_ids);
+        success &= CheckSpecialObjects(objects, SECOND_SPECIAL, second_ids);
+
+        // deleted objects leave the index
+        int deleted_id = *first_ids.rbegin();
+        GetUniverse().Delete(deleted_id);
+        first_ids.erase(deleted_id);
+        second_ids.erase(deleted_id);
+        success &= CheckSpecialObjects(objects, FIRST_SPECIAL, first_ids);
+
+        // specials are saved by name, and loaded objects are indexed
+        Universe::SetEncodingEmpire(ALL_EMPIRES);
+        Universe loaded;
+        LoadFromString(SaveToString(GetUniverse()), loaded);
+        success &= CheckSpecialObjects(loaded.Objects(), FIRST_SPECIAL, first_ids);
+        success &= CheckSpecialObjects(loaded.Objects(), SECOND_SPECIAL, second_ids);
+        for (ObjectMap::const_iterator it = objects.const_begin(); it != objects.const_end(); ++it) {
+            const UniverseObject* loaded_obj = loaded.Objects().Object(it->first);
+            if (!loaded_obj || loaded_obj->Specials() != it->second->Specials()) {
+                std::cerr << "object " << it->first << " specials differ after loading" << std::endl;
+                success = false;
+            }
+        }
+        loaded.Clear();
+
+        std::cout << first_ids.size() << " objects with " << FIRST_SPECIAL << ", " << second_ids.size()
+                  << " with " << SECOND_SPECIAL << std::endl;
+        return success ? 0 : 1;
+    }
+
+    /** Checks that diplomatic statuses survive the diplomacy matrices
+      * growing, and that diplomatic status orders declare war unilaterally
+      * but only make peace once both empires have proposed it. */
+    int Diplomacy()
+    {
+        ServerApp server;
+        EmpireManager& empires = Empires();
+        const int NUM_EMPIRES = 20;
+
+        bool success = true;
+        for (int empire_id = 0; empire_id < NUM_EMPIRES; ++empire_id) {
+            empires.CreateEmpire(empire_id, "Empire", "Player", GG::Clr(255, 255, 255, 255));
+            if (empire_id)
+                empires.SetDiplomaticStatus(empire_id - 1, empire_id, DIPLO_PEACE);
+            for (int other_id = 1; other_id <= empire_id; ++other_id) {
+                if (empires.GetDiplomaticStatus(other_id, other_id - 1) != DIPLO_PEACE ||
+                    (other_id > 1 && empires.GetDiplomaticStatus(other_id, other_id - 2) != DIPLO_WAR))
+                {
+                    std::cerr << "status of empire " << other_id << " wrong after adding empire " << empire_id << std::endl;
+                    success = false;
+                }
+            }
+        }
+
+        DiplomaticStatusOrder(0, 1, DIPLO_WAR).Execute();
+        if (!empires.AtWar(0, 1) || !empires.AtWar(1, 0)) {
+            std::cerr << "declaring war didn't take effect" << std::endl;
+            success = false;
+        }
+        DiplomaticStatusOrder(0, 1, DIPLO_PEACE).Execute();
+        if (!empires.AtWar(0, 1) || empires.ProposedDiplomaticStatus(0, 1) != DIPLO_PEACE) {
+            std::cerr << "proposing peace didn't wait for the other empire" << std::endl;
+            success = false;
+        }
+        DiplomaticStatusOrder(1, 0, DIPLO_PEACE).Execute();
+        if (empires.GetDiplomaticStatus(0, 1) != DIPLO_PEACE || empires.ProposedDiplomaticStatus(0, 1) != INVALID_DIPLOMATIC_STATUS) {
+            std::cerr << "accepting peace didn't take effect" << std::endl;
+            success = false;
+        }
+
+        ShareVisibilityOrder(0, 1, true).Execute();
+        if (!empires.SharesVisibility(0, 1) || empires.SharesVisibility(1, 0)) {
+            std::cerr << "visibility sharing order didn't take effect" << std::endl;
+            success = false;
+        }
+
+        return success ? 0 : 1;
+    }
+
+    /** Where a fleet is and how much fuel it has after moving. */
+    struct FleetMovementResult {
+        FleetMovementResult() :
+            x(0.0), y(0.0), system_id(UniverseObject::INVALID_OBJECT_ID),
+            prev_system(UniverseObject::INVALID_OBJECT_ID), next_system(UniverseObject::INVALID_OBJECT_ID), fuel(0.0)
+        {}
+        explicit FleetMovementResult(const Fleet& fleet) :
+            x(fleet.X()), y(fleet.Y()), system_id(fleet.SystemID()),
+            prev_system(fleet.PreviousSystemID()), next_system(fleet.NextSystemID()), fuel(fleet.Fuel())
+        {}
+        bool operator==(const FleetMovementResult& rhs) const
+        {
+            return x == rhs.x && y == rhs.y && system_id == rhs.system_id && prev_system == rhs.prev_system &&
+                   next_system == rhs.next_system && fuel == rhs.fuel;
+        }
+        double  x, y;
+        int     system_id;
+        int     prev_system;
+        int     next_system;
+        double  fuel;
+    };
+
+    /** Loads the game saved in \a universe_text and \a empires_text into the
+      * server, sends every fleet towards another system, processes the turn
+      * up to combat with fleet movement planned on \a movement_threads threads
+      * and returns where the fleets ended up. */
+    std::map<int, FleetMovementResult> MoveFleets(const std::string& universe_text, const std::string& empires_text,
+                                                  int movement_threads, ServerApp& server)
+    {
+        GetOptionsDB().Set<int>("movement-threads", movement_threads);
+        Universe::SetEncodingEmpire(ALL_EMPIRES);
+        LoadFromString(empires_text, Empires());
+        LoadFromString(universe_text, GetUniverse());
+
+        for (EmpireManager::iterator it = Empires().begin(); it != Empires().end(); ++it) {
+            it->second->UpdateSupplyUnobstructedSystems();
+            it->second->UpdateSystemSupplyRanges();
+            it->second->UpdateFleetSupply();
+        }
+
+        std::vector<int> system_ids = GetUniverse().Objects().FindObjectIDs<System>();
+        std::vector<Fleet*> fleets = GetUniverse().Objects().FindObjects<Fleet>();
+        for (std::vector<Fleet*>::iterator it = fleets.begin(); it != fleets.end() && !system_ids.empty(); ++it) {
+            Fleet* fleet = *it;
+            int destination_id = system_ids[(fleet->ID() * 13) % system_ids.size()];
+            try {
+                std::list<int> route = GetUniverse().ShortestPath(fleet->SystemID(), destination_id, fleet->Owner()).first;
+                if (route.size() > 1)
+                    fleet->SetRoute(route);
+            } catch (const std::exception&) {
+                // no known route; the fleet stays where it is
+            }
+        }
+
+        server.PreCombatProcessTurns();
+
+        std::map<int, FleetMovementResult> retval;
+        fleets = GetUniverse().Objects().FindObjects<Fleet>();
+        for (std::vector<Fleet*>::iterator it = fleets.begin(); it != fleets.end(); ++it)
+            retval[(*it)->ID()] = FleetMovementResult(**it);
+        return retval;
+    }
+
+    /** Checks that planning fleet movement on several threads moves fleets
+      * exactly as planning it on one thread does. */
+    int MovementThreads()
+    {
+        parse::init();
+        ServerApp server;
+
+        SyntheticGameSize size;
+        size.fleets_per_empire = 100;   // enough fleets to plan on several threads
+        OrderSet orders;
+        BuildSyntheticGame(size, orders);
+
+        // every empire knows every system and starlane, and every ship can
+        // make a few jumps outside supply, so that fleets have somewhere to go
+        std::vector<System*> systems = GetUniverse().Objects().FindObjects<System>();
+        for (EmpireManager::const_iterator empire_it = Empires().begin(); empire_it != Empires().end(); ++empire_it)
+            for (std::vector<System*>::iterator it = systems.begin(); it != systems.end(); ++it)
+                GetUniverse().EmpireKnownObjects(empire_it->first).Copy(*it, ALL_EMPIRES);
+        GetUniverse().InvalidateEmpireKnownStarlanes();
+        std::vector<Ship*> ships = GetUniverse().Objects().FindObjects<Ship>();
+        for (std::vector<Ship*>::iterator it = ships.begin(); it != ships.end(); ++it) {
+            Ship* ship = *it;
+            if (Meter* meter = ship->UniverseObject::GetMeter(METER_MAX_FUEL)) {
+                meter->SetCurrent(5.0 + ship->ID() % 3);
+                meter->BackPropegate();
+            }
+            if (Meter* meter = ship->UniverseObject::GetMeter(METER_FUEL)) {
+                meter->SetCurrent(1.0 + ship->ID() % 4);
+                meter->BackPropegate();
+            }
+        }
+
+        Universe::SetEncodingEmpire(ALL_EMPIRES);
+        const std::string universe_text = SaveToString(GetUniverse());
+        const std::string empires_text = SaveToString(Empires());
+
+        const int MOVEMENT_THREADS = 4;
+        std::map<int, FleetMovementResult> serial = MoveFleets(universe_text, empires_text, 1, server);
+        std::map<int, FleetMovementResult> parallel = MoveFleets(universe_text, empires_text, MOVEMENT_THREADS, server);
+
+        bool success = true;
+        if (serial.size() != parallel.size()) {
+            std::cerr << serial.size() << " fleets after moving on one thread, but " << parallel.size()
+                      << " after moving on " << MOVEMENT_THREADS << std::endl;
+            success = false;
+        }
+        std::size_t moved = 0;
+        for (std::map<int, FleetMovementResult>::const_iterator it = serial.begin(); it != serial.end(); ++it) {
+            std::map<int, FleetMovementResult>::const_iterator parallel_it = parallel.find(it->first);
+            if (parallel_it == parallel.end() || !(parallel_it->second == it->second)) {
+                std::cerr << "fleet " << it->first << " moved differently when planned on "
+                          << MOVEMENT_THREADS << " threads" << std::endl;
+                success = false;
+            }
+            if (it->second.prev_system != UniverseObject::INVALID_OBJECT_ID || it->second.system_id == UniverseObject::INVALID_OBJECT_ID)
+                ++moved;
+        }
+
+        std::cout << serial.size() << " fleets, " << moved << " moving" << std::endl;
+        if (!moved)
+            std::cerr << "no fleets moved; the comparison doesn't cover movement" << std::endl;
+        return success ? 0 : 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    InitDirs(argv[0]);
+
+    if (argc < 2) {
+        print_help();
+        exit(1);
+    }
+
+    const std::string test_str = argv[1];
+    if (test_str == "compression_round_trip")
+        return CompressionRoundTrip();
+    if (test_str == "join_game_round_trip")
+        return JoinGameRoundTrip();
+    if (test_str == "memory_estimate")
+        return ObjectMemoryEstimates();
+    if (test_str == "special_index")
+        return SpecialIndex();
+    if (test_str == "diplomacy")
+        return Diplomacy();
+    if (test_str == "movement_threads")
+        return MovementThreads();
+    if (test_str == "turn_update_benchmark" && argc == 3)
+        return TurnUpdateBenchmark(argv[2]);
+    if (test_str == "serialization_round_trip" && (argc == 2 || argc == 8)) {
+        SyntheticGameSize size;
+        if (argc == 8) {
+            try {
+                size.systems =              boost::lexical_cast<int>(argv[2]);
+                size.planets_per_system =   boost::lexical_cast<int>(argv[3]);
+                size.fleets_per_empire =    boost::lexical_cast<int>(argv[4]);
+                size.ships_per_fleet =      boost::lexical_cast<int>(argv[5]);
+                size.buildings_per_planet = boost::lexical_cast<int>(argv[6]);
+                size.empires =              boost::lexical_cast<int>(argv[7]);
+            } catch (const boost::bad_lexical_cast&) {
+                print_help();
+                return 1;
+            }
+        }
+        return SerializationRoundTrip(size);
+    }
+
+    print_help();
+    return 1;
+}
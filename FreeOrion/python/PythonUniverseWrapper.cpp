@@ -127,6 +127,8 @@ namespace {
     boost::function<bool(const Universe&, int, int)> SystemsConnectedFunc =                     &SystemsConnected;
 
     const Meter*            (UniverseObject::*ObjectGetMeter)(MeterType) const =                &UniverseObject::GetMeter;
+    bool                    (UniverseObject::*ObjectHasSpecial)(const std::string&) const =     &UniverseObject::HasSpecial;
+    int                     (UniverseObject::*ObjectSpecialAddedOnTurn)(const std::string&) const = &UniverseObject::SpecialAddedOnTurn;
 
     boost::function<double(const UniverseObject*, MeterType)> InitialCurrentMeterValueFromObject =
         boost::bind(&Meter::Initial, boost::bind(ObjectGetMeter, _1, _2));
@@ -244,8 +246,8 @@ namespace FreeOrionPython {
             .add_property("creationTurn",       &UniverseObject::CreationTurn)
             .add_property("ageInTurns",         &UniverseObject::AgeInTurns)
             //.add_property("specials",           make_function(&UniverseObject::Specials,    return_internal_reference<>()))
-            .def("hasSpecial",                  &UniverseObject::HasSpecial)
-            .def("specialAddedOnTurn",          &UniverseObject::SpecialAddedOnTurn)
+            .def("hasSpecial",                  ObjectHasSpecial)
+            .def("specialAddedOnTurn",          ObjectSpecialAddedOnTurn)
             .def("contains",                    &UniverseObject::Contains)
             .def("containedBy",                 &UniverseObject::ContainedBy)
             .def("currentMeterValue",           &UniverseObject::CurrentMeterValue)
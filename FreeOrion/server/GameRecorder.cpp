@@ -0,0 +1,179 @@
+#include "GameRecorder.h"
+
+#include "ServerApp.h"
+#include "../Empire/Empire.h"
+#include "../Empire/EmpireManager.h"
+#include "../universe/Species.h"
+#include "../util/AppInterface.h"
+#include "../util/OrderSet.h"
+#include "../util/Random.h"
+#include "../util/Serialize.h"
+
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/set.hpp>
+#include <boost/serialization/string.hpp>
+
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    const std::size_t RECORD_HEADER_SIZE = 5;
+}
+
+////////////////////////////////////////////////
+// GameRecorder
+////////////////////////////////////////////////
+GameRecorder::GameRecorder() :
+    m_last_recorded_turn(INVALID_GAME_TURN)
+{}
+
+bool GameRecorder::IsOpen() const
+{ return m_ofs.is_open(); }
+
+int GameRecorder::LastRecordedTurn() const
+{ return m_last_recorded_turn; }
+
+void GameRecorder::Open(const std::string& filename)
+{
+    Close();
+    m_ofs.open(filename.c_str(), std::ios_base::binary | std::ios_base::trunc);
+    if (!m_ofs)
+        Logger().errorStream() << "GameRecorder::Open unable to open " << filename << " for writing; game will not be recorded";
+}
+
+void GameRecorder::Close()
+{
+    if (m_ofs.is_open())
+        m_ofs.close();
+    m_ofs.clear();
+    m_last_recorded_turn = INVALID_GAME_TURN;
+}
+
+void GameRecorder::RecordSnapshot(const ServerSaveGameData& server_save_game_data, const Universe& universe,
+                                  const EmpireManager& empire_manager, const SpeciesManager& species_manager)
+{
+    if (!IsOpen())
+        return;
+    try {
+        WriteRecord(SNAPSHOT_RECORD, SerializeSnapshot(server_save_game_data, universe, empire_manager, species_manager));
+    } catch (const std::exception& e) {
+        Logger().errorStream() << "GameRecorder::RecordSnapshot exception: " << e.what();
+    }
+}
+
+void GameRecorder::RecordTurn(int turn, const std::map<int, OrderSet*>& turn_orders)
+{
+    if (!IsOpen())
+        return;
+    try {
+        std::ostringstream oss;
+        {
+            FREEORION_OARCHIVE_TYPE oa(oss);
+            std::string generator_state = GeneratorState();
+            int empire_count = turn_orders.size();
+            oa << BOOST_SERIALIZATION_NVP(turn)
+               << BOOST_SERIALIZATION_NVP(generator_state)
+               << BOOST_SERIALIZATION_NVP(empire_count);
+            for (std::map<int, OrderSet*>::const_iterator it = turn_orders.begin(); it != turn_orders.end(); ++it) {
+                int empire_id = it->first;
+                oa << BOOST_SERIALIZATION_NVP(empire_id);
+                Serialize(oa, it->second ? *it->second : OrderSet());
+            }
+        }
+        WriteRecord(TURN_RECORD, oss.str());
+        m_last_recorded_turn = turn;
+    } catch (const std::exception& e) {
+        Logger().errorStream() << "GameRecorder::RecordTurn exception: " << e.what();
+    }
+}
+
+std::string GameRecorder::SerializeSnapshot(const ServerSaveGameData& server_save_game_data, const Universe& universe,
+                                            const EmpireManager& empire_manager, const SpeciesManager& species_manager)
+{
+    Universe::SetEncodingEmpire(ALL_EMPIRES);
+
+    std::ostringstream oss;
+    {
+        FREEORION_OARCHIVE_TYPE oa(oss);
+        oa << BOOST_SERIALIZATION_NVP(server_save_game_data);
+        oa << BOOST_SERIALIZATION_NVP(empire_manager);
+        oa << BOOST_SERIALIZATION_NVP(species_manager);
+        Serialize(oa, universe);
+    }
+    return oss.str();
+}
+
+void GameRecorder::DeserializeSnapshot(const std::string& data, ServerSaveGameData& server_save_game_data, Universe& universe,
+                                       EmpireManager& empire_manager, SpeciesManager& species_manager)
+{
+    Universe::SetEncodingEmpire(ALL_EMPIRES);
+
+    empire_manager.Clear();
+    universe.Clear();
+
+    std::istringstream iss(data);
+    FREEORION_IARCHIVE_TYPE ia(iss);
+    ia >> BOOST_SERIALIZATION_NVP(server_save_game_data);
+    ia >> BOOST_SERIALIZATION_NVP(empire_manager);
+    ia >> BOOST_SERIALIZATION_NVP(species_manager);
+    Deserialize(ia, universe);
+}
+
+void GameRecorder::DeserializeTurn(const std::string& data, int& turn, std::string& generator_state,
+                                   std::map<int, OrderSet*>& turn_orders)
+{
+    std::istringstream iss(data);
+    FREEORION_IARCHIVE_TYPE ia(iss);
+    int empire_count = 0;
+    ia >> BOOST_SERIALIZATION_NVP(turn)
+       >> BOOST_SERIALIZATION_NVP(generator_state)
+       >> BOOST_SERIALIZATION_NVP(empire_count);
+    for (int i = 0; i < empire_count; ++i) {
+        int empire_id = ALL_EMPIRES;
+        ia >> BOOST_SERIALIZATION_NVP(empire_id);
+        OrderSet* order_set = new OrderSet;
+        turn_orders[empire_id] = order_set;
+        Deserialize(ia, *order_set);
+    }
+}
+
+void GameRecorder::WriteRecord(RecordType type, const std::string& data)
+{
+    char header[RECORD_HEADER_SIZE];
+    header[0] = static_cast<char>(type);
+    for (std::size_t i = 0; i < 4; ++i)
+        header[1 + i] = static_cast<char>((data.size() >> (8 * i)) & 0xFF);
+    m_ofs.write(header, RECORD_HEADER_SIZE);
+    m_ofs.write(data.data(), data.size());
+    m_ofs.flush();
+}
+
+
+////////////////////////////////////////////////
+// GameRecordReader
+////////////////////////////////////////////////
+GameRecordReader::GameRecordReader(const std::string& filename) :
+    m_ifs(filename.c_str(), std::ios_base::binary)
+{}
+
+bool GameRecordReader::IsOpen() const
+{ return m_ifs.is_open(); }
+
+bool GameRecordReader::ReadRecord(GameRecorder::RecordType& type, std::string& data)
+{
+    char header[RECORD_HEADER_SIZE];
+    if (!m_ifs.read(header, RECORD_HEADER_SIZE))
+        return false;
+
+    type = static_cast<GameRecorder::RecordType>(static_cast<unsigned char>(header[0]));
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < 4; ++i)
+        size |= static_cast<std::size_t>(static_cast<unsigned char>(header[1 + i])) << (8 * i);
+
+    data.resize(size);
+    if (size && !m_ifs.read(&data[0], size)) {
+        Logger().errorStream() << "GameRecordReader::ReadRecord found a truncated record; ignoring the rest of the recording";
+        return false;
+    }
+    return true;
+}
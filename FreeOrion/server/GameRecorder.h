@@ -0,0 +1,103 @@
+// -*- C++ -*-
+#ifndef _GameRecorder_h_
+#define _GameRecorder_h_
+
+#include <fstream>
+#include <map>
+#include <string>
+
+struct ServerSaveGameData;
+class EmpireManager;
+class OrderSet;
+class SpeciesManager;
+class Universe;
+
+/** Records a game, turn by turn, so that its turns can later be reprocessed
+    offline by freeorionreplay, for profiling or as a regression test.  A
+    recording is a sequence of records, each of which is a one-byte record
+    type, a four-byte little-endian length, and that many bytes of serialized
+    data.  Snapshot records hold the complete gamestate at the start of a
+    turn's processing, as saved games do; turn records hold the orders every
+    empire issued that turn and the state of the random number generators
+    when processing began.  Records are appended as the game is played, so a
+    recording of a game that crashed is readable up to the crash. */
+class GameRecorder
+{
+public:
+    enum RecordType {
+        INVALID_RECORD = 0,
+        SNAPSHOT_RECORD,
+        TURN_RECORD
+    };
+
+    /** \name Structors */ //@{
+    GameRecorder();
+    //@}
+
+    /** \name Accessors */ //@{
+    bool    IsOpen() const;
+
+    /** Returns the turn of the last turn record appended, or
+      * INVALID_GAME_TURN if there is none. */
+    int     LastRecordedTurn() const;
+    //@}
+
+    /** \name Mutators */ //@{
+    /** Starts a new recording in \a filename, replacing any existing file. */
+    void    Open(const std::string& filename);
+    void    Close();
+
+    /** Appends a snapshot of the gamestate. */
+    void    RecordSnapshot(const ServerSaveGameData& server_save_game_data, const Universe& universe,
+                           const EmpireManager& empire_manager, const SpeciesManager& species_manager);
+
+    /** Appends the orders issued by each empire on turn \a turn, and the
+      * state of the game's random number generator (see GameContext). */
+    void    RecordTurn(int turn, const std::map<int, OrderSet*>& turn_orders);
+    //@}
+
+    /** Returns the serialized form of a snapshot record of the given state.
+      * Two snapshots of the same gamestate are identical. */
+    static std::string  SerializeSnapshot(const ServerSaveGameData& server_save_game_data, const Universe& universe,
+                                          const EmpireManager& empire_manager, const SpeciesManager& species_manager);
+
+    /** Restores the state in a snapshot record, replacing the current
+      * contents of \a universe and \a empire_manager. */
+    static void         DeserializeSnapshot(const std::string& data, ServerSaveGameData& server_save_game_data, Universe& universe,
+                                            EmpireManager& empire_manager, SpeciesManager& species_manager);
+
+    /** Reads a turn record.  The caller takes ownership of the OrderSets
+      * added to \a turn_orders. */
+    static void         DeserializeTurn(const std::string& data, int& turn, std::string& generator_state,
+                                        std::map<int, OrderSet*>& turn_orders);
+
+private:
+    void    WriteRecord(RecordType type, const std::string& data);
+
+    std::ofstream   m_ofs;
+    int             m_last_recorded_turn;
+};
+
+/** Reads the records of a recording made by GameRecorder, in order. */
+class GameRecordReader
+{
+public:
+    /** \name Structors */ //@{
+    explicit GameRecordReader(const std::string& filename);
+    //@}
+
+    /** \name Accessors */ //@{
+    bool    IsOpen() const;
+    //@}
+
+    /** \name Mutators */ //@{
+    /** Reads the next record.  Returns false at the end of the recording, or
+      * if the rest of the recording is truncated. */
+    bool    ReadRecord(GameRecorder::RecordType& type, std::string& data);
+    //@}
+
+private:
+    std::ifstream   m_ifs;
+};
+
+#endif // _GameRecorder_h_
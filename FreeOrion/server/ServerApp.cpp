@@ -1,5 +1,6 @@
 #include "ServerApp.h"
 
+#include "GameRecorder.h"
 #include "SaveLoad.h"
 #include "ServerFSM.h"
 #include "../combat/CombatSystem.h"
@@ -7,11 +8,13 @@
 #include "../universe/Effect.h"
 #include "../universe/Fleet.h"
 #include "../universe/Ship.h"
+#include "../universe/ShipDesign.h"
 #include "../universe/Planet.h"
 #include "../universe/Predicates.h"
 #include "../universe/Special.h"
 #include "../universe/System.h"
 #include "../universe/Species.h"
+#include "../universe/Tech.h"
 #include "../Empire/Empire.h"
 #include "../util/Directories.h"
 #include "../util/MultiplayerCommon.h"
@@ -22,7 +25,10 @@
 #include <boost/filesystem/exception.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/operations.hpp>
+#include <boost/bind.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/timer.hpp>
 
 #include <log4cpp/Appender.hh>
 #include <log4cpp/Category.hh>
@@ -34,6 +40,40 @@
 
 namespace fs = boost::filesystem;
 
+namespace {
+    void AddOptions(OptionsDB& db) {
+        db.Add<std::string>("record-game",              "File to which the orders issued each turn and periodic snapshots of the gamestate are recorded, for replay with freeorionreplay.  No recording is made if empty.", "");
+        db.Add<int>("record-game-snapshot-interval",    "Number of turns between gamestate snapshots in a game recording.", 10, RangedValidator<int>(1, 1000));
+        db.Add<int>("memory-report-interval",           "Number of turns between log entries estimating the memory used by the server.  0 disables them.", 10, RangedValidator<int>(0, 1000));
+        db.Add<int>("movement-threads",                 "Number of threads used to plan fleet movement each turn.  0 uses one thread per processor core.", 0, RangedValidator<int>(0, 64));
+    }
+    bool temp_bool = RegisterOptions(&AddOptions);
+
+    /** Fewest fleets for which planning movement on another thread is worth
+      * starting the thread. */
+    const std::size_t MIN_FLEETS_PER_MOVEMENT_THREAD = 64;
+
+    /** Plans the movement of the fleets in \a fleets with indices in
+      * [\a first, \a last), storing each plan at its fleet's index in
+      * \a plans.  Run on worker threads, so \a context is made active. */
+    void PlanFleetMovements(GameContext& context, const std::vector<Fleet*>& fleets,
+                            std::vector<Fleet::MovementPlan>& plans, std::size_t first, std::size_t last)
+    {
+        ScopedGameContext scoped_context(context);
+        for (std::size_t i = first; i < last; ++i) {
+            Fleet* fleet = fleets[i];
+            if (!fleet)
+                continue;
+            try {
+                plans[i] = fleet->PlanMovement(context);
+            } catch (const std::exception& e) {
+                Logger().errorStream() << "PlanFleetMovements caught exception planning movement of fleet "
+                                       << fleet->ID() << ": " << e.what();
+            }
+        }
+    }
+}
+
 
 ////////////////////////////////////////////////
 // PlayerSaveGameData
@@ -85,13 +125,14 @@ ServerApp::ServerApp() :
                  boost::bind(&ServerApp::HandleMessage, this, _1, _2),
                  boost::bind(&ServerApp::PlayerDisconnected, this, _1)),
     m_fsm(new ServerFSM(*this)),
-    m_current_turn(INVALID_GAME_TURN),
-    m_single_player_game(false)
+    m_single_player_game(false),
+    m_last_combat_memory("combat data", 0, 0)
 {
     if (s_app)
         throw std::runtime_error("Attempted to construct a second instance of singleton class ServerApp");
 
     s_app = this;
+    GameContext::SetDefault(&m_game);
 
     const std::string SERVER_LOG_FILENAME((GetUserDir() / "freeoriond.log").string());
 
@@ -108,6 +149,10 @@ ServerApp::ServerApp() :
     Logger().setAdditivity(true);   // ...but allow the addition of others later
     Logger().setPriority(log4cpp::Priority::DEBUG);
 
+    const std::string RECORD_FILENAME = GetOptionsDB().Get<std::string>("record-game");
+    if (!RECORD_FILENAME.empty())
+        m_recorder.Open(RECORD_FILENAME);
+
     m_fsm->initiate();
 }
 
@@ -209,10 +254,10 @@ ServerApp* ServerApp::GetApp()
 { return s_app; }
 
 Universe& ServerApp::GetUniverse()
-{ return s_app->m_universe; }
+{ return GameContext::Current().m_universe; }
 
 EmpireManager& ServerApp::Empires()
-{ return s_app->m_empires; }
+{ return GameContext::Current().m_empires; }
 
 CombatData* ServerApp::CurrentCombat()
 { return s_app->m_current_combat; }
@@ -257,6 +302,7 @@ void ServerApp::HandleMessage(Message msg, PlayerConnectionPtr player_connection
     case Message::LOBBY_CHAT:               m_fsm->process_event(LobbyChat(msg, player_connection));        break;
     case Message::SAVE_GAME:                m_fsm->process_event(SaveGameRequest(msg, player_connection));  break;
     case Message::TURN_ORDERS:              m_fsm->process_event(TurnOrders(msg, player_connection));       break;
+    case Message::TURN_PARTIAL_ORDERS:      m_fsm->process_event(TurnPartialOrders(msg, player_connection)); break;
     case Message::COMBAT_TURN_ORDERS:       m_fsm->process_event(CombatTurnOrders(msg, player_connection)); break;
     case Message::CLIENT_SAVE_DATA:         m_fsm->process_event(ClientSaveData(msg, player_connection));   break;
     case Message::PLAYER_CHAT:              m_fsm->process_event(PlayerChat(msg, player_connection));       break;
@@ -266,8 +312,8 @@ void ServerApp::HandleMessage(Message msg, PlayerConnectionPtr player_connection
     // TODO: For prototyping only.
     case Message::COMBAT_END:               m_fsm->process_event(CombatComplete()); break;
 
-    case Message::ERROR:
-    case Message::DEBUG:                    break;
+    case Message::ERROR:                    break;
+    case Message::DEBUG:                    HandleDebugCommand(msg, player_connection); break;
 
     default:
         Logger().errorStream() << "ServerApp::HandleMessage : Received an unknown message type \"" << msg.Type() << "\".  Terminating connection.";
@@ -276,6 +322,29 @@ void ServerApp::HandleMessage(Message msg, PlayerConnectionPtr player_connection
     }
 }
 
+void ServerApp::HandleDebugCommand(const Message& msg, PlayerConnectionPtr player_connection)
+{
+    const std::string command = msg.Text();
+    if (command == "memory-report") {
+        // the report reveals the size of the whole game, including what the
+        // player's empire can't see, so only the host may request it
+        if (!m_networking.PlayerIsHost(player_connection->PlayerID())) {
+            Logger().errorStream() << "ServerApp::HandleDebugCommand : Player #" << player_connection->PlayerID()
+                                   << " requested a memory report, but is not the host.  Ignoring request.";
+            return;
+        }
+        MemoryReport report;
+        GetMemoryReport(report);
+        std::string dump = report.Dump();
+        Logger().debugStream() << "ServerApp::HandleDebugCommand memory report requested by player "
+                               << player_connection->PlayerID() << ":\n" << dump;
+        // the client only displays chat from known players, so the report is
+        // sent back as if the requesting player had sent it to themself
+        player_connection->SendMessage(SingleRecipientChatMessage(player_connection->PlayerID(),
+                                                                  player_connection->PlayerID(), dump));
+    }
+}
+
 void ServerApp::HandleNonPlayerMessage(Message msg, PlayerConnectionPtr player_connection)
 {
     switch (msg.Type()) {
@@ -512,13 +581,14 @@ void ServerApp::NewGameInit(const GalaxySetupData& galaxy_setup_data, const std:
     }
 
     // clear previous game player state info
+    ClearEmpireTurnOrders();
     m_turn_sequence.clear();
     m_eliminated_players.clear();
     m_player_empire_ids.clear();
 
 
     // set server state info for new game
-    m_current_turn =    BEFORE_FIRST_TURN;
+    m_game.m_current_turn =    BEFORE_FIRST_TURN;
     m_victors.clear();
 
 
@@ -526,14 +596,14 @@ void ServerApp::NewGameInit(const GalaxySetupData& galaxy_setup_data, const std:
     Logger().debugStream() << "ServerApp::NewGameInit: Creating Universe";
     m_networking.SendMessage(TurnProgressMessage(Message::GENERATING_UNIVERSE));
 
-    // m_current_turn set above so that every UniverseObject created before game starts will have m_created_on_turn BEFORE_FIRST_TURN
-    m_universe.CreateUniverse(galaxy_setup_data.m_size,             galaxy_setup_data.m_shape,
+    // m_game.m_current_turn set above so that every UniverseObject created before game starts will have m_created_on_turn BEFORE_FIRST_TURN
+    m_game.m_universe.CreateUniverse(galaxy_setup_data.m_size,             galaxy_setup_data.m_shape,
                               galaxy_setup_data.m_age,              galaxy_setup_data.m_starlane_freq,
                               galaxy_setup_data.m_planet_density,   galaxy_setup_data.m_specials_freq,
                               galaxy_setup_data.m_monster_freq,     galaxy_setup_data.m_native_freq,
                               active_players_id_setup_data);
     // after all game initialization stuff has been created, can set current turn to 1 for start of game
-    m_current_turn = 1;
+    m_game.m_current_turn = 1;
 
 
     // record empires for each active player: ID of empire and player should be the same when creating a new game.
@@ -574,29 +644,11 @@ void ServerApp::NewGameInit(const GalaxySetupData& galaxy_setup_data, const std:
 
     // update visibility information to ensure data sent out is up-to-date
     Logger().debugStream() << "ServerApp::NewGameInit: Updating first-turn Empire stuff";
-    m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+    m_game.m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
 
 
     // Determine initial supply distribution and exchanging and resource pools for empires
-    EmpireManager& empires = Empires();
-    for (EmpireManager::iterator it = empires.begin(); it != empires.end(); ++it) {
-        if (empires.Eliminated(it->first))
-            continue;   // skip eliminated empires.  presumably this shouldn't be an issue when initializing a new game, but apparently I thought this was worth checking for...
-        Empire* empire = it->second;
-
-        empire->UpdateSupplyUnobstructedSystems();  // determines which systems can propegate fleet and resource (same for both)
-        empire->UpdateSystemSupplyRanges();         // sets range systems can propegate fleet and resourse supply (separately)
-        empire->UpdateFleetSupply();                // determines which systems can access fleet supply, and starlane traversals used to do this
-        empire->UpdateResourceSupply();             // determines the separate groups of systems within which (but not between which) resources can be shared
-        empire->InitResourcePools();                // determines population centers and resource centers of empire, tells resource pools the centers and groups of systems that can share resources (note that being able to share resources doesn't mean a system produces resources)
-        empire->UpdateResourcePools();              // determines how much of each resources is available in each resource sharing group
-    }
-
-    // self-allocate resources on unowned planets, so natives don't starve
-    std::vector<Planet*> planets = m_universe.Objects().FindObjects<Planet>();
-    for (std::vector<Planet*>::const_iterator it = planets.begin(); it != planets.end(); ++it)
-        if ((*it)->Unowned() && (*it)->CurrentMeterValue(METER_POPULATION) > 0.0)
-            (*it)->SetAllocatedFood(std::min((*it)->CurrentMeterValue(METER_FARMING), (*it)->CurrentMeterValue(METER_POPULATION)));
+    UpdateEmpireSupplyAndResourcePools();
 
 
     // send new game start messages
@@ -610,9 +662,9 @@ void ServerApp::NewGameInit(const GalaxySetupData& galaxy_setup_data, const std:
         player_connection->SendMessage(GameStartMessage(player_id,
                                                         m_single_player_game,
                                                         empire_id,
-                                                        m_current_turn,
-                                                        m_empires,
-                                                        m_universe,
+                                                        m_game.m_current_turn,
+                                                        m_game.m_empires,
+                                                        m_game.m_universe,
                                                         GetSpeciesManager(),
                                                         player_info_map));
     }
@@ -736,13 +788,14 @@ void ServerApp::LoadGameInit(const std::vector<PlayerSaveGameData>& player_save_
 
 
     // clear previous game player state info
+    ClearEmpireTurnOrders();
     m_turn_sequence.clear();
     m_eliminated_players.clear();
     m_player_empire_ids.clear();
 
 
     // restore server state info from save
-    m_current_turn =    server_save_game_data->m_current_turn;
+    m_game.m_current_turn =    server_save_game_data->m_current_turn;
     m_victors =         server_save_game_data->m_victors;
     // todo: save and restore m_eliminated_players ?
 
@@ -784,29 +837,11 @@ void ServerApp::LoadGameInit(const std::vector<PlayerSaveGameData>& player_save_
 
     // the Universe's system graphs for each empire aren't stored when saving
     // so need to be reinitialized when loading based on the gamestate
-    m_universe.RebuildEmpireViewSystemGraphs();
+    m_game.m_universe.RebuildEmpireViewSystemGraphs();
 
 
     // Determine supply distribution and exchanging and resource pools for empires
-    EmpireManager& empires = Empires();
-    for (EmpireManager::iterator it = empires.begin(); it != empires.end(); ++it) {
-        if (empires.Eliminated(it->first))
-            continue;   // skip eliminated empires.  presumably this shouldn't be an issue when initializing a new game, but apparently I thought this was worth checking for...
-        Empire* empire = it->second;
-
-        empire->UpdateSupplyUnobstructedSystems();  // determines which systems can propegate fleet and resource (same for both)
-        empire->UpdateSystemSupplyRanges();         // sets range systems can propegate fleet and resourse supply (separately)
-        empire->UpdateFleetSupply();                // determines which systems can access fleet supply, and starlane traversals used to do this
-        empire->UpdateResourceSupply();             // determines the separate groups of systems within which (but not between which) resources can be shared
-        empire->InitResourcePools();                // determines population centers and resource centers of empire, tells resource pools the centers and groups of systems that can share resources (note that being able to share resources doesn't mean a system produces resources)
-        empire->UpdateResourcePools();              // determines how much of each resources is available in each resource sharing group
-    }
-
-    // self-allocate resources on unowned planets, so natives don't starve
-    std::vector<Planet*> planets = m_universe.Objects().FindObjects<Planet>();
-    for (std::vector<Planet*>::const_iterator it = planets.begin(); it != planets.end(); ++it)
-        if ((*it)->Unowned() && (*it)->CurrentMeterValue(METER_POPULATION) > 0.0)
-            (*it)->SetAllocatedFood(std::min((*it)->CurrentMeterValue(METER_FARMING), (*it)->CurrentMeterValue(METER_POPULATION)));
+    UpdateEmpireSupplyAndResourcePools();
 
 
     // compile information about players to send out to other players at start of game.
@@ -877,13 +912,13 @@ void ServerApp::LoadGameInit(const std::vector<PlayerSaveGameData>& player_save_
             if (!psgd.m_save_state_string.empty())
                 sss = &psgd.m_save_state_string;
             player_connection->SendMessage(GameStartMessage(player_id, m_single_player_game, empire_id,
-                                                            m_current_turn, m_empires, m_universe,
+                                                            m_game.m_current_turn, m_game.m_empires, m_game.m_universe,
                                                             GetSpeciesManager(),
                                                             player_info_map, *orders, sss));
 
         } else if (client_type == Networking::CLIENT_TYPE_HUMAN_PLAYER) {
             player_connection->SendMessage(GameStartMessage(player_id, m_single_player_game, empire_id,
-                                                            m_current_turn, m_empires, m_universe,
+                                                            m_game.m_current_turn, m_game.m_empires, m_game.m_universe,
                                                             GetSpeciesManager(),
                                                             player_info_map, *orders, psgd.m_ui_data.get()));
 
@@ -915,6 +950,60 @@ int ServerApp::EmpirePlayerID(int empire_id) const
     return Networking::INVALID_PLAYER_ID;
 }
 
+void ServerApp::GetMemoryReport(MemoryReport& report) const
+{
+    m_game.m_universe.GetMemoryReport(report);
+
+    std::size_t content_items = 0, content_bytes = 0;
+    const TechManager& tech_manager = GetTechManager();
+    for (TechManager::iterator it = tech_manager.begin(); it != tech_manager.end(); ++it, ++content_items)
+        content_bytes += sizeof(Tech);
+    const BuildingTypeManager& building_type_manager = GetBuildingTypeManager();
+    for (BuildingTypeManager::iterator it = building_type_manager.begin(); it != building_type_manager.end(); ++it, ++content_items)
+        content_bytes += sizeof(BuildingType);
+    const PartTypeManager& part_type_manager = GetPartTypeManager();
+    for (PartTypeManager::iterator it = part_type_manager.begin(); it != part_type_manager.end(); ++it, ++content_items)
+        content_bytes += sizeof(PartType);
+    const HullTypeManager& hull_type_manager = GetHullTypeManager();
+    for (HullTypeManager::iterator it = hull_type_manager.begin(); it != hull_type_manager.end(); ++it, ++content_items)
+        content_bytes += sizeof(HullType);
+    std::size_t num_species = GetSpeciesManager().NumSpecies();
+    std::size_t num_specials = SpecialNames().size();
+    content_items += num_species + num_specials;
+    content_bytes += num_species * sizeof(Species) + num_specials * sizeof(Special);
+    report.Add("parsed content", content_items, content_bytes);
+
+    report.Add(m_last_combat_memory.subsystem, m_last_combat_memory.items, m_last_combat_memory.bytes);
+
+    std::size_t connections = 0, message_bytes = 0;
+    for (ServerNetworking::const_iterator it = m_networking.begin(); it != m_networking.end(); ++it, ++connections)
+        message_bytes += (*it)->IncomingMessageBufferSize();
+    report.Add("message buffers", connections, message_bytes);
+}
+
+void ServerApp::UpdateEmpireSupplyAndResourcePools()
+{
+    EmpireManager& empires = Empires();
+    for (EmpireManager::iterator it = empires.begin(); it != empires.end(); ++it) {
+        if (empires.Eliminated(it->first))
+            continue;   // skip eliminated empires
+        Empire* empire = it->second;
+
+        empire->UpdateSupplyUnobstructedSystems();  // determines which systems can propegate fleet and resource (same for both)
+        empire->UpdateSystemSupplyRanges();         // sets range systems can propegate fleet and resourse supply (separately)
+        empire->UpdateFleetSupply();                // determines which systems can access fleet supply, and starlane traversals used to do this
+        empire->UpdateResourceSupply();             // determines the separate groups of systems within which (but not between which) resources can be shared
+        empire->InitResourcePools();                // determines population centers and resource centers of empire, tells resource pools the centers and groups of systems that can share resources (note that being able to share resources doesn't mean a system produces resources)
+        empire->UpdateResourcePools();              // determines how much of each resources is available in each resource sharing group
+    }
+
+    // self-allocate resources on unowned planets, so natives don't starve
+    std::vector<Planet*> planets = m_game.m_universe.Objects().FindObjects<Planet>();
+    for (std::vector<Planet*>::const_iterator it = planets.begin(); it != planets.end(); ++it)
+        if ((*it)->Unowned() && (*it)->CurrentMeterValue(METER_POPULATION) > 0.0)
+            (*it)->SetAllocatedFood(std::min((*it)->CurrentMeterValue(METER_FARMING), (*it)->CurrentMeterValue(METER_POPULATION)));
+}
+
 void ServerApp::AddEmpireTurn(int empire_id)
 {
     m_turn_sequence[empire_id] = 0; // std::map<int, OrderSet*>
@@ -923,11 +1012,46 @@ void ServerApp::AddEmpireTurn(int empire_id)
 void ServerApp::RemoveEmpireTurn(int empire_id)
 {
     m_turn_sequence.erase(empire_id);
+
+    std::map<int, OrderSet*>::iterator it = m_pending_turn_orders.find(empire_id);
+    if (it != m_pending_turn_orders.end()) {
+        delete it->second;
+        m_pending_turn_orders.erase(it);
+    }
 }
 
 void ServerApp::SetEmpireTurnOrders(int empire_id, OrderSet* order_set)
 {
     m_turn_sequence[empire_id] = order_set;
+
+    std::map<int, OrderSet*>::iterator it = m_pending_turn_orders.find(empire_id);
+    if (it != m_pending_turn_orders.end()) {
+        delete it->second;
+        m_pending_turn_orders.erase(it);
+    }
+}
+
+void ServerApp::UpdateEmpirePendingTurnOrders(int empire_id, const OrderSet& orders,
+                                              const std::set<int>& rescinded_order_ids)
+{
+    OrderSet*& pending_orders = m_pending_turn_orders[empire_id];
+    if (!pending_orders)
+        pending_orders = new OrderSet;
+    pending_orders->ApplyChanges(orders, rescinded_order_ids);
+}
+
+const OrderSet& ServerApp::SubmitEmpirePendingTurnOrders(int empire_id)
+{
+    OrderSet* order_set = 0;
+    std::map<int, OrderSet*>::iterator it = m_pending_turn_orders.find(empire_id);
+    if (it != m_pending_turn_orders.end()) {
+        order_set = it->second;
+        m_pending_turn_orders.erase(it);
+    }
+    if (!order_set)
+        order_set = new OrderSet;
+    SetEmpireTurnOrders(empire_id, order_set);
+    return *order_set;
 }
 
 void ServerApp::ClearEmpireTurnOrders()
@@ -938,6 +1062,9 @@ void ServerApp::ClearEmpireTurnOrders()
             it->second = 0;
         }
     }
+    for (std::map<int, OrderSet*>::iterator it = m_pending_turn_orders.begin(); it != m_pending_turn_orders.end(); ++it)
+        delete it->second;
+    m_pending_turn_orders.clear();
 }
 
 bool ServerApp::AllOrdersReceived()
@@ -960,8 +1087,8 @@ namespace {
         if (!empire)
             return false;
         int empire_id = empire->EmpireID();
-        return (universe.Objects().FindObjects(OwnedVisitor<Planet>(empire_id)).empty() &&    // no planets
-                universe.Objects().FindObjects(OwnedVisitor<Fleet>(empire_id)).empty());      // no fleets
+        return (universe.Objects().NumOwnedObjects(empire_id, OBJ_PLANET) == 0 &&  // no planets
+                universe.Objects().NumOwnedObjects(empire_id, OBJ_FLEET) == 0);    // no fleets
     }
 
     /** Compiles and return set of ids of empires that are controlled by a
@@ -1034,6 +1161,18 @@ namespace {
     }
 
 
+    /** Returns true iff any empire in \a empire_ids1 is at war with any
+      * empire in \a empire_ids2.  Either set may contain ALL_EMPIRES, which
+      * is at war with every empire. */
+    bool AnyEmpiresAtWar(const std::set<int>& empire_ids1, const std::set<int>& empire_ids2) {
+        const EmpireManager& empires = Empires();
+        for (std::set<int>::const_iterator it1 = empire_ids1.begin(); it1 != empire_ids1.end(); ++it1)
+            for (std::set<int>::const_iterator it2 = empire_ids2.begin(); it2 != empire_ids2.end(); ++it2)
+                if (empires.AtWar(*it1, *it2))
+                    return true;
+        return false;
+    }
+
     /** Returns true iff there is an appropriate combination of objects in the
       * system with id \a system_id for a combat to occur. */
     bool CombatConditionsInSystem(int system_id) {
@@ -1042,43 +1181,21 @@ namespace {
         std::set<int> ids_of_empires_with_fleets_here;
         GetEmpireIDsWithFleetsAndCombatFleetsAtSystem(ids_of_empires_with_fleets_here, ids_of_empires_with_combat_fleets_here, system_id);
 
-        // combat can occur if more than one empire has a combat fleet in system
-        if (ids_of_empires_with_combat_fleets_here.size() > 1)
-            return true;
+        if (ids_of_empires_with_combat_fleets_here.empty())
+            return false;   // no possible attackers
 
-        // combat can occur if one empire has a combat fleet and another empire
-        // has any fleet
-        if (!ids_of_empires_with_combat_fleets_here.empty() && ids_of_empires_with_fleets_here.size() > 1)
+        // combat can occur if an empire has a combat fleet and another empire
+        // it is at war with has any fleet (combat fleets are also fleets)
+        if (AnyEmpiresAtWar(ids_of_empires_with_combat_fleets_here, ids_of_empires_with_fleets_here))
             return true;
 
 
         std::set<int> ids_of_empires_with_planets_here;
         GetEmpireIDsWithPlanetsAtSystem(ids_of_empires_with_planets_here, system_id);
 
-
-        // combat can also occur if there is at least one fleet and one
-        // other empire's planetary defenses that can harm the fleets
-        if (!ids_of_empires_with_combat_fleets_here.empty() && !ids_of_empires_with_planets_here.empty()) {
-
-            for (std::set<int>::const_iterator planet_owner_it = ids_of_empires_with_planets_here.begin();
-                 planet_owner_it != ids_of_empires_with_planets_here.end();
-                 ++planet_owner_it)
-            {
-                int planet_owner_id = *planet_owner_it;
-
-                // find a combat fleet owned by a different empire
-                for (std::set<int>::const_iterator combat_fleet_owner_it = ids_of_empires_with_combat_fleets_here.begin();
-                     combat_fleet_owner_it != ids_of_empires_with_combat_fleets_here.end();
-                     ++combat_fleet_owner_it)
-                {
-                    int combat_fleet_owner_id = *combat_fleet_owner_it;
-                    if (combat_fleet_owner_id != planet_owner_id)
-                        return true;
-                }
-            }
-        }
-
-        return false;   // no possible conditions for combat were found
+        // combat can also occur if there is at least one combat fleet and a
+        // planet owned by an empire at war with the fleet's owner
+        return AnyEmpiresAtWar(ids_of_empires_with_combat_fleets_here, ids_of_empires_with_planets_here);
     }
 
     /** Cleans up CombatInfo within \a system_combat_info. */
@@ -1088,6 +1205,24 @@ namespace {
         system_combat_info.clear();
     }
 
+    /** Returns an estimate of the memory used by the objects copied into the
+      * CombatInfo within \a system_combat_info. */
+    MemoryReport::Entry SystemCombatInfoMemory(const std::map<int, CombatInfo>& system_combat_info) {
+        MemoryReport::Entry retval("combat data", 0, 0);
+        for (std::map<int, CombatInfo>::const_iterator it = system_combat_info.begin(); it != system_combat_info.end(); ++it) {
+            const CombatInfo& combat_info = it->second;
+            retval.items += combat_info.objects.NumObjects();
+            retval.bytes += sizeof(CombatInfo) + combat_info.objects.MemoryUsage();
+            for (std::map<int, ObjectMap>::const_iterator eko_it = combat_info.empire_known_objects.begin();
+                 eko_it != combat_info.empire_known_objects.end(); ++eko_it)
+            {
+                retval.items += eko_it->second.NumObjects();
+                retval.bytes += eko_it->second.MemoryUsage();
+            }
+        }
+        return retval;
+    }
+
     /** Clears and refills \a system_combat_info with CombatInfo structs for
       * every system where a combat should occur this turn. */
     void AssembleSystemCombatInfo(std::map<int, CombatInfo>& system_combat_info) {
@@ -1156,6 +1291,7 @@ namespace {
 
                 actual_known_objects.Copy(combat_known_objects);
             };
+            universe.InvalidateEmpireKnownStarlanes();
 
 
             // destroy in main universe objects that were destroyed in combat,
@@ -1610,13 +1746,40 @@ namespace {
     }
 }
 
+void ServerApp::PrecomputeTurnProcessing()
+{
+    ScopedGameContext game_context(m_game);
+    boost::timer timer;
+
+    // starlanes known to each empire, used for pathfinding during order
+    // execution and fleet movement
+    m_game.m_universe.PrecomputeEmpireKnownStarlanes();
+
+    Logger().debugStream() << "ServerApp::PrecomputeTurnProcessing took " << timer.elapsed() << " s";
+}
+
 void ServerApp::PreCombatProcessTurns()
 {
+    ScopedGameContext game_context(m_game);
     EmpireManager& empires = Empires();
-    ObjectMap& objects = m_universe.Objects();
+    ObjectMap& objects = m_game.m_universe.Objects();
+
 
+    m_game.m_universe.RebuildEmpireViewSystemGraphs();
 
-    m_universe.RebuildEmpireViewSystemGraphs();
+
+    // record the gamestate before any orders are executed, whenever a game
+    // is started or loaded and every few turns thereafter, and this turn's
+    // orders, so that the turn can be replayed
+    if (m_recorder.IsOpen()) {
+        if (m_recorder.LastRecordedTurn() != m_game.m_current_turn - 1 ||
+            m_game.m_current_turn % GetOptionsDB().Get<int>("record-game-snapshot-interval") == 0)
+        {
+            m_recorder.RecordSnapshot(ServerSaveGameData(m_game.m_current_turn, m_victors),
+                                      m_game.m_universe, m_game.m_empires, GetSpeciesManager());
+        }
+        m_recorder.RecordTurn(m_game.m_current_turn, m_turn_sequence);
+    }
 
 
     Logger().debugStream() << "ServerApp::ProcessTurns executing orders";
@@ -1663,14 +1826,14 @@ void ServerApp::PreCombatProcessTurns()
         }
     }
     for (std::vector<int>::const_iterator it = objects_to_scrap.begin(); it != objects_to_scrap.end(); ++it)
-        m_universe.Destroy(*it);
+        m_game.m_universe.Destroy(*it);
 
     // check for empty fleets after scrapping
     std::vector<Fleet*> fleets = objects.FindObjects<Fleet>();
     for (std::vector<Fleet*>::iterator it = fleets.begin(); it != fleets.end(); ++it) {
         if (Fleet* fleet = *it)
             if (fleet->Empty())
-                m_universe.Destroy(fleet->ID());
+                m_game.m_universe.Destroy(fleet->ID());
     }
 
 
@@ -1681,15 +1844,38 @@ void ServerApp::PreCombatProcessTurns()
     m_networking.SendMessage(TurnProgressMessage(Message::FLEET_MOVEMENT));
 
 
-    // fleet movement
+    // fleet movement.  a fleet's movement is planned from the gamestate at
+    // the start of movement, which planning doesn't change except for the
+    // planned fleet's own cached route, so fleets are planned concurrently.
+    // the plans, including resupply, are then carried out on this thread one
+    // at a time, in order of fleet ID
     fleets = objects.FindObjects<Fleet>();
-    for (std::vector<Fleet*>::iterator it = fleets.begin(); it != fleets.end(); ++it) {
+    std::vector<Fleet::MovementPlan> movement_plans(fleets.size());
+
+    std::size_t movement_threads = GetOptionsDB().Get<int>("movement-threads");
+    if (!movement_threads)
+        movement_threads = std::max(1u, boost::thread::hardware_concurrency());
+    movement_threads = std::min(movement_threads, fleets.size() / MIN_FLEETS_PER_MOVEMENT_THREAD);
+
+    if (movement_threads <= 1) {
+        PlanFleetMovements(m_game, fleets, movement_plans, 0, fleets.size());
+    } else {
+        boost::thread_group planning_threads;
+        std::size_t fleets_per_thread = (fleets.size() + movement_threads - 1) / movement_threads;
+        for (std::size_t first = 0; first < fleets.size(); first += fleets_per_thread)
+            planning_threads.create_thread(boost::bind(&PlanFleetMovements, boost::ref(m_game), boost::cref(fleets),
+                                                       boost::ref(movement_plans), first,
+                                                       std::min(first + fleets_per_thread, fleets.size())));
+        planning_threads.join_all();
+    }
+
+    for (std::size_t i = 0; i < fleets.size(); ++i) {
         // save for possible SitRep generation after moving...
-        Fleet* fleet = *it;
+        Fleet* fleet = fleets[i];
         if (!fleet)
             continue;
 
-        fleet->MovementPhase();
+        fleet->CommitMovement(movement_plans[i]);
 
         // TODO: Do movement incrementally, and if the moving fleet encounters
         // stationary combat fleets or planetary defenses that can hurt it, it
@@ -1706,8 +1892,11 @@ void ServerApp::PreCombatProcessTurns()
 
 
     // post-movement visibility update
-    m_universe.UpdateEmpireObjectVisibilities();
-    m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+    m_game.m_universe.UpdateEmpireObjectVisibilities();
+    m_game.m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+    // only recomputes the starlanes known to empires that learned of new
+    // ones while moving; the rest were computed while waiting for orders
+    m_game.m_universe.PrecomputeEmpireKnownStarlanes();
 
 
     // update fleet routes after movement
@@ -1729,12 +1918,13 @@ void ServerApp::PreCombatProcessTurns()
         int player_id = player->PlayerID();
         player->SendMessage(TurnPartialUpdateMessage(player_id,
                                                      PlayerEmpireID(player_id),
-                                                     m_universe));
+                                                     m_game.m_universe));
     }
 }
 
 void ServerApp::ProcessCombats()
 {
+    ScopedGameContext game_context(m_game);
     Logger().debugStream() << "ServerApp::ProcessCombats";
     m_networking.SendMessage(TurnProgressMessage(Message::COMBAT));
 
@@ -1813,17 +2003,20 @@ void ServerApp::ProcessCombats()
 
     CreateCombatSitReps(system_combat_info);
 
+    m_last_combat_memory = SystemCombatInfoMemory(system_combat_info);
+
     CleanupSystemCombatInfo(system_combat_info);
 }
 
 void ServerApp::PostCombatProcessTurns()
 {
+    ScopedGameContext game_context(m_game);
     EmpireManager& empires = Empires();
-    ObjectMap& objects = m_universe.Objects();
+    ObjectMap& objects = m_game.m_universe.Objects();
 
     // post-combat visibility update
-    m_universe.UpdateEmpireObjectVisibilities();
-    m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+    m_game.m_universe.UpdateEmpireObjectVisibilities();
+    m_game.m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
 
 
     // check for loss of empire capitals
@@ -1851,7 +2044,7 @@ void ServerApp::PostCombatProcessTurns()
     }
 
     // execute all effects and update meters prior to production, research, etc.
-    m_universe.ApplyAllEffectsAndUpdateMeters();
+    m_game.m_universe.ApplyAllEffectsAndUpdateMeters();
 
     if (GetOptionsDB().Get<bool>("verbose-logging")) {
         Logger().debugStream() << "!!!!!!!!!!!!!!!!!!!!!!AFTER TURN PROCESSING EFFECTS APPLICATION";
@@ -1863,24 +2056,7 @@ void ServerApp::PostCombatProcessTurns()
 
 
     // Determine how much of each resource is available, and determine how to distribute it to planets or on queues
-    for (EmpireManager::iterator it = empires.begin(); it != empires.end(); ++it) {
-        if (empires.Eliminated(it->first))
-            continue;   // skip eliminated empires
-        Empire* empire = it->second;
-
-        empire->UpdateSupplyUnobstructedSystems();  // determines which systems can propegate fleet and resource (same for both)
-        empire->UpdateSystemSupplyRanges();         // sets range systems can propegate fleet and resourse supply (separately)
-        empire->UpdateFleetSupply();                // determines which systems can access fleet supply, and starlane traversals used to do this
-        empire->UpdateResourceSupply();             // determines the separate groups of systems within which (but not between which) resources can be shared
-        empire->InitResourcePools();                // determines population centers and resource centers of empire, tells resource pools the centers and groups of systems that can share resources (note that being able to share resources doesn't mean a system produces resources)
-        empire->UpdateResourcePools();              // determines how much of each resources is available in each resource sharing group
-    }
-
-    // self-allocate resources on unowned planets, so natives don't starve
-    std::vector<Planet*> planets = m_universe.Objects().FindObjects<Planet>();
-    for (std::vector<Planet*>::const_iterator it = planets.begin(); it != planets.end(); ++it)
-        if ((*it)->Unowned() && (*it)->CurrentMeterValue(METER_POPULATION) > 0.0)
-            (*it)->SetAllocatedFood(std::min((*it)->CurrentMeterValue(METER_FARMING), (*it)->CurrentMeterValue(METER_POPULATION)));
+    UpdateEmpireSupplyAndResourcePools();
 
 
     if (GetOptionsDB().Get<bool>("verbose-logging")) {
@@ -1914,7 +2090,7 @@ void ServerApp::PostCombatProcessTurns()
     // UniverseObjects will have effects applied to them this turn, allowing
     // (for example) ships to have max fuel meters greater than 0 on the turn
     // they are created.
-    m_universe.ApplyMeterEffectsAndUpdateMeters();
+    m_game.m_universe.ApplyMeterEffectsAndUpdateMeters();
 
 
     if (GetOptionsDB().Get<bool>("verbose-logging")) {
@@ -1950,7 +2126,7 @@ void ServerApp::PostCombatProcessTurns()
 
 
     // store initial values of meters for this turn.
-    m_universe.BackPropegateObjectMeters();
+    m_game.m_universe.BackPropegateObjectMeters();
 
 
     // store any changes in objects from various progress functions, such as
@@ -1958,17 +2134,17 @@ void ServerApp::PostCombatProcessTurns()
     // visibility update removes an empires ability to detect an object, the
     // empire will still know the latest state (eg. 0 population planet) on the
     // turn when the empire did have detection ability for the object
-    m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+    m_game.m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
 
 
 
     // post-production and meter-effects visibility update
-    m_universe.UpdateEmpireObjectVisibilities();
+    m_game.m_universe.UpdateEmpireObjectVisibilities();
 
 
     // regenerate empire system graphs based on latest visibility information.
     // this is used by CalculateRoute and other system connectivity tests
-    m_universe.RebuildEmpireViewSystemGraphs();
+    m_game.m_universe.RebuildEmpireViewSystemGraphs();
 
 
 
@@ -1988,12 +2164,12 @@ void ServerApp::PostCombatProcessTurns()
 
     // update current turn number so that following visibility updates and info
     // sent to players will have updated turn associated with them
-    ++m_current_turn;
+    ++m_game.m_current_turn;
 
 
     // new turn visibility update
-    m_universe.UpdateEmpireObjectVisibilities();
-    m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+    m_game.m_universe.UpdateEmpireObjectVisibilities();
+    m_game.m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
 
 
 
@@ -2026,18 +2202,26 @@ void ServerApp::PostCombatProcessTurns()
         int player_id = player->PlayerID();
         player->SendMessage(TurnUpdateMessage(player_id,
                                               PlayerEmpireID(player_id),
-                                              m_current_turn,
-                                              m_empires,
-                                              m_universe,
+                                              m_game.m_current_turn,
+                                              m_game.m_empires,
+                                              m_game.m_universe,
                                               GetSpeciesManager(),
                                               players));
     }
+
+    int memory_report_interval = GetOptionsDB().Get<int>("memory-report-interval");
+    if (memory_report_interval > 0 && m_game.m_current_turn % memory_report_interval == 0) {
+        MemoryReport report;
+        GetMemoryReport(report);
+        Logger().debugStream() << "ServerApp::PostCombatProcessTurns estimated memory use on turn "
+                               << m_game.m_current_turn << ": " << report.Summary();
+    }
 }
 
 void ServerApp::CheckForEmpireEliminationOrVictory()
 {
     //EmpireManager& empires = Empires();
-    //ObjectMap& objects = m_universe.Objects();
+    //ObjectMap& objects = m_game.m_universe.Objects();
 
     //// check for eliminated empires and players
     //std::map<int, int> eliminations; // map from player id to empire id of eliminated players, for empires eliminated this turn
@@ -2048,7 +2232,7 @@ void ServerApp::CheckForEmpireEliminationOrVictory()
     //    Logger().debugStream() << "empire " << empire_id << " not yet eliminated";
 
     //    const Empire* empire = it->second;
-    //    if (!EmpireEliminated(empire, m_universe))
+    //    if (!EmpireEliminated(empire, m_game.m_universe))
     //        continue;
     //    Logger().debugStream() << " ... but IS eliminated this turn";
 
@@ -2061,7 +2245,7 @@ void ServerApp::CheckForEmpireEliminationOrVictory()
     //std::map<int, std::set<std::string> > new_victors; // map from player ID to set of victory reason strings
 
     //// marked by Victory effect?
-    //const std::multimap<int, std::string>& marked_for_victory = m_universe.GetMarkedForVictory();
+    //const std::multimap<int, std::string>& marked_for_victory = m_game.m_universe.GetMarkedForVictory();
     //for (std::multimap<int, std::string>::const_iterator it = marked_for_victory.begin(); it != marked_for_victory.end(); ++it) {
     //    const UniverseObject* obj = objects.Object(it->first);
     //    if (!obj || obj->Unowned()) continue; // perhaps it was destroyed?
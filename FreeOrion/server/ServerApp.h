@@ -7,8 +7,11 @@
 #include "../Empire/EmpireManager.h"
 #include "../network/Networking.h"
 #include "../network/ServerNetworking.h"
+#include "../universe/MemoryReport.h"
 #include "../universe/Universe.h"
 #include "../util/MultiplayerCommon.h"
+#include "../util/GameContext.h"
+#include "GameRecorder.h"
 #include "ServerFSM.h"
 
 #include <set>
@@ -73,7 +76,7 @@ public:
     //@}
 
     /** \name Accessors */ //@{
-    int                 CurrentTurn() const {return m_current_turn;}   ///< returns current turn of the server
+    int                 CurrentTurn() const {return m_game.m_current_turn;}   ///< returns current turn of the server
 
     /** Returns the object for the empire that that the player with
       * ID \a player_id is playing */
@@ -84,6 +87,11 @@ public:
 
     /** Returns the player ID for the player controlling the empire with id \a empire_id */
     int                 EmpirePlayerID(int empire_id) const;
+
+    /** Adds estimates of the memory used by the universe, the parsed content,
+      * the most recently processed combats and the buffers of incoming
+      * messages to \a report. */
+    void                GetMemoryReport(MemoryReport& report) const;
     //@}
 
     /** \name Mutators */ //@{
@@ -102,9 +110,21 @@ public:
     void                RemoveEmpireTurn(int empire_id);
 
     /** Adds turn orders for the given empire for the current turn. order_set
-      * will be freed when all processing is done for the turn */
+      * will be freed when all processing is done for the turn.  Any orders
+      * the empire's client streamed earlier in the turn are discarded. */
     void                SetEmpireTurnOrders(int empire_id, OrderSet* order_set);
 
+    /** Adds \a orders, which should already have been validated, to the
+      * orders streamed by the given empire's client during the current turn,
+      * and removes the streamed orders with ids in \a rescinded_order_ids. */
+    void                UpdateEmpirePendingTurnOrders(int empire_id, const OrderSet& orders,
+                                                      const std::set<int>& rescinded_order_ids);
+
+    /** Makes the orders streamed by the given empire's client during the
+      * current turn its turn orders, as with SetEmpireTurnOrders(), and
+      * returns them. */
+    const OrderSet&     SubmitEmpirePendingTurnOrders(int empire_id);
+
     /** Sets all empire turn orders to an empty set. */
     void                ClearEmpireTurnOrders();
 
@@ -114,6 +134,11 @@ public:
       * orders for the given turn */
     bool                AllOrdersReceived();
 
+    /** Prepares data used in turn processing that doesn't depend on players'
+      * orders, while the server waits for them.  Data that later becomes
+      * out of date is discarded where it is changed. */
+    void                PrecomputeTurnProcessing();
+
     /** Executes player orders, does colonization, does ordered scrapping, does
       * fleet movements, and updates visibility before combats are handled. */
     void                PreCombatProcessTurns();
@@ -169,8 +194,8 @@ public:
     //@}
 
     static ServerApp*           GetApp();         ///< returns a ClientApp pointer to the singleton instance of the app
-    static Universe&            GetUniverse();    ///< returns server's copy of Universe
-    static EmpireManager&       Empires();        ///< returns the server's copy of the Empires
+    static Universe&            GetUniverse();    ///< returns the Universe of the game active on the calling thread; see GameContext
+    static EmpireManager&       Empires();        ///< returns the Empires of the game active on the calling thread; see GameContext
     static CombatData*          CurrentCombat();  ///< returns the server's currently executing Combat; may be 0
     static ServerNetworking&    Networking();     ///< returns the networking object for the server
 
@@ -199,12 +224,23 @@ private:
                                      const std::map<int, int>& player_id_to_save_game_data_index,
                                      boost::shared_ptr<ServerSaveGameData> server_save_game_data);
 
+    /** Determines each empire's supply ranges and the systems it can supply,
+      * the groups of systems within which it can share resources and the
+      * resources available to each, and self-allocates food on unowned
+      * planets so that natives don't starve. */
+    void                UpdateEmpireSupplyAndResourcePools();
+
     void                CleanupAIs();   ///< cleans up AI processes: kills the process and empties the container of AI processes
 
     /** Handles an incoming message from the server with the appropriate action
       * or response */
     void                HandleMessage(Message msg, PlayerConnectionPtr player_connection);
 
+    /** Handles a DEBUG message from a player.  Text "memory-report" logs a
+      * MemoryReport of the game and sends it back to the player as chat;
+      * other text is ignored. */
+    void                HandleDebugCommand(const Message& msg, PlayerConnectionPtr player_connection);
+
     /** When Messages arrive from connections that are not established players,
       * they arrive via a call to this function*/
     void                HandleNonPlayerMessage(Message msg, PlayerConnectionPtr player_connection);
@@ -217,16 +253,16 @@ private:
 
     boost::asio::io_service         m_io_service;
 
-    Universe                        m_universe;
-    EmpireManager                   m_empires;
+    GameContext                     m_game;                 ///< the universe, empires and current turn of the game being played
     CombatData*                     m_current_combat;
     ServerNetworking                m_networking;
 
     ServerFSM*                      m_fsm;
 
+    GameRecorder                    m_recorder;             ///< records the turns of the game, if the record-game option is set
+
     std::map<int, int>              m_player_empire_ids;    ///< map from player id to empire id that the player controls.
 
-    int                             m_current_turn;         ///< current turn number
 
     std::vector<Process>            m_ai_client_processes;  ///< AI client child processes
 
@@ -237,11 +273,18 @@ private:
       * that turn. */
     std::map<int, OrderSet*>        m_turn_sequence;
 
+    /** Orders streamed by each empire's client during the current turn, which
+      * have been validated on arrival and become the empire's entry in
+      * m_turn_sequence when the client finishes its turn. */
+    std::map<int, OrderSet*>        m_pending_turn_orders;
+
     std::map<int, CombatOrderSet*>  m_combat_turn_sequence;
 
     std::map<int, std::set<std::string> >   m_victors;              ///< for each player id, the victory types that player has achived
     std::set<int>                           m_eliminated_players;   ///< ids of players whose connections have been severed by the server after they were eliminated
 
+    MemoryReport::Entry             m_last_combat_memory;   ///< memory used by the CombatInfos of the most recently processed combats, which are discarded after each turn's combats
+
     static ServerApp*               s_app;
 
     // Give FSM and its states direct access.  We are using the FSM code as a
@@ -257,6 +300,9 @@ private:
     friend struct WaitingForSaveData;
     friend struct ProcessingTurn;
     friend struct ResolvingCombat;
+
+    // the replay tool drives turn processing directly
+    friend class GameReplayer;
 };
 
 // template implementations
@@ -14,6 +14,7 @@
 
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/fstream.hpp>
+#include <boost/bind.hpp>
 
 namespace {
     const bool TRACE_EXECUTION = true;
@@ -386,7 +387,8 @@ sc::result MPLobby::react(const JoinGame& msg)
 
     std::string player_name;
     Networking::ClientType client_type;
-    ExtractMessageData(message, player_name, client_type);
+    bool accepts_compressed_messages = false;
+    ExtractMessageData(message, player_name, client_type, accepts_compressed_messages);
     // TODO: check if player name is unique.  If not, modify it slightly to be unique.
 
     // assign unique player ID to newly connected player
@@ -394,6 +396,7 @@ sc::result MPLobby::react(const JoinGame& msg)
 
     // establish player with requested client type and acknowldge via connection
     player_connection->EstablishPlayer(player_id, player_name, client_type);
+    player_connection->SetAcceptsCompressedMessages(accepts_compressed_messages);
     player_connection->SendMessage(JoinAckMessage(player_id));
 
     // inform player of host
@@ -860,7 +863,8 @@ sc::result WaitingForSPGameJoiners::react(const JoinGame& msg)
 
     std::string player_name("Default_Player_Name_in_WaitingForSPGameJoiners::react(const JoinGame& msg)");
     Networking::ClientType client_type(Networking::INVALID_CLIENT_TYPE);
-    ExtractMessageData(message, player_name, client_type);
+    bool accepts_compressed_messages = false;
+    ExtractMessageData(message, player_name, client_type, accepts_compressed_messages);
 
     int player_id = server.m_networking.NewPlayerID();
 
@@ -875,6 +879,7 @@ sc::result WaitingForSPGameJoiners::react(const JoinGame& msg)
             // expected player
             // let the networking system know what socket this player is on
             player_connection->EstablishPlayer(player_id, player_name, client_type);
+            player_connection->SetAcceptsCompressedMessages(accepts_compressed_messages);
             player_connection->SendMessage(JoinAckMessage(player_id));
 
             // remove name from expected names list, so as to only allow one connection per AI
@@ -892,6 +897,7 @@ sc::result WaitingForSPGameJoiners::react(const JoinGame& msg)
         } else {
             // expected human player
             player_connection->EstablishPlayer(player_id, player_name, client_type);
+            player_connection->SetAcceptsCompressedMessages(accepts_compressed_messages);
             player_connection->SendMessage(JoinAckMessage(player_id));
         }
     } else {
@@ -990,7 +996,8 @@ sc::result WaitingForMPGameJoiners::react(const JoinGame& msg)
 
     std::string player_name("Default_Player_Name_in_WaitingForMPGameJoiners::react(const JoinGame& msg)");
     Networking::ClientType client_type(Networking::INVALID_CLIENT_TYPE);
-    ExtractMessageData(message, player_name, client_type);
+    bool accepts_compressed_messages = false;
+    ExtractMessageData(message, player_name, client_type, accepts_compressed_messages);
 
     int player_id = server.m_networking.NewPlayerID();
 
@@ -1005,6 +1012,7 @@ sc::result WaitingForMPGameJoiners::react(const JoinGame& msg)
             // expected player
             // let the networking system know what socket this player is on
             player_connection->EstablishPlayer(player_id, player_name, client_type);
+            player_connection->SetAcceptsCompressedMessages(accepts_compressed_messages);
             player_connection->SendMessage(JoinAckMessage(player_id));
 
             // remove name from expected names list, so as to only allow one connection per AI
@@ -1021,6 +1029,7 @@ sc::result WaitingForMPGameJoiners::react(const JoinGame& msg)
         } else {
             // expected human player
             player_connection->EstablishPlayer(player_id, player_name, client_type);
+            player_connection->SetAcceptsCompressedMessages(accepts_compressed_messages);
             player_connection->SendMessage(JoinAckMessage(player_id));
         }
     } else {
@@ -1084,6 +1093,12 @@ WaitingForTurnEnd::WaitingForTurnEnd(my_context c) :
     my_base(c)
 {
     if (TRACE_EXECUTION) Logger().debugStream() << "(ServerFSM) WaitingForTurnEnd";
+
+    // prepare for turn processing while players play their turns.  posting
+    // this lets already-queued network operations, such as sending the turn
+    // updates, go ahead first.
+    ServerApp& server = Server();
+    server.m_io_service.post(boost::bind(&ServerApp::PrecomputeTurnProcessing, &server));
 }
 
 WaitingForTurnEnd::~WaitingForTurnEnd()
@@ -1106,27 +1121,96 @@ sc::result WaitingForTurnEnd::react(const TurnOrders& msg)
     if (!empire) {
         Logger().errorStream() << "WaitingForTurnEnd::react(TurnOrders&) couldn't get empire for player with id:" << player_id;
         server.m_networking.SendMessage(ErrorMessage(message.SendingPlayer(), "EMPIRE_NOT_FOUND_CANT_HANDLE_ORDERS", false));
+        delete order_set;
+        return discard_event();
+    }
+
+    if (!ValidateOrders(*order_set, empire, message)) {
+        delete order_set;
+        return discard_event();
+    }
+
+    if (TRACE_EXECUTION) Logger().debugStream() << "WaitingForTurnEnd.TurnOrders : Received orders from player " << message.SendingPlayer();
+
+    server.SetEmpireTurnOrders(empire->EmpireID(), order_set);
+
+    HandleTurnOrdersSubmitted(player_id);
+
+    return discard_event();
+}
+
+sc::result WaitingForTurnEnd::react(const TurnPartialOrders& msg)
+{
+    if (TRACE_EXECUTION) Logger().debugStream() << "(ServerFSM) WaitingForTurnEnd.TurnPartialOrders";
+    ServerApp& server = Server();
+    const Message& message = msg.m_message;
+
+    OrderSet issued_orders;
+    std::set<int> rescinded_order_ids;
+    bool turn_complete = false;
+    int num_orders = 0;
+    ExtractMessageData(message, issued_orders, rescinded_order_ids, turn_complete, num_orders);
+
+    int player_id = message.SendingPlayer();
+    Empire* empire = server.GetPlayerEmpire(player_id);
+    if (!empire) {
+        Logger().errorStream() << "WaitingForTurnEnd::react(TurnPartialOrders&) couldn't get empire for player with id:" << player_id;
+        server.m_networking.SendMessage(ErrorMessage(message.SendingPlayer(), "EMPIRE_NOT_FOUND_CANT_HANDLE_ORDERS", false));
         return discard_event();
     }
 
-    for (OrderSet::const_iterator it = order_set->begin(); it != order_set->end(); ++it) {
+    std::map<int, OrderSet*>::const_iterator turn_it = server.m_turn_sequence.find(empire->EmpireID());
+    if (turn_it != server.m_turn_sequence.end() && turn_it->second) {
+        Logger().errorStream() << "WaitingForTurnEnd::react(TurnPartialOrders&) received orders from player " << empire->PlayerName()
+                               << "(id: " << player_id << ") who has already finished their turn.  Orders being ignored.";
+        return discard_event();
+    }
+
+    // validate orders on arrival, so that only orders known to be acceptable are left to process when the turn ends
+    if (!ValidateOrders(issued_orders, empire, message))
+        return discard_event();
+
+    server.UpdateEmpirePendingTurnOrders(empire->EmpireID(), issued_orders, rescinded_order_ids);
+
+    if (!turn_complete)
+        return discard_event();
+
+    if (TRACE_EXECUTION) Logger().debugStream() << "WaitingForTurnEnd.TurnPartialOrders : Player " << player_id << " finished turn";
+
+    const OrderSet& order_set = server.SubmitEmpirePendingTurnOrders(empire->EmpireID());
+    if (static_cast<int>(order_set.size()) != num_orders)
+        Logger().errorStream() << "WaitingForTurnEnd::react(TurnPartialOrders&) player " << empire->PlayerName()
+                               << "(id: " << player_id << ") finished turn with " << num_orders << " orders, but "
+                               << order_set.size() << " were received";
+
+    HandleTurnOrdersSubmitted(player_id);
+
+    return discard_event();
+}
+
+bool WaitingForTurnEnd::ValidateOrders(const OrderSet& orders, const Empire* empire, const Message& message)
+{
+    ServerApp& server = Server();
+    for (OrderSet::const_iterator it = orders.begin(); it != orders.end(); ++it) {
         OrderPtr order = it->second;
         if (!order) {
-            Logger().errorStream() << "WaitingForTurnEnd::react(TurnOrders&) couldn't get order from order set!";
+            Logger().errorStream() << "WaitingForTurnEnd::ValidateOrders couldn't get order from order set!";
             continue;
         }
         if (empire->EmpireID() != order->EmpireID()) {
-            Logger().errorStream() << "WaitingForTurnEnd::react(TurnOrders&) received orders from player " << empire->PlayerName() << "(id: "
+            Logger().errorStream() << "WaitingForTurnEnd::ValidateOrders received orders from player " << empire->PlayerName() << "(id: "
                                    << message.SendingPlayer() << ") who controls empire " << empire->EmpireID()
                                    << " but those orders were for empire " << order->EmpireID() << ".  Orders being ignored.";
             server.m_networking.SendMessage(ErrorMessage(message.SendingPlayer(), "ORDERS_FOR_WRONG_EMPIRE", false));
-            return discard_event();
+            return false;
         }
     }
+    return true;
+}
 
-    if (TRACE_EXECUTION) Logger().debugStream() << "WaitingForTurnEnd.TurnOrders : Received orders from player " << message.SendingPlayer();
-
-    server.SetEmpireTurnOrders(empire->EmpireID(), order_set);
+void WaitingForTurnEnd::HandleTurnOrdersSubmitted(int player_id)
+{
+    ServerApp& server = Server();
 
     // notify other player that this player submitted orders
     for (ServerNetworking::const_established_iterator player_it = server.m_networking.established_begin();
@@ -1134,18 +1218,16 @@ sc::result WaitingForTurnEnd::react(const TurnOrders& msg)
          ++player_it)
     {
         PlayerConnectionPtr player_ctn = *player_it;
-        player_ctn->SendMessage(PlayerStatusMessage(player_ctn->PlayerID(), message.SendingPlayer(), Message::WAITING));
+        player_ctn->SendMessage(PlayerStatusMessage(player_ctn->PlayerID(), player_id, Message::WAITING));
     }
 
     // inform player who just submitted of their new status.  Note: not sure why
     // this only needs to be send to the submitting player and not all others as
     // well ...
-    server.m_networking.SendMessage(TurnProgressMessage(Message::WAITING_FOR_PLAYERS, message.SendingPlayer()));
+    server.m_networking.SendMessage(TurnProgressMessage(Message::WAITING_FOR_PLAYERS, player_id));
 
     // check conditions for ending this turn
     post_event(CheckTurnEndConditions());
-
-    return discard_event();
 }
 
 sc::result WaitingForTurnEnd::react(const RequestObjectID& msg)
@@ -1296,7 +1378,7 @@ sc::result WaitingForSaveData::react(const ClientSaveData& msg)
     // if all players have responded, proceed with save and continue game
     m_players_responded.insert(message.SendingPlayer());
     if (m_players_responded == m_needed_reponses) {
-        ServerSaveGameData server_data(server.m_current_turn, server.m_victors);
+        ServerSaveGameData server_data(server.m_game.m_current_turn, server.m_victors);
 
         // retreive requested save name from Base state, which should have been
         // set in WaitingForTurnEndIdle::react(const SaveGameRequest& msg)
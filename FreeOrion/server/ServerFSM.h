@@ -20,7 +20,9 @@
 #include <vector>
 
 
+class Empire;
 struct MultiplayerLobbyData;
+class OrderSet;
 class ServerApp;
 struct SinglePlayerSetupData;
 class PlayerConnection;
@@ -74,6 +76,7 @@ struct MessageEventBase
         (JoinGame)                              \
         (SaveGameRequest)                       \
         (TurnOrders)                            \
+        (TurnPartialOrders)                     \
         (CombatTurnOrders)                      \
         (ClientSaveData)                        \
         (RequestObjectID)                       \
@@ -271,6 +274,7 @@ struct WaitingForTurnEnd : sc::state<WaitingForTurnEnd, PlayingGame, WaitingForT
 {
     typedef boost::mpl::list<
         sc::custom_reaction<TurnOrders>,
+        sc::custom_reaction<TurnPartialOrders>,
         sc::custom_reaction<RequestObjectID>,
         sc::custom_reaction<RequestDesignID>,
         sc::custom_reaction<CheckTurnEndConditions>
@@ -280,12 +284,23 @@ struct WaitingForTurnEnd : sc::state<WaitingForTurnEnd, PlayingGame, WaitingForT
     ~WaitingForTurnEnd();
 
     sc::result react(const TurnOrders& msg);
+    sc::result react(const TurnPartialOrders& msg);
     sc::result react(const RequestObjectID& msg);
     sc::result react(const RequestDesignID& msg);
     sc::result react(const CheckTurnEndConditions& c);
 
     std::string m_save_filename;
 
+private:
+    /** Returns true iff all of \a orders were issued by \a empire, which is
+      * played by the player who sent \a message.  Otherwise, informs that
+      * player that the orders are being ignored. */
+    bool ValidateOrders(const OrderSet& orders, const Empire* empire, const Message& message);
+
+    /** Informs players that the player with id \a player_id has finished
+      * their turn, and checks whether the turn can now be processed. */
+    void HandleTurnOrdersSubmitted(int player_id);
+
     SERVER_ACCESSOR
 };
 
@@ -315,6 +330,7 @@ struct WaitingForSaveData : sc::state<WaitingForSaveData, WaitingForTurnEnd>
         sc::custom_reaction<ClientSaveData>,
         sc::deferral<SaveGameRequest>,
         sc::deferral<TurnOrders>,
+        sc::deferral<TurnPartialOrders>,
         sc::deferral<PlayerChat>
     > reactions;
 
@@ -341,7 +357,8 @@ struct ProcessingTurn : sc::state<ProcessingTurn, PlayingGame, ProcessingTurnIdl
     typedef boost::mpl::list<
         sc::custom_reaction<ProcessTurn>,
         sc::deferral<SaveGameRequest>,
-        sc::deferral<TurnOrders>
+        sc::deferral<TurnOrders>,
+        sc::deferral<TurnPartialOrders>
     > reactions;
 
     ProcessingTurn(my_context c);
@@ -0,0 +1,191 @@
+#include "ServerApp.h"
+
+#include "GameRecorder.h"
+#include "../parse/Parse.h"
+#include "../universe/Species.h"
+#include "../util/Directories.h"
+#include "../util/OptionsDB.h"
+#include "../util/OrderSet.h"
+#include "../util/Random.h"
+
+#include <boost/timer.hpp>
+
+#include <iomanip>
+#include <iostream>
+
+/* Replay tool: reprocesses the turns of a game recorded by freeoriond with
+   the record-game option, without any clients, and prints how long each phase
+   of each turn's processing took.  Replay starts from the first snapshot in
+   the recording.  When a later snapshot is reached, the replayed gamestate is
+   compared to it, and replay continues from the snapshot, so that a difference
+   in one turn does not affect the timings of the next.  As the tool hosts a
+   ServerApp, it can't be run while freeoriond is running on the same machine. */
+
+/** Drives a ServerApp's turn processing from a recording. */
+class GameReplayer
+{
+public:
+    GameReplayer(ServerApp& server, int first_turn, int last_turn) :
+        m_server(server),
+        m_first_turn(first_turn),
+        m_last_turn(last_turn),
+        m_have_gamestate(false),
+        m_mismatches(0)
+    {}
+
+    /** Replays the turns in \a filename, and returns the number of snapshots
+      * that didn't match the replayed gamestate. */
+    int operator()(const std::string& filename)
+    {
+        GameRecordReader reader(filename);
+        if (!reader.IsOpen())
+            throw std::runtime_error("Unable to open game recording " + filename);
+
+        std::cout << std::setw(6) << "turn" << std::setw(14) << "pre-combat s" << std::setw(12) << "combat s"
+                  << std::setw(14) << "post-combat s" << std::setw(10) << "total s" << std::endl;
+
+        GameRecorder::RecordType type = GameRecorder::INVALID_RECORD;
+        std::string data;
+        while (reader.ReadRecord(type, data)) {
+            if (type == GameRecorder::SNAPSHOT_RECORD) {
+                HandleSnapshot(data);
+            } else if (type == GameRecorder::TURN_RECORD) {
+                if (!HandleTurn(data))
+                    break;
+            } else {
+                Logger().errorStream() << "GameReplayer skipping record of unknown type " << type;
+            }
+        }
+
+        return m_mismatches;
+    }
+
+private:
+    void HandleSnapshot(const std::string& data)
+    {
+        GameContext& game = m_server.m_game;
+
+        // if the previous turn was replayed, check that it produced the
+        // gamestate that was recorded
+        if (m_have_gamestate) {
+            const std::string REPLAYED_DATA = GameRecorder::SerializeSnapshot(ServerSaveGameData(game.m_current_turn, m_server.m_victors),
+                                                                              game.m_universe, game.m_empires, GetSpeciesManager());
+            bool match = REPLAYED_DATA == data;
+            if (!match)
+                ++m_mismatches;
+            std::cout << "snapshot at turn " << game.m_current_turn << (match ? " matches" : " differs from")
+                      << " the replayed gamestate" << std::endl;
+        }
+
+        ServerSaveGameData server_save_game_data;
+        GameRecorder::DeserializeSnapshot(data, server_save_game_data, game.m_universe, game.m_empires, GetSpeciesManager());
+
+        m_server.ClearEmpireTurnOrders();
+        m_server.m_turn_sequence.clear();
+        m_server.m_eliminated_players.clear();
+        game.m_current_turn = server_save_game_data.m_current_turn;
+        m_server.m_victors = server_save_game_data.m_victors;
+
+        // as when loading a game, rebuild the state that isn't serialized
+        game.m_universe.RebuildEmpireViewSystemGraphs();
+        m_server.UpdateEmpireSupplyAndResourcePools();
+
+        m_have_gamestate = true;
+    }
+
+    /** Replays one turn, and returns false if replay should stop. */
+    bool HandleTurn(const std::string& data)
+    {
+        int turn = INVALID_GAME_TURN;
+        std::string generator_state;
+        std::map<int, OrderSet*> turn_orders;
+        GameRecorder::DeserializeTurn(data, turn, generator_state, turn_orders);
+
+        bool past_last_turn = m_last_turn != INVALID_GAME_TURN && m_last_turn < turn;
+        if (past_last_turn || !m_have_gamestate || turn != m_server.m_game.m_current_turn) {
+            if (!past_last_turn && m_have_gamestate)
+                Logger().errorStream() << "GameReplayer found orders for turn " << turn << " when turn "
+                                       << m_server.m_game.m_current_turn << " was expected; skipping to the next snapshot";
+            for (std::map<int, OrderSet*>::iterator it = turn_orders.begin(); it != turn_orders.end(); ++it)
+                delete it->second;
+            return !past_last_turn;
+        }
+
+        m_server.ClearEmpireTurnOrders();
+        m_server.m_turn_sequence.clear();
+        for (std::map<int, OrderSet*>::iterator it = turn_orders.begin(); it != turn_orders.end(); ++it)
+            m_server.SetEmpireTurnOrders(it->first, it->second);
+        SetGeneratorState(generator_state);
+
+        boost::timer timer;
+        m_server.PreCombatProcessTurns();
+        double pre_combat_seconds = timer.elapsed();
+        timer.restart();
+        m_server.ProcessCombats();
+        double combat_seconds = timer.elapsed();
+        timer.restart();
+        m_server.PostCombatProcessTurns();
+        double post_combat_seconds = timer.elapsed();
+
+        if (m_first_turn <= turn) {
+            std::cout << std::setw(6) << turn << std::fixed << std::setprecision(3)
+                      << std::setw(14) << pre_combat_seconds << std::setw(12) << combat_seconds
+                      << std::setw(14) << post_combat_seconds
+                      << std::setw(10) << pre_combat_seconds + combat_seconds + post_combat_seconds << std::endl;
+        }
+        return true;
+    }
+
+    ServerApp&  m_server;
+    int         m_first_turn;
+    int         m_last_turn;
+    bool        m_have_gamestate;
+    int         m_mismatches;
+};
+
+int main(int argc, char* argv[])
+{
+    InitDirs(argv[0]);
+
+    try {
+        GetOptionsDB().AddFlag('h', "help", "Print this help message.");
+        GetOptionsDB().Add<std::string>("replay-file", "Game recording to replay, as written by freeoriond with the record-game option.", "");
+        GetOptionsDB().Add<int>("replay-first-turn", "First turn for which timings are printed.  Earlier turns after the preceding snapshot are replayed, but not reported.", 0);
+        GetOptionsDB().Add<int>("replay-last-turn", "Last turn to replay; -1 replays the whole recording.", -1);
+
+        GetOptionsDB().SetFromCommandLine(argc, argv);
+
+        if (GetOptionsDB().Get<bool>("help") || GetOptionsDB().Get<std::string>("replay-file").empty()) {
+            GetOptionsDB().GetUsage(std::cerr);
+            return 0;
+        }
+
+        parse::init();
+
+        ServerApp g_app;
+
+        int last_turn = GetOptionsDB().Get<int>("replay-last-turn");
+        GameReplayer replayer(g_app, GetOptionsDB().Get<int>("replay-first-turn"),
+                              last_turn < 0 ? INVALID_GAME_TURN : last_turn);
+        return replayer(GetOptionsDB().Get<std::string>("replay-file")) ? 1 : 0;
+
+    } catch (const std::invalid_argument& e) {
+        Logger().errorStream() << "main() caught exception(std::invalid_arg): " << e.what();
+        std::cerr << "main() caught exception(std::invalid_arg): " << e.what() << std::endl;
+        return 1;
+    } catch (const std::runtime_error& e) {
+        Logger().errorStream() << "main() caught exception(std::runtime_error): " << e.what();
+        std::cerr << "main() caught exception(std::runtime_error): " << e.what() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        Logger().errorStream() << "main() caught exception(std::exception): " << e.what();
+        std::cerr << "main() caught exception(std::exception): " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        Logger().errorStream() << "main() caught unknown exception.";
+        std::cerr << "main() caught unknown exception." << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include "Effect.h"
 #include "Condition.h"
 #include "Planet.h"
+#include "MemoryReport.h"
 #include "Predicates.h"
 #include "Universe.h"
 #include "Enums.h"
@@ -85,6 +86,9 @@ void Building::Copy(const UniverseObject* copied_object, int empire_id) {
 const std::string& Building::TypeName() const
 { return UserString("BUILDING"); }
 
+std::size_t Building::MemoryUsage() const
+{ return sizeof(Building) + UniverseObject::AllocatedMemory() + MemoryEstimate::Bytes(m_building_type); }
+
 std::string Building::Dump() const
 {
     std::stringstream os;
@@ -14,7 +14,7 @@ namespace Condition {
 }
 
 /** A Building UniverseObject type. */
-class Building : public UniverseObject
+class Building : public UniverseObject, public PoolAllocated<Building>
 {
 public:
     /** \name Structors */ //@{
@@ -34,6 +34,7 @@ public:
     /** \name Accessors */ //@{
     virtual const std::string&  TypeName() const;   ///< returns user-readable string indicating the type of UniverseObject this is
     virtual std::string         Dump() const;
+    virtual std::size_t         MemoryUsage() const;
 
     /** returns the BuildingType object for this building, specific to the
       * owning empire (or the default version if there is other than exactly
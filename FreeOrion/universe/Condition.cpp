@@ -8,6 +8,7 @@
 #include "Ship.h"
 #include "Planet.h"
 #include "System.h"
+#include "Special.h"
 #include "Species.h"
 #include "Meter.h"
 #include "ValueRef.h"
@@ -693,7 +694,10 @@ namespace {
                     return m_empire_id != ALL_EMPIRES && candidate->OwnedBy(m_empire_id);
                     break;
                 case AFFIL_ENEMY:
-                    return m_empire_id != ALL_EMPIRES && !candidate->Unowned() && !candidate->OwnedBy(m_empire_id);
+                    return m_empire_id != ALL_EMPIRES && !candidate->Unowned() && Empires().AtWar(m_empire_id, candidate->Owner());
+                    break;
+                case AFFIL_ALLY:
+                    return m_empire_id != ALL_EMPIRES && !candidate->Unowned() && Empires().Allied(m_empire_id, candidate->Owner());
                     break;
                 case AFFIL_ANY:
                     return !candidate->Unowned();
@@ -1426,7 +1430,8 @@ namespace {
     struct HasSpecialSimpleMatch
     {
         HasSpecialSimpleMatch(const std::string& name, int low_turn, int high_turn) :
-            m_name(name),
+            m_any_special(name.empty()),
+            m_special_id(FindSpecialID(name)),
             m_low_turn(low_turn),
             m_high_turn(high_turn)
             {}
@@ -1436,19 +1441,19 @@ namespace {
                 if (!candidate)
                     return false;
 
-                if (m_name.empty())
-                    return !candidate->Specials().empty();
+                if (m_any_special)
+                    return !candidate->SpecialIDs().empty();
 
-                std::map<std::string, int>::const_iterator it = candidate->Specials().find(m_name);
-                if (it == candidate->Specials().end())
+                if (!candidate->HasSpecial(m_special_id))
                     return false;
 
-                int special_since_turn = it->second;
+                int special_since_turn = candidate->SpecialAddedOnTurn(m_special_id);
 
                 return m_low_turn <= special_since_turn && special_since_turn <= m_high_turn;
             }
 
-        const std::string& m_name;
+        bool m_any_special;
+        int m_special_id;   // looked up once, so candidates are checked without comparing names
         int m_low_turn;
         int m_high_turn;
     };
@@ -3151,14 +3156,7 @@ namespace {
                     return false;
 
 
-                const std::vector<std::string>& parts = design->Parts();
-                int count = 0;
-                for (std::vector<std::string>::const_iterator it = parts.begin(); it != parts.end(); ++it) {
-                    if (const PartType* part_type = GetPartType(*it)) {
-                        if (part_type->Class() == m_part_class)
-                            ++count;
-                    }
-                }
+                int count = design->PartCount(m_part_class);
                 return (m_low <= count && count <= m_high);
             }
 
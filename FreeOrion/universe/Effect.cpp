@@ -676,16 +676,17 @@ void SetShipPartMeter::Execute(const ScriptingContext& context) const {
 
     // loop through all parts in the ship design, applying effect to each if appropriate
     const std::vector<std::string>& design_parts = ship->Design()->Parts();
+    const std::vector<const PartType*>& design_part_types = ship->Design()->PartTypes();
     for (std::size_t i = 0; i < design_parts.size(); ++i) {
         const std::string& target_part_name = design_parts[i];
         if (target_part_name.empty())
             continue;   // slots in a design may be empty... this isn't an error
 
-        Meter* meter = ship->GetMeter(m_meter, target_part_name);
+        Meter* meter = ship->GetPartMeter(i, m_meter);
         if (!meter)
             continue;   // some parts may not have the requested meter.  this isn't an error
 
-        const PartType* target_part = GetPartType(target_part_name);
+        const PartType* target_part = design_part_types[i];
         if (!target_part) {
             Logger().errorStream() << "SetShipPartMeter::Execute couldn't get part type: " << target_part_name;
             continue;
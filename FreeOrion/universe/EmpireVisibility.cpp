@@ -0,0 +1,112 @@
+#include "EmpireVisibility.h"
+
+#include "MemoryReport.h"
+#include "../util/AppInterface.h"
+
+#include <algorithm>
+
+namespace {
+    bool ValidObjectID(int object_id)
+    { return object_id >= 0; }
+
+    bool ValidTurnVisibility(Visibility vis)
+    { return vis >= VIS_BASIC_VISIBILITY && vis < NUM_VISIBILITIES; }
+}
+
+////////////////////////////////////////////////
+// EmpireVisibility
+////////////////////////////////////////////////
+EmpireVisibility::VisibilityTurnArray::VisibilityTurnArray()
+{
+    for (int i = 0; i < NUM_VISIBILITIES - VIS_BASIC_VISIBILITY; ++i)
+        turns[i] = INVALID_GAME_TURN;
+}
+
+Visibility EmpireVisibility::GetVisibility(int object_id) const
+{
+    if (!ValidObjectID(object_id) || static_cast<std::size_t>(object_id) >= m_visibilities.size())
+        return VIS_NO_VISIBILITY;
+    return static_cast<Visibility>(m_visibilities[object_id]);
+}
+
+int EmpireVisibility::VisibilityTurn(int object_id, Visibility vis) const
+{
+    if (!ValidObjectID(object_id) || !ValidTurnVisibility(vis) ||
+        static_cast<std::size_t>(object_id) >= m_visibility_turns.size())
+    { return INVALID_GAME_TURN; }
+    return m_visibility_turns[object_id].turns[vis - VIS_BASIC_VISIBILITY];
+}
+
+EmpireVisibility::VisibilityTurnMap EmpireVisibility::VisibilityTurns(int object_id) const
+{
+    VisibilityTurnMap retval;
+    for (int vis = VIS_BASIC_VISIBILITY; vis < NUM_VISIBILITIES; ++vis) {
+        int turn = VisibilityTurn(object_id, Visibility(vis));
+        if (turn != INVALID_GAME_TURN)
+            retval[Visibility(vis)] = turn;
+    }
+    return retval;
+}
+
+bool EmpireVisibility::KnowsDestroyed(int object_id) const
+{
+    return ValidObjectID(object_id) && static_cast<std::size_t>(object_id) < m_known_destroyed.size() &&
+           m_known_destroyed[object_id];
+}
+
+std::set<int> EmpireVisibility::KnownDestroyedObjectIDs() const
+{
+    std::set<int> retval;
+    for (std::size_t i = 0; i < m_known_destroyed.size(); ++i)
+        if (m_known_destroyed[i])
+            retval.insert(retval.end(), static_cast<int>(i));
+    return retval;
+}
+
+int EmpireVisibility::Size() const
+{ return static_cast<int>(std::max(m_visibilities.size(), std::max(m_visibility_turns.size(), m_known_destroyed.size()))); }
+
+std::size_t EmpireVisibility::MemoryUsage() const
+{
+    return MemoryEstimate::Bytes(m_visibilities) + MemoryEstimate::Bytes(m_visibility_turns) +
+           (m_known_destroyed.capacity() + 7) / 8;
+}
+
+bool EmpireVisibility::RaiseVisibility(int object_id, Visibility vis)
+{
+    if (!ValidObjectID(object_id) || vis <= VIS_NO_VISIBILITY)
+        return false;
+    if (static_cast<std::size_t>(object_id) >= m_visibilities.size())
+        m_visibilities.resize(object_id + 1, VIS_NO_VISIBILITY);
+    if (m_visibilities[object_id] >= vis)
+        return false;
+    m_visibilities[object_id] = static_cast<unsigned char>(vis);
+    return true;
+}
+
+void EmpireVisibility::SetVisibilityTurns(int object_id, Visibility vis, int turn)
+{
+    for (int level = VIS_BASIC_VISIBILITY; level <= vis && level < NUM_VISIBILITIES; ++level)
+        SetVisibilityTurn(object_id, Visibility(level), turn);
+}
+
+void EmpireVisibility::SetVisibilityTurn(int object_id, Visibility vis, int turn)
+{
+    if (!ValidObjectID(object_id) || !ValidTurnVisibility(vis))
+        return;
+    if (static_cast<std::size_t>(object_id) >= m_visibility_turns.size())
+        m_visibility_turns.resize(object_id + 1);
+    m_visibility_turns[object_id].turns[vis - VIS_BASIC_VISIBILITY] = turn;
+}
+
+void EmpireVisibility::SetKnownDestroyed(int object_id)
+{
+    if (!ValidObjectID(object_id))
+        return;
+    if (static_cast<std::size_t>(object_id) >= m_known_destroyed.size())
+        m_known_destroyed.resize(object_id + 1, false);
+    m_known_destroyed[object_id] = true;
+}
+
+void EmpireVisibility::ClearVisibilities()
+{ m_visibilities.assign(m_visibilities.size(), VIS_NO_VISIBILITY); }
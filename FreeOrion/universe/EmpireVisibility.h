@@ -0,0 +1,87 @@
+// -*- C++ -*-
+#ifndef _EmpireVisibility_h_
+#define _EmpireVisibility_h_
+
+#include "Enums.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+/** What one empire knows about the visibility of objects: its current
+  * Visibility of each object, the most recent turns on which it had each
+  * Visibility level of each object, and which objects it knows have been
+  * destroyed.  Object ids are allocated sequentially by the Universe, so they
+  * are used directly as indices into arrays that grow as needed. Ids past the
+  * end of an array have no visibility, have never been seen and are not known
+  * to be destroyed. */
+class EmpireVisibility
+{
+public:
+    typedef std::map<Visibility, int>   VisibilityTurnMap;  ///< most recent turn number on which an object was observed at various Visibility ratings or better
+
+    /** \name Accessors */ //@{
+    /** Returns the Visibility this empire has of the object with id
+      * \a object_id this turn. */
+    Visibility          GetVisibility(int object_id) const;
+
+    /** Returns the most recent turn on which this empire had Visibility
+      * \a vis or better of the object with id \a object_id, or
+      * INVALID_GAME_TURN if it never has. */
+    int                 VisibilityTurn(int object_id, Visibility vis) const;
+
+    /** Returns the turns on which this empire has had each Visibility level of
+      * the object with id \a object_id, omitting levels it never has had. */
+    VisibilityTurnMap   VisibilityTurns(int object_id) const;
+
+    /** Returns true iff this empire knows the object with id \a object_id has
+      * been destroyed. */
+    bool                KnowsDestroyed(int object_id) const;
+
+    /** Returns the ids of the objects this empire knows have been destroyed. */
+    std::set<int>       KnownDestroyedObjectIDs() const;
+
+    /** Returns the number of object ids for which anything is stored, which is
+      * one more than the largest such id. */
+    int                 Size() const;
+
+    /** Returns the approximate bytes allocated by this EmpireVisibility's
+      * arrays, not counting the EmpireVisibility object itself. */
+    std::size_t         MemoryUsage() const;
+    //@}
+
+    /** \name Mutators */ //@{
+    /** Raises this empire's Visibility of the object with id \a object_id to
+      * \a vis, if it isn't already at least that, and returns true if it was
+      * raised. */
+    bool                RaiseVisibility(int object_id, Visibility vis);
+
+    /** Records that this empire had Visibility \a vis and all lower levels of
+      * the object with id \a object_id on \a turn. */
+    void                SetVisibilityTurns(int object_id, Visibility vis, int turn);
+
+    /** Records that this empire last had Visibility \a vis (only) of the
+      * object with id \a object_id on \a turn. */
+    void                SetVisibilityTurn(int object_id, Visibility vis, int turn);
+
+    void                SetKnownDestroyed(int object_id);
+
+    /** Resets this empire's current Visibility of all objects to
+      * VIS_NO_VISIBILITY, keeping visibility turns and destroyed objects. */
+    void                ClearVisibilities();
+    //@}
+
+private:
+    /** Most recent turns on which an object was seen at each Visibility level
+      * from VIS_BASIC_VISIBILITY up. */
+    struct VisibilityTurnArray {
+        VisibilityTurnArray();
+        int turns[NUM_VISIBILITIES - VIS_BASIC_VISIBILITY];
+    };
+
+    std::vector<unsigned char>          m_visibilities;
+    std::vector<VisibilityTurnArray>    m_visibility_turns;
+    std::vector<bool>                   m_known_destroyed;
+};
+
+#endif // _EmpireVisibility_h_
@@ -337,6 +337,26 @@ namespace GG {
 GG_ENUM_STREAM_IN(EmpireAffiliationType)
 GG_ENUM_STREAM_OUT(EmpireAffiliationType)
 
+/** diplomatic statuses that can exist between a pair of empires */
+enum DiplomaticStatus {
+    INVALID_DIPLOMATIC_STATUS = -1,
+    DIPLO_WAR,          ///< empires' objects fight each other when they meet
+    DIPLO_PEACE,        ///< empires' objects ignore each other
+    DIPLO_ALLIED,       ///< empires are at peace and count as allies for content conditions
+    NUM_DIPLO_STATUSES  ///< keep last, the number of diplomatic statuses
+};
+
+namespace GG {
+    GG_ENUM_MAP_BEGIN(DiplomaticStatus)
+    GG_ENUM_MAP_INSERT(INVALID_DIPLOMATIC_STATUS)
+    GG_ENUM_MAP_INSERT(DIPLO_WAR)
+    GG_ENUM_MAP_INSERT(DIPLO_PEACE)
+    GG_ENUM_MAP_INSERT(DIPLO_ALLIED)
+    GG_ENUM_MAP_END
+}
+GG_ENUM_STREAM_IN(DiplomaticStatus)
+GG_ENUM_STREAM_OUT(DiplomaticStatus)
+
 /** types of items that can be unlocked for empires */
 enum UnlockableItemType {
     INVALID_UNLOCKABLE_ITEM_TYPE = -1,
@@ -2,8 +2,10 @@
 
 #include "Ship.h"
 #include "System.h"
+#include "MemoryReport.h"
 #include "Predicates.h"
 #include "../util/AppInterface.h"
+#include "../util/GameContext.h"
 #include "../util/MultiplayerCommon.h"
 #include "../Empire/Empire.h"
 #include "../Empire/EmpireManager.h"
@@ -15,12 +17,71 @@
 namespace {
     const double MAX_SHIP_SPEED = 500.0;        // max allowed speed of ship movement
     const double FLEET_MOVEMENT_EPSILON = 0.1;  // how close a fleet needs to be to a system to have arrived in the system
+    const std::set<int> EMPTY_SET;              // namespace scope, as MovePath is called from several threads at once
 
     bool SystemHasNoVisibleStarlanes(int system_id, int empire_id) {
         return !GetUniverse().SystemHasVisibleStarlanes(system_id, empire_id);
     }
 }
 
+////////////////////////////////////////////////
+// Fleet::Aggregates
+////////////////////////////////////////////////
+Fleet::Aggregates::Aggregates() :
+    fuel(0.0),
+    max_fuel(0.0),
+    speed(0.0),
+    armed_ships(0),
+    colony_ships(0),
+    troop_ships(0),
+    monsters(0),
+    valid(false)
+{}
+
+
+////////////////////////////////////////////////
+// Fleet::MovementPlan
+////////////////////////////////////////////////
+Fleet::MovementPlan::MovementPlan() :
+    resupply_at_start(false),
+    moves(false),
+    regenerate_fuel(false),
+    explored_systems(),
+    resupplied(false),
+    fuel_consumed(0.0),
+    end_system_id(UniverseObject::INVALID_OBJECT_ID),
+    end_x(0.0),
+    end_y(0.0),
+    prev_system(UniverseObject::INVALID_OBJECT_ID),
+    next_system(UniverseObject::INVALID_OBJECT_ID),
+    route_ends(false),
+    arrived(false),
+    arrival_starlane(UniverseObject::INVALID_OBJECT_ID)
+{}
+
+
+////////////////////////////////////////////////
+// Fleet::MovePathCache
+////////////////////////////////////////////////
+Fleet::MovePathCache::MovePathCache() :
+    path(),
+    eta(Fleet::ETA_UNKNOWN, Fleet::ETA_UNKNOWN),
+    moving_to(UniverseObject::INVALID_OBJECT_ID),
+    prev_system(UniverseObject::INVALID_OBJECT_ID),
+    next_system(UniverseObject::INVALID_OBJECT_ID),
+    system_id(UniverseObject::INVALID_OBJECT_ID),
+    x(0.0),
+    y(0.0),
+    owner(ALL_EMPIRES),
+    supply_version(0),
+    graph_version(0),
+    valid(false)
+{}
+
+
+////////////////////////////////////////////////
+// Fleet
+////////////////////////////////////////////////
 // static(s)
 const int Fleet::ETA_UNKNOWN = (1 << 30);
 const int Fleet::ETA_OUT_OF_RANGE = (1 << 30) - 1;
@@ -34,7 +95,9 @@ Fleet::Fleet(const std::string& name, double x, double y, int owner) :
     m_next_system(INVALID_OBJECT_ID),
     m_travel_distance(0.0),
     m_arrived_this_turn(false),
-    m_arrival_starlane(INVALID_OBJECT_ID)
+    m_arrival_starlane(INVALID_OBJECT_ID),
+    m_aggregates(),
+    m_move_path_cache()
 {
     UniverseObject::Init();
     SetOwner(owner);
@@ -65,8 +128,10 @@ void Fleet::Copy(const UniverseObject* copied_object, int empire_id) {
 
     UniverseObject::Copy(copied_object, vis);
 
+    InvalidateAggregates();
+
     if (vis >= VIS_BASIC_VISIBILITY) {
-        this->m_ships =         copied_fleet->VisibleContainedObjects(empire_id);
+        CopyVisibleIfChanged(this->m_ships, copied_fleet->m_ships, empire_id);
         this->m_next_system =   copied_fleet->m_next_system;
         this->m_prev_system =   copied_fleet->m_prev_system;
 
@@ -75,7 +140,7 @@ void Fleet::Copy(const UniverseObject* copied_object, int empire_id) {
 
             if (vis >= VIS_FULL_VISIBILITY) {
                 this->m_moving_to =             copied_fleet->m_moving_to;
-                this->m_travel_route =          copied_fleet->m_travel_route;
+                CopyIfChanged(this->m_travel_route, copied_fleet->m_travel_route);
                 this->m_travel_distance =       copied_fleet->m_travel_distance;
                 this->m_arrived_this_turn =     copied_fleet->m_arrived_this_turn;
                 this->m_arrival_starlane =      copied_fleet->m_arrival_starlane;
@@ -102,7 +167,7 @@ void Fleet::Copy(const UniverseObject* copied_object, int empire_id) {
                 }
 
                 this->m_moving_to = moving_to;
-                this->m_travel_route = travel_route;
+                CopyIfChanged(this->m_travel_route, travel_route);
                 this->m_travel_distance = travel_distance;
             }
         }
@@ -112,6 +177,13 @@ void Fleet::Copy(const UniverseObject* copied_object, int empire_id) {
 const std::string& Fleet::TypeName() const
 { return UserString("FLEET"); }
 
+std::size_t Fleet::MemoryUsage() const
+{
+    return sizeof(Fleet) + UniverseObject::AllocatedMemory() +
+           MemoryEstimate::Bytes(m_ships) + MemoryEstimate::Bytes(m_travel_route) +
+           MemoryEstimate::Bytes(m_move_path_cache.path);
+}
+
 std::string Fleet::Dump() const {
     std::stringstream os;
     os << UniverseObject::Dump();
@@ -148,10 +220,39 @@ const std::list<int>& Fleet::TravelRoute() const {
     return m_travel_route;
 }
 
-std::list<MovePathNode> Fleet::MovePath() const
-{ return MovePath(TravelRoute()); }
+const std::list<MovePathNode>& Fleet::MovePath() const {
+    int owner = this->Owner();
+    const Empire* empire = Empires().Lookup(owner);
+    int supply_version = empire ? empire->SupplyVersion() : 0;
+    int graph_version = GetUniverse().SystemGraphVersion();
+
+    MovePathCache& cache = m_move_path_cache;
+    if (cache.valid && cache.moving_to == m_moving_to &&
+        cache.prev_system == m_prev_system && cache.next_system == m_next_system &&
+        cache.system_id == SystemID() && cache.x == X() && cache.y == Y() &&
+        cache.owner == owner && cache.supply_version == supply_version &&
+        cache.graph_version == graph_version)
+    { return cache.path; }
+
+    cache.path = MovePath(TravelRoute());
+    cache.eta = ETA(cache.path);
+    cache.moving_to = m_moving_to;
+    cache.prev_system = m_prev_system;
+    cache.next_system = m_next_system;
+    cache.system_id = SystemID();
+    cache.x = X();
+    cache.y = Y();
+    cache.owner = owner;
+    cache.supply_version = supply_version;
+    cache.graph_version = graph_version;
+    cache.valid = InMainObjectMap();    // see GetAggregates()
+    return cache.path;
+}
 
-std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route) const {
+std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route) const
+{ return MovePath(route, Fuel()); }
+
+std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route, double fuel) const {
     std::list<MovePathNode> retval;
 
     if (route.empty())
@@ -165,7 +266,6 @@ std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route) const {
         return retval;                                      // can't move => path is just this system with explanatory ETA
     }
 
-    double fuel =       Fuel();
     double max_fuel =   MaxFuel();
 
     //Logger().debugStream() << "Fleet " << this->Name() << " movePath fuel: " << fuel << " sys id: " << this->SystemID();
@@ -173,12 +273,8 @@ std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route) const {
     // determine all systems where fleet(s) can be resupplied if fuel runs out
     int owner = this->Owner();
     const Empire* empire = Empires().Lookup(owner);
-    std::set<int> fleet_supplied_systems;
-    std::set<int> unobstructed_systems;
-    if (empire) {
-        fleet_supplied_systems = empire->FleetSupplyableSystemIDs();
-        unobstructed_systems = empire->SupplyUnobstructedSystems();
-    }
+    const std::set<int>& fleet_supplied_systems = empire ? empire->FleetSupplyableSystemIDs() : EMPTY_SET;
+    const std::set<int>& unobstructed_systems = empire ? empire->SupplyUnobstructedSystems() : EMPTY_SET;
 
     // determine if, given fuel available and supplyable systems, fleet will ever be able to move
     if (fuel < 1.0 &&
@@ -195,6 +291,7 @@ std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route) const {
 
 
     const ObjectMap& objects = GetMainObjectMap();
+    const ObjectMap& known_objects = static_cast<const Universe&>(GetUniverse()).EmpireKnownObjects(owner);
 
 
     // get iterator pointing to System* on route that is the first after where this fleet is currently.
@@ -339,7 +436,7 @@ std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route) const {
                 break;
 
             // update next system on route and distance to it from current position
-            next_system = GetEmpireKnownObject<System>(*route_it, owner);
+            next_system = known_objects.Object<System>(*route_it);
             if (!next_system) {
                 Logger().errorStream() << "Fleet::MovePath couldn't get system with id " << *route_it;
                 break;
@@ -393,8 +490,10 @@ std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route) const {
     return retval;
 }
 
-std::pair<int, int> Fleet::ETA() const
-{ return ETA(MovePath()); }
+std::pair<int, int> Fleet::ETA() const {
+    MovePath();     // ensures the cached ETA is up to date
+    return m_move_path_cache.eta;
+}
 
 std::pair<int, int> Fleet::ETA(const std::list<MovePathNode>& move_path) const {
     // check that path exists.  if empty, there was no valid route or some other problem prevented pathing
@@ -421,102 +520,23 @@ std::pair<int, int> Fleet::ETA(const std::list<MovePathNode>& move_path) const {
     return std::make_pair(last_stop_eta, first_stop_eta);
 }
 
-double Fleet::Fuel() const {
-    if (NumShips() < 1)
-        return 0.0;
+double Fleet::Fuel() const
+{ return GetAggregates().fuel; }
 
-    // determine fuel available to fleet (fuel of the ship that has the least fuel in the fleet)
-    double fuel = Meter::LARGE_VALUE;
-    bool is_fleet_scrapped = true;
-    for (const_iterator ship_it = begin(); ship_it != end(); ++ship_it) {
-        const Ship* ship = GetObject<Ship>(*ship_it);
-        if (!ship) {
-            Logger().errorStream() << "Fleet::Fuel couldn't get ship with id " << *ship_it;
-            continue;
-        }
-        const Meter* meter = ship->UniverseObject::GetMeter(METER_FUEL);
-        if (!meter) {
-            Logger().errorStream() << "Fleet::Fuel skipping ship with no fuel meter";
-            continue;
-        }
-        if (!ship->OrderedScrapped()) {
-            fuel = std::min(fuel, meter->Current());
-            is_fleet_scrapped = false;
-        } 
-    }
-    if (is_fleet_scrapped) {
-        fuel = 0.0;
-    }
-    return fuel;
-}
+double Fleet::MaxFuel() const
+{ return GetAggregates().max_fuel; }
 
-double Fleet::MaxFuel() const {
-    if (NumShips() < 1)
-        return 0.0;
+bool Fleet::HasMonsters() const
+{ return GetAggregates().monsters > 0; }
 
-    // determine the maximum amount of fuel that can be stored by the ship in the fleet that
-    // can store the least amount of fuel
-    double max_fuel = Meter::LARGE_VALUE;
-    bool is_fleet_scrapped = true;
-    for (const_iterator ship_it = begin(); ship_it != end(); ++ship_it) {
-        const Ship* ship = GetObject<Ship>(*ship_it);
-        if (!ship) {
-            Logger().errorStream() << "Fleet::MaxFuel couldn't get ship with id " << *ship_it;
-            continue;
-        }
-        const Meter* meter = ship->UniverseObject::GetMeter(METER_FUEL);
-        if (!meter) {
-            Logger().errorStream() << "Fleet::MaxFuel skipping ship with no fuel meter";
-            continue;
-        }
-        if (!ship->OrderedScrapped()) {
-            max_fuel = std::min(max_fuel, meter->Current());
-            is_fleet_scrapped = false;
-        }
-    }
-    if (is_fleet_scrapped) {
-        max_fuel = 0.0;
-    }
-    return max_fuel;
-}
+bool Fleet::HasArmedShips() const
+{ return GetAggregates().armed_ships > 0; }
 
-bool Fleet::HasMonsters() const {
-    const ObjectMap& objects = GetMainObjectMap();
-    for (Fleet::const_iterator it = begin(); it != end(); it++) {
-        if (const Ship* ship = objects.Object<Ship>(*it))
-            if (ship->IsMonster())
-                return true;
-    }
-    return false;
-}
+bool Fleet::HasColonyShips() const
+{ return GetAggregates().colony_ships > 0; }
 
-bool Fleet::HasArmedShips() const {
-    const ObjectMap& objects = GetMainObjectMap();
-    for (Fleet::const_iterator it = begin(); it != end(); it++) {
-        if (const Ship* ship = objects.Object<Ship>(*it))
-            if (ship->IsArmed())
-                return true;
-    }
-    return false;
-}
-
-bool Fleet::HasColonyShips() const {
-    const ObjectMap& objects = GetMainObjectMap();
-    for (Fleet::const_iterator it = begin(); it != end(); it++)
-        if (const Ship* ship = objects.Object<Ship>(*it))
-            if (ship->CanColonize())
-                return true;
-    return false;
-}
-
-bool Fleet::HasTroopShips() const {
-    const ObjectMap& objects = GetMainObjectMap();
-    for (Fleet::const_iterator it = begin(); it != end(); it++)
-        if (const Ship* ship = objects.Object<Ship>(*it))
-            if (ship->HasTroops())
-                return true;
-    return false;
-}
+bool Fleet::HasTroopShips() const
+{ return GetAggregates().troop_ships > 0; }
 
 bool Fleet::Contains(int object_id) const
 { return m_ships.find(object_id) != m_ships.end(); }
@@ -615,6 +635,7 @@ void Fleet::SetRoute(const std::list<int>& route) {
         m_next_system = m_prev_system == SystemID() ? (*++it) : (*it);
     }
 
+    InvalidateMovePath();
     StateChangedSignal();
 }
 
@@ -667,6 +688,7 @@ bool Fleet::RemoveShip(int ship) {
 void Fleet::SetSystem(int sys) {
     //Logger().debugStream() << "Fleet::SetSystem(int sys)";
     UniverseObject::SetSystem(sys);
+    InvalidateMovePath();
     ObjectMap& objects = GetMainObjectMap();
     for (iterator it = begin(); it != end(); ++it)
         if (UniverseObject* obj = objects.Object(*it))
@@ -677,6 +699,7 @@ void Fleet::MoveTo(double x, double y) {
     //Logger().debugStream() << "Fleet::MoveTo(double x, double y)";
     // move fleet itself
     UniverseObject::MoveTo(x, y);
+    InvalidateMovePath();
     // move ships in fleet
     ObjectMap& objects = GetMainObjectMap();
     for (iterator it = begin(); it != end(); ++it)
@@ -687,29 +710,37 @@ void Fleet::MoveTo(double x, double y) {
 void Fleet::SetNextAndPreviousSystems(int next, int prev) {
     m_prev_system = prev;
     m_next_system = next;
+    InvalidateMovePath();
 }
 
-void Fleet::MovementPhase() {
-    //Logger().debugStream() << "Fleet::MovementPhase this: " << this->Name() << " id: " << this->ID();
+void Fleet::MovementPhase()
+{ CommitMovement(PlanMovement(GameContext::Current())); }
 
-    m_arrived_this_turn = false;
-    m_arrival_starlane = UniverseObject::INVALID_OBJECT_ID;
+Fleet::MovementPlan Fleet::PlanMovement(const GameContext& context) const {
+    //Logger().debugStream() << "Fleet::PlanMovement this: " << this->Name() << " id: " << this->ID();
+
+    const ObjectMap& objects = context.m_universe.Objects();
+
+    MovementPlan plan;
+    plan.prev_system = m_prev_system;
+    plan.next_system = m_next_system;
 
     int prev_prev_system = m_prev_system;
 
-    Empire* empire = Empires().Lookup(this->Owner());
+    const Empire* empire = context.m_empires.Lookup(this->Owner());
 
     // if owner of fleet can resupply ships at the location of this fleet, then
-    // resupply all ships in this fleet
-    if (empire && empire->FleetOrResourceSupplyableAtSystem(this->SystemID()))
-        for (Fleet::const_iterator ship_it = this->begin(); ship_it != this->end(); ++ship_it)
-            if (Ship* ship = GetObject<Ship>(*ship_it))
-                ship->Resupply();
+    // all ships in this fleet are resupplied before moving, so plan the path
+    // as if they had full fuel
+    plan.resupply_at_start = empire && empire->FleetOrResourceSupplyableAtSystem(this->SystemID());
+    std::list<MovePathNode> resupplied_move_path;
+    if (plan.resupply_at_start)
+        resupplied_move_path = this->MovePath(this->TravelRoute(), this->MaxFuel());
 
 
-    System* current_system = GetObject<System>(SystemID());
-    System* const initial_system = current_system;
-    std::list<MovePathNode> move_path = this->MovePath();
+    const System* const initial_system = objects.Object<System>(SystemID());
+    const System* current_system = initial_system;
+    const std::list<MovePathNode>& move_path = plan.resupply_at_start ? resupplied_move_path : this->MovePath();
     std::list<MovePathNode>::const_iterator it = move_path.begin();
     std::list<MovePathNode>::const_iterator next_it = it;
     if (next_it != move_path.end())
@@ -726,39 +757,32 @@ void Fleet::MovementPhase() {
            )
         {
             // fuel regeneration for ships in stationary fleet
-            if (this->FinalDestinationID() == UniverseObject::INVALID_OBJECT_ID ||
-                this->FinalDestinationID() == this->SystemID())
-            {
-                for (Fleet::const_iterator ship_it = this->begin(); ship_it != this->end(); ++ship_it) {
-                    if (Ship* ship = GetObject<Ship>(*ship_it))
-                        if (Meter* fuel_meter = ship->UniverseObject::GetMeter(METER_FUEL)) {
-                            fuel_meter->AddToCurrent(0.1001);
-                            fuel_meter->BackPropegate();
-                        }
-                }
-            }
-            return;
+            plan.regenerate_fuel = this->FinalDestinationID() == UniverseObject::INVALID_OBJECT_ID ||
+                                   this->FinalDestinationID() == this->SystemID();
+            return plan;
         }
     }
 
 
     // if fleet not moving, nothing more to do.
     if (move_path.empty() || move_path.size() == 1) {
-        //Logger().debugStream() << "Fleet::MovementPhase: Fleet move path is empty or has only one entry.  doing nothing";
-        return;
+        //Logger().debugStream() << "Fleet::PlanMovement: Fleet move path is empty or has only one entry.  doing nothing";
+        return plan;
     }
 
-    //Logger().debugStream() << "Fleet::MovementPhase move path:";
+    //Logger().debugStream() << "Fleet::PlanMovement move path:";
     //for (std::list<MovePathNode>::const_iterator it = move_path.begin(); it != move_path.end(); ++it)
     //    Logger().debugStream() << "... (" << it->x << ", " << it->y << ") at object id: " << it->object_id << " eta: " << it->eta << (it->turn_end ? " (end of turn)" : " (during turn)");
 
 
-    // move fleet in sequence to MovePathNodes it can reach this turn
-    double fuel_consumed = 0.0;
+    // follow MovePathNodes fleet can reach this turn
+    plan.moves = true;
+    plan.end_x = this->X();
+    plan.end_y = this->Y();
     for (it = move_path.begin(); it != move_path.end(); ++it) {
         next_it = it;   ++next_it;
 
-        System* system = GetObject<System>(it->object_id);
+        const System* system = objects.Object<System>(it->object_id);
 
         //Logger().debugStream() << "... node " << (system ? system->Name() : "no system");
 
@@ -770,36 +794,34 @@ void Fleet::MovementPhase() {
         if (system) {
             // node is a system.  explore system for all owners of this fleet
             if (empire)
-                empire->AddExploredSystem(it->object_id);
+                plan.explored_systems.push_back(it->object_id);
 
-            prev_prev_system = m_prev_system;
-            m_prev_system = system->ID();               // passing a system, so update previous system of this fleet
+            prev_prev_system = plan.prev_system;
+            plan.prev_system = system->ID();            // passing a system, so update previous system of this fleet
 
             bool resupply_here = empire ? empire->FleetOrResourceSupplyableAtSystem(system->ID()) : false;
 
             // if this system can provide supplies, reset consumed fuel and refuel ships
             if (resupply_here) {
                 //Logger().debugStream() << " ... node has fuel supply.  consumed fuel for movement reset to 0 and fleet resupplied";
-                fuel_consumed = 0.0;
-                for (Fleet::const_iterator ship_it = this->begin(); ship_it != this->end(); ++ship_it) {
-                    Ship* ship = GetObject<Ship>(*ship_it);
-                    assert(ship);
-                    ship->Resupply();
-                }
+                plan.fuel_consumed = 0.0;
+                plan.resupplied = true;
             }
 
 
             if (node_is_next_stop) {                    // is system the last node reached this turn?
-                system->Insert(this);                       // fleet ends turn at this node.  insert fleet into system
+                plan.end_system_id = system->ID();          // fleet ends turn at this node
+                plan.end_x = system->X();
+                plan.end_y = system->Y();
                 current_system = system;
-                //Logger().debugStream() << "... ... inserted fleet into system";
+                //Logger().debugStream() << "... ... fleet ends turn in system";
                 break;
             } else {
                 // fleet will continue past this system this turn.
-                //Logger().debugStream() << "... ... moved fleet to system (not inserted)";
+                //Logger().debugStream() << "... ... fleet passes system";
                 if (!resupply_here) {
-                    fuel_consumed += 1.0;
-                    //Logger().debugStream() << "... ... consuming 1 unit of fuel to continue moving.  total fuel consumed now: " << fuel_consumed;
+                    plan.fuel_consumed += 1.0;
+                    //Logger().debugStream() << "... ... consuming 1 unit of fuel to continue moving.  total fuel consumed now: " << plan.fuel_consumed;
                 } else {
                     //Logger().debugStream() << "... ... not consuming fuel to depart resupply system";
                 }
@@ -808,45 +830,100 @@ void Fleet::MovementPhase() {
         } else {
             // node is not a system.
             if (node_is_next_stop) {                    // node is not a system, but is it the last node reached this turn?
-                MoveTo(it->x, it->y);                       // fleet ends turn at this node.  move fleet here
-                //Logger().debugStream() << "... ... moved fleet to position";
+                plan.end_x = it->x;                         // fleet ends turn at this node
+                plan.end_y = it->y;
+                //Logger().debugStream() << "... ... fleet ends turn at position";
                 break;
             }
         }
     }
 
 
-    //Logger().debugStream() << "Fleet::MovementPhase rest of move path:";
+    //Logger().debugStream() << "Fleet::PlanMovement rest of move path:";
     //for (std::list<MovePathNode>::const_iterator it2 = it; it2 != move_path.end(); ++it2)
     //    Logger().debugStream() << "... (" << it2->x << ", " << it2->y << ") at object id: " << it2->object_id << " eta: " << it2->eta << (it2->turn_end ? " (end of turn)" : " (during turn)");
 
     // update next system
-    if (m_moving_to != SystemID() && next_it != move_path.end() && it != move_path.end()) {
+    if (m_moving_to != plan.end_system_id && next_it != move_path.end() && it != move_path.end()) {
         // there is another system later on the path to aim for.  find it
         for (; next_it != move_path.end(); ++next_it) {
-            if (GetObject<System>(next_it->object_id)) {
-                //Logger().debugStream() << "___ setting m_next_system to " << next_it->object_id;
-                m_next_system = next_it->object_id;
+            if (objects.Object<System>(next_it->object_id)) {
+                //Logger().debugStream() << "___ setting next system to " << next_it->object_id;
+                plan.next_system = next_it->object_id;
                 break;
             }
         }
 
     } else {
         // no more systems on path
-        m_arrived_this_turn = current_system != initial_system;
-        m_arrival_starlane = prev_prev_system;
-        m_moving_to = m_next_system = m_prev_system = UniverseObject::INVALID_OBJECT_ID;
+        plan.route_ends = true;
+        plan.arrived = current_system != initial_system;
+        plan.arrival_starlane = prev_prev_system;
+        plan.next_system = plan.prev_system = UniverseObject::INVALID_OBJECT_ID;
+    }
+
+    return plan;
+}
+
+void Fleet::CommitMovement(const MovementPlan& plan) {
+    m_arrived_this_turn = false;
+    m_arrival_starlane = UniverseObject::INVALID_OBJECT_ID;
+
+    if (plan.resupply_at_start)
+        for (Fleet::const_iterator ship_it = this->begin(); ship_it != this->end(); ++ship_it)
+            if (Ship* ship = GetObject<Ship>(*ship_it))
+                ship->Resupply();
+
+    if (!plan.moves) {
+        if (plan.regenerate_fuel) {
+            for (Fleet::const_iterator ship_it = this->begin(); ship_it != this->end(); ++ship_it) {
+                if (Ship* ship = GetObject<Ship>(*ship_it))
+                    if (Meter* fuel_meter = ship->UniverseObject::GetMeter(METER_FUEL)) {
+                        fuel_meter->AddToCurrent(0.1001);
+                        fuel_meter->BackPropegate();
+                    }
+            }
+            InvalidateAggregates();
+        }
+        return;
     }
 
+    if (Empire* empire = Empires().Lookup(this->Owner()))
+        for (std::vector<int>::const_iterator it = plan.explored_systems.begin(); it != plan.explored_systems.end(); ++it)
+            empire->AddExploredSystem(*it);
+
+    if (plan.resupplied) {
+        for (Fleet::const_iterator ship_it = this->begin(); ship_it != this->end(); ++ship_it) {
+            Ship* ship = GetObject<Ship>(*ship_it);
+            assert(ship);
+            ship->Resupply();
+        }
+    }
+
+    if (System* system = GetObject<System>(plan.end_system_id))
+        system->Insert(this);                   // fleet ends turn in system.  insert fleet into system
+    else
+        MoveTo(plan.end_x, plan.end_y);         // fleet ends turn in deep space.  move fleet there
+
+    m_prev_system = plan.prev_system;
+    m_next_system = plan.next_system;
+    if (plan.route_ends) {
+        m_arrived_this_turn = plan.arrived;
+        m_arrival_starlane = plan.arrival_starlane;
+        m_moving_to = UniverseObject::INVALID_OBJECT_ID;
+    }
+    InvalidateMovePath();
+
 
     // consume fuel from ships in fleet
-    if (fuel_consumed > 0.0) {
+    if (plan.fuel_consumed > 0.0) {
         for (const_iterator ship_it = begin(); ship_it != end(); ++ship_it)
             if (Ship* ship = GetObject<Ship>(*ship_it))
                 if (Meter* meter = ship->UniverseObject::GetMeter(METER_FUEL)) {
-                    meter->AddToCurrent(-fuel_consumed);
+                    meter->AddToCurrent(-plan.fuel_consumed);
                     meter->BackPropegate();
                 }
+        InvalidateAggregates();
     }
 }
 
@@ -1001,25 +1078,64 @@ void Fleet::CalculateRoute() const {
 }
 
 void Fleet::RecalculateFleetSpeed() {
-    if ((m_ships.empty())) {
-        m_speed = 0.0;
-        return;
-    }
+    InvalidateAggregates();
+    m_speed = GetAggregates().speed;
+}
 
-    bool isFleetScrapped = true;
-    m_speed = MAX_SHIP_SPEED;  // max speed no ship can go faster than
-    for (ShipIDSet::iterator it = m_ships.begin(); it != m_ships.end(); ++it) {
-        if (const Ship* ship = GetObject<Ship>(*it)) {
-            if (!ship->OrderedScrapped()) {
-                if (ship->Speed() < m_speed)
-                    m_speed = ship->Speed();
-                isFleetScrapped = false;
-            }
+bool Fleet::InMainObjectMap() const
+{ return GetMainObjectMap().Object(ID()) == this; }
+
+const Fleet::Aggregates& Fleet::GetAggregates() const {
+    if (m_aggregates.valid)
+        return m_aggregates;
+
+    Aggregates aggregates;
+    aggregates.fuel = Meter::LARGE_VALUE;
+    aggregates.max_fuel = Meter::LARGE_VALUE;
+    aggregates.speed = MAX_SHIP_SPEED;  // max speed no ship can go faster than
+
+    // the least fuel, fuel capacity and speed of the ships that aren't being
+    // scrapped are those of the fleet
+    bool is_fleet_scrapped = true;
+    const ObjectMap& objects = GetMainObjectMap();
+    for (ShipIDSet::const_iterator it = m_ships.begin(); it != m_ships.end(); ++it) {
+        const Ship* ship = objects.Object<Ship>(*it);
+        if (!ship) {
+            Logger().errorStream() << "Fleet::GetAggregates couldn't get ship with id " << *it;
+            continue;
         }
+
+        if (ship->IsMonster())
+            ++aggregates.monsters;
+        if (ship->IsArmed())
+            ++aggregates.armed_ships;
+        if (ship->CanColonize())
+            ++aggregates.colony_ships;
+        if (ship->HasTroops())
+            ++aggregates.troop_ships;
+
+        if (ship->OrderedScrapped())
+            continue;
+        is_fleet_scrapped = false;
+
+        aggregates.speed = std::min(aggregates.speed, ship->Speed());
+        if (const Meter* meter = ship->UniverseObject::GetMeter(METER_FUEL))
+            aggregates.fuel = std::min(aggregates.fuel, meter->Current());
+        if (const Meter* meter = ship->UniverseObject::GetMeter(METER_MAX_FUEL))
+            aggregates.max_fuel = std::min(aggregates.max_fuel, meter->Current());
+    }
+
+    if (is_fleet_scrapped) {
+        aggregates.fuel = 0.0;
+        aggregates.max_fuel = 0.0;
+        aggregates.speed = 0.0;
     }
 
-    if (isFleetScrapped)
-        m_speed = 0.0;
+    // ships changed in the main map only invalidate the aggregates of fleets
+    // in it, so copies of fleets elsewhere recalculate them every time
+    aggregates.valid = InMainObjectMap();
+    m_aggregates = aggregates;
+    return m_aggregates;
 }
 
 void Fleet::ShortenRouteToEndAtSystem(std::list<int>& travel_route, int last_system) {
@@ -4,6 +4,8 @@
 
 #include "UniverseObject.h"
 
+struct GameContext;
+
 ////////////////////////////////////////////////
 // MovePathNode
 ////////////////////////////////////////////////
@@ -21,13 +23,34 @@ struct MovePathNode {
 };
 
 /** encapsulates data for a FreeOrion fleet.  Fleets are basically a group of ships that travel together. */
-class Fleet : public UniverseObject
+class Fleet : public UniverseObject, public PoolAllocated<Fleet>
 {
 public:
     typedef std::set<int>               ShipIDSet;
     typedef ShipIDSet::iterator         iterator;                       ///< an iterator to the ships in the fleet
     typedef ShipIDSet::const_iterator   const_iterator;                 ///< a const iterator to the ships in the fleet
 
+    /** Where a fleet's movement will take it this turn, and what happens to
+      * it on the way, as determined by PlanMovement() and applied by
+      * CommitMovement(). */
+    struct MovementPlan {
+        MovementPlan();
+        bool                resupply_at_start;      ///< true if the fleet starts the turn where its owner can supply it, so its ships are resupplied before moving
+        bool                moves;                  ///< false if the fleet stays where it is this turn
+        bool                regenerate_fuel;        ///< true if the fleet stays where it is and isn't ordered to go anywhere, so its ships regain fuel
+        std::vector<int>    explored_systems;       ///< systems passed through or reached, which the owner explores
+        bool                resupplied;             ///< true if the fleet passes through or reaches a system where its owner can supply it
+        double              fuel_consumed;          ///< fuel used to depart unsupplied systems since the last resupply
+        int                 end_system_id;          ///< system the fleet ends the turn in, or INVALID_OBJECT_ID if it ends the turn in deep space
+        double              end_x;                  ///< position where the fleet ends the turn, if not in a system
+        double              end_y;
+        int                 prev_system;            ///< previous system after moving
+        int                 next_system;            ///< next system after moving, if the fleet hasn't arrived at its destination
+        bool                route_ends;             ///< true if no systems remain on the fleet's route after moving, so it stops
+        bool                arrived;                ///< true if the fleet reaches its final destination this turn
+        int                 arrival_starlane;       ///< starlane the fleet arrived on, if it arrived
+    };
+
     /** \name Structors */ //@{
     Fleet() :
         UniverseObject(),
@@ -37,7 +60,9 @@ public:
         m_next_system(INVALID_OBJECT_ID),
         m_travel_distance(0.0),
         m_arrived_this_turn(false),
-        m_arrival_starlane(INVALID_OBJECT_ID)
+        m_arrival_starlane(INVALID_OBJECT_ID),
+        m_aggregates(),
+        m_move_path_cache()
     {}
     Fleet(const std::string& name, double x, double y, int owner);      ///< general ctor taking name, position and owner id
 
@@ -47,6 +72,7 @@ public:
     /** \name Accessors */ //@{
     virtual const std::string&          TypeName() const;                   ///< returns user-readable string indicating the type of UniverseObject this is
     virtual std::string                 Dump() const;
+    virtual std::size_t                 MemoryUsage() const;
 
     const_iterator                      begin() const       { return m_ships.begin(); } ///< returns the begin const_iterator for the ships in the fleet
     const_iterator                      end() const         { return m_ships.end(); }   ///< returns the end const_iterator for the ships in the fleet
@@ -64,7 +90,11 @@ public:
         specified route.  It is assumed in the calculation that the fleet starts its move path at its actual current
         location, however the fleet's current location will not be on the list, even if it is currently in a system. */
     std::list<MovePathNode>             MovePath(const std::list<int>& route) const;
-    std::list<MovePathNode>             MovePath() const;                   ///< Returns MovePath for fleet's current TravelRoute
+
+    /** Returns MovePath for fleet's current TravelRoute.  The path and its
+      * ETA are cached, and only recalculated after the fleet moves, its
+      * route, speed or fuel changes, or its owner's supply ranges change. */
+    const std::list<MovePathNode>&      MovePath() const;
     std::pair<int, int>                 ETA() const;                                            ///< Returns the number of turns which must elapse before the fleet arrives at its current final destination and the turns to the next system, respectively.
     std::pair<int, int>                 ETA(const std::list<MovePathNode>& move_path) const;    ///< Returns the number of turns which must elapse before the fleet arrives at the final destination and next system in the spepcified \a move_path
     double                              Fuel() const;                       ///< Returns effective amount of fuel this fleet has, which is the least of the amounts of fuel that the ships have
@@ -108,6 +138,20 @@ public:
 
     virtual void            MovementPhase();
 
+    /** Determines where this fleet's movement in the game \a context takes
+      * it this turn, without modifying any object, so different fleets may be
+      * planned concurrently.  \a context must be active on the calling
+      * thread.  If the fleet starts the turn where its owner can supply it,
+      * its path is planned as if its ships had been resupplied. */
+    MovementPlan            PlanMovement(const GameContext& context) const;
+
+    /** Moves this fleet as determined by PlanMovement(), resupplying its
+      * ships, inserting it into or removing it from systems, using or
+      * replenishing its ships' fuel, and marking systems as explored by its
+      * owner.  MovementPhase() is PlanMovement() followed by
+      * CommitMovement(). */
+    void                    CommitMovement(const MovementPlan& plan);
+
     void                    AddShip(int ship_id);                           ///< adds the ship to the fleet
     bool                    RemoveShip(int ship);                           ///< removes the ship from the fleet. Returns false if no ship with ID \a id was found.
 
@@ -119,6 +163,13 @@ public:
     void                    SetNextAndPreviousSystems(int next, int prev);  ///< sets the previous and next systems for this fleet.  Useful after moving a moving fleet to a different location, so that it moves along its new local starlanes
 
     void                    RecalculateFleetSpeed();                        ///< recalculates the speed of the fleet by finding the lowest speed of the ships in the fleet.
+
+    /** Marks the fuel, capability and speed totals over this fleet's ships,
+      * and the cached move path that depends on them, as out of date, so
+      * they are recalculated when next needed.  Called when ships are
+      * added, removed or scrapped, and when a ship's meters or species
+      * change. */
+    void                    InvalidateAggregates()                          { m_aggregates.valid = false; m_move_path_cache.valid = false; }
     //@}
 
     /* returns a name for a fleet based on the specified \a ship_ids */
@@ -136,6 +187,58 @@ private:
 
     ShipIDSet               VisibleContainedObjects(int empire_id) const;   ///< returns the subset of m_ships that is visible to empire with id \a empire_id
 
+    /** Totals over the ships in the fleet, which Fuel(), MaxFuel(), the
+      * Has*() functions and RecalculateFleetSpeed() read instead of looking
+      * up every ship on every call.  Ships that have been ordered scrapped
+      * are excluded from the fuel and speed minimums. */
+    struct Aggregates {
+        Aggregates();
+        double  fuel;           ///< least fuel of any ship
+        double  max_fuel;       ///< least fuel capacity of any ship
+        double  speed;          ///< least speed of any ship
+        int     armed_ships;
+        int     colony_ships;
+        int     troop_ships;
+        int     monsters;
+        bool    valid;
+    };
+
+    /** Returns m_aggregates, after recalculating them if they are out of
+      * date.  They are calculated from the ships in the main object map, and
+      * are only cached for fleets in that map, as changes to those ships only
+      * invalidate the aggregates of the fleets there. */
+    const Aggregates&       GetAggregates() const;
+
+    bool                    InMainObjectMap() const;                        ///< returns true iff this is the fleet with this fleet's id in the main object map
+
+    /** The move path along the fleet's travel route, and its ETA.  The path
+      * depends on the fleet's destination and position, on the owner's view
+      * of the system graph and on where the owner can resupply, so the cache
+      * is only used while those, the owner's Empire::SupplyVersion() and the
+      * Universe::SystemGraphVersion() are the ones it was calculated with.
+      * This avoids recalculating the route to check whether it changed. */
+    struct MovePathCache {
+        MovePathCache();
+        std::list<MovePathNode> path;
+        std::pair<int, int>     eta;
+        int                     moving_to;
+        int                     prev_system;
+        int                     next_system;
+        int                     system_id;
+        double                  x;
+        double                  y;
+        int                     owner;
+        int                     supply_version;
+        int                     graph_version;
+        bool                    valid;
+    };
+
+    void                    InvalidateMovePath() const                      { m_move_path_cache.valid = false; }
+
+    /** Returns MovePath(route) for this fleet if it starts with \a fuel
+      * instead of Fuel(). */
+    std::list<MovePathNode> MovePath(const std::list<int>& route, double fuel) const;
+
     ShipIDSet                   m_ships;
     int                         m_moving_to;
 
@@ -158,6 +261,9 @@ private:
     bool                        m_arrived_this_turn;
     int                         m_arrival_starlane;
 
+    mutable Aggregates          m_aggregates;                               ///< not serialized; recalculated on demand
+    mutable MovePathCache       m_move_path_cache;                          ///< not serialized; recalculated on demand
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -0,0 +1,105 @@
+#include "MemoryReport.h"
+
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    /** Returns \a bytes in whole kilobytes or megabytes, whichever is more
+      * readable. */
+    std::string FormatBytes(std::size_t bytes)
+    {
+        std::ostringstream os;
+        if (bytes < 10 * 1024 * 1024)
+            os << (bytes + 512) / 1024 << " KB";
+        else
+            os << (bytes + 512 * 1024) / (1024 * 1024) << " MB";
+        return os.str();
+    }
+}
+
+////////////////////////////////////////////////
+// MemoryReport::Entry
+////////////////////////////////////////////////
+MemoryReport::Entry::Entry() :
+    subsystem(),
+    items(0),
+    bytes(0)
+{}
+
+MemoryReport::Entry::Entry(const std::string& subsystem_, std::size_t items_, std::size_t bytes_) :
+    subsystem(subsystem_),
+    items(items_),
+    bytes(bytes_)
+{}
+
+
+////////////////////////////////////////////////
+// MemoryReport
+////////////////////////////////////////////////
+const MemoryReport::Entry* MemoryReport::Find(const std::string& subsystem) const
+{
+    for (std::vector<Entry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        if (it->subsystem == subsystem)
+            return &*it;
+    return 0;
+}
+
+std::size_t MemoryReport::TotalBytes() const
+{
+    std::size_t retval = 0;
+    for (std::vector<Entry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        retval += it->bytes;
+    return retval;
+}
+
+std::string MemoryReport::Summary() const
+{
+    std::ostringstream os;
+    os << "total " << FormatBytes(TotalBytes());
+    for (std::vector<Entry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        os << "; " << it->subsystem << " " << FormatBytes(it->bytes);
+    return os.str();
+}
+
+std::string MemoryReport::Dump() const
+{
+    std::ostringstream os;
+    os << std::left << std::setw(24) << "subsystem" << std::right << std::setw(12) << "items"
+       << std::setw(14) << "bytes" << "\n";
+    for (std::vector<Entry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        os << std::left << std::setw(24) << it->subsystem << std::right << std::setw(12) << it->items
+           << std::setw(14) << it->bytes << "\n";
+    os << std::left << std::setw(24) << "total" << std::right << std::setw(12) << ""
+       << std::setw(14) << TotalBytes() << "\n";
+    return os.str();
+}
+
+void MemoryReport::Add(const std::string& subsystem, std::size_t items, std::size_t bytes)
+{
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->subsystem == subsystem) {
+            it->items += items;
+            it->bytes += bytes;
+            return;
+        }
+    }
+    m_entries.push_back(Entry(subsystem, items, bytes));
+}
+
+
+////////////////////////////////////////////////
+// MemoryEstimate
+////////////////////////////////////////////////
+namespace MemoryEstimate {
+    const std::size_t TREE_NODE_OVERHEAD = 4 * sizeof(void*);
+    const std::size_t LIST_NODE_OVERHEAD = 2 * sizeof(void*);
+
+    std::size_t Bytes(const std::string& s)
+    {
+        // strings short enough to fit in the string object itself don't
+        // allocate with most standard libraries
+        if (s.capacity() < sizeof(std::string))
+            return 0;
+        return s.capacity() + 1;
+    }
+}
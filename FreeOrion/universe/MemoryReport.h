@@ -0,0 +1,100 @@
+// -*- C++ -*-
+#ifndef _MemoryReport_h_
+#define _MemoryReport_h_
+
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+/** Estimates of the memory used by each of several subsystems of a game, such
+  * as the objects in the universe, each empire's latest known objects or the
+  * effects accounting.  Estimates are made by walking the data and adding up
+  * the sizes of objects and of the nodes and buffers of the standard
+  * containers holding them, not by instrumenting allocators, so they don't
+  * include allocator overhead, and are meant for comparing subsystems and
+  * following their growth over a game rather than as exact totals. */
+class MemoryReport
+{
+public:
+    /** Estimated memory used by one subsystem. */
+    struct Entry {
+        Entry();
+        Entry(const std::string& subsystem_, std::size_t items_, std::size_t bytes_);
+        std::string subsystem;  ///< name of subsystem, eg. "objects"
+        std::size_t items;      ///< number of things, such as objects, the subsystem holds
+        std::size_t bytes;      ///< estimated bytes used by the subsystem
+    };
+
+    /** \name Accessors */ //@{
+    const std::vector<Entry>&   Entries() const { return m_entries; }
+
+    /** Returns the entry for \a subsystem, or 0 if there is none. */
+    const Entry*                Find(const std::string& subsystem) const;
+
+    std::size_t                 TotalBytes() const;
+
+    /** Returns the estimates on one line, suitable for periodic logging. */
+    std::string                 Summary() const;
+
+    /** Returns the estimates as a table, one subsystem per line. */
+    std::string                 Dump() const;
+    //@}
+
+    /** \name Mutators */ //@{
+    /** Adds \a items and \a bytes to the entry for \a subsystem, creating it
+      * if necessary. */
+    void                        Add(const std::string& subsystem, std::size_t items, std::size_t bytes);
+    //@}
+
+private:
+    std::vector<Entry>  m_entries;
+};
+
+/** Functions estimating the memory allocated by standard containers, for use
+  * by the MemoryUsage functions of classes whose memory is reported. */
+namespace MemoryEstimate {
+    /** Bytes used by each node of a std::map, std::set or std::list, besides
+      * the element it holds: the links to other nodes, and the colour of a
+      * tree node. */
+    extern const std::size_t TREE_NODE_OVERHEAD;
+    extern const std::size_t LIST_NODE_OVERHEAD;
+
+    /** Returns the bytes allocated by \a s, not counting the string object
+      * itself; short strings may be stored without any allocation. */
+    std::size_t Bytes(const std::string& s);
+
+    template <class T, class A>
+    std::size_t Bytes(const std::vector<T, A>& v)
+    { return v.capacity() * sizeof(T); }
+
+    template <class T, class A>
+    std::size_t Bytes(const std::list<T, A>& l)
+    { return l.size() * (sizeof(T) + LIST_NODE_OVERHEAD); }
+
+    template <class T, class C, class A>
+    std::size_t Bytes(const std::set<T, C, A>& s)
+    { return s.size() * (sizeof(T) + TREE_NODE_OVERHEAD); }
+
+    template <class K, class V, class C, class A>
+    std::size_t Bytes(const std::map<K, V, C, A>& m)
+    { return m.size() * (sizeof(typename std::map<K, V, C, A>::value_type) + TREE_NODE_OVERHEAD); }
+
+    template <class K, class V, class C, class A>
+    std::size_t Bytes(const std::multimap<K, V, C, A>& m)
+    { return m.size() * (sizeof(typename std::multimap<K, V, C, A>::value_type) + TREE_NODE_OVERHEAD); }
+
+    /** Returns the bytes allocated by a map of string keys \a m, including
+      * the keys' own allocations. */
+    template <class V, class C, class A>
+    std::size_t BytesWithKeys(const std::map<std::string, V, C, A>& m)
+    {
+        std::size_t retval = Bytes(m);
+        for (typename std::map<std::string, V, C, A>::const_iterator it = m.begin(); it != m.end(); ++it)
+            retval += Bytes(it->first);
+        return retval;
+    }
+}
+
+#endif // _MemoryReport_h_
@@ -4,6 +4,7 @@
 
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/version.hpp>
 #include <string>
 
 /** A Meter is a value with an associated maximum value.  A typical example is the population meter.  The max represents the max 
@@ -54,8 +55,46 @@ private:
 template <class Archive>
 void Meter::serialize(Archive& ar, const unsigned int version)
 {
-    ar  & BOOST_SERIALIZATION_NVP(m_current_value)
-        & BOOST_SERIALIZATION_NVP(m_initial_value);
+    if (version < 1) {
+        ar  & BOOST_SERIALIZATION_NVP(m_current_value)
+            & BOOST_SERIALIZATION_NVP(m_initial_value);
+        return;
+    }
+
+    // Most meters are zero, or hold values that are exactly representable as
+    // floats, so those are stored in less space.  Other values are stored
+    // in full, so that packing never changes a meter.
+    enum { PACKED_ZERO = 0, PACKED_FLOAT = 1, PACKED_DOUBLE = 2 };
+
+    unsigned char packing = PACKED_DOUBLE;
+    float current_float = 0.0f;
+    float initial_float = 0.0f;
+    if (Archive::is_saving::value) {
+        current_float = static_cast<float>(m_current_value);
+        initial_float = static_cast<float>(m_initial_value);
+        if (m_current_value == 0.0 && m_initial_value == 0.0)
+            packing = PACKED_ZERO;
+        else if (static_cast<double>(current_float) == m_current_value &&
+                 static_cast<double>(initial_float) == m_initial_value)
+            packing = PACKED_FLOAT;
+    }
+
+    ar  & BOOST_SERIALIZATION_NVP(packing);
+
+    if (packing == PACKED_ZERO) {
+        m_current_value = 0.0;
+        m_initial_value = 0.0;
+    } else if (packing == PACKED_FLOAT) {
+        ar  & BOOST_SERIALIZATION_NVP(current_float)
+            & BOOST_SERIALIZATION_NVP(initial_float);
+        m_current_value = current_float;
+        m_initial_value = initial_float;
+    } else {
+        ar  & BOOST_SERIALIZATION_NVP(m_current_value)
+            & BOOST_SERIALIZATION_NVP(m_initial_value);
+    }
 }
 
+BOOST_CLASS_VERSION(Meter, 1)
+
 #endif // _Meter_h_
@@ -2,9 +2,34 @@
 
 #include "Universe.h"
 #include "UniverseObject.h"
+#include "Building.h"
+#include "Fleet.h"
+#include "Planet.h"
+#include "Ship.h"
+#include "System.h"
+#include "Predicates.h"
 #include "Enums.h"
+#include "MemoryReport.h"
 #include "../util/AppInterface.h"
 
+#include <algorithm>
+
+namespace {
+    UniverseObjectType ObjectTypeOf(const UniverseObject* obj) {
+        if (universe_object_cast<const Ship*>(obj))
+            return OBJ_SHIP;
+        else if (universe_object_cast<const Fleet*>(obj))
+            return OBJ_FLEET;
+        else if (universe_object_cast<const Planet*>(obj))
+            return OBJ_PLANET;
+        else if (universe_object_cast<const Building*>(obj))
+            return OBJ_BUILDING;
+        else if (universe_object_cast<const System*>(obj))
+            return OBJ_SYSTEM;
+        return INVALID_UNIVERSE_OBJECT_TYPE;
+    }
+}
+
 /////////////////////////////////////////////
 // class ObjectMap
 /////////////////////////////////////////////
@@ -39,12 +64,37 @@ void ObjectMap::Copy(const UniverseObject* obj, int empire_id/* = ALL_EMPIRES*/)
     if (GetUniverse().GetObjectVisibilityByEmpire(object_id, empire_id) <= VIS_NO_VISIBILITY)
         return;
 
+    // copying a ship may change the aggregates of the fleets it was and now
+    // is in, which are cached for fleets in the main object map
+    int old_fleet_id = UniverseObject::INVALID_OBJECT_ID;
+
     if (UniverseObject* copy_to_object = this->Object(object_id)) {
+        if (const Ship* ship = universe_object_cast<const Ship*>(copy_to_object))
+            old_fleet_id = ship->FleetID();
+        int old_owner = copy_to_object->Owner();
+        // copying an empty SpecialList doesn't allocate, so this is cheap for
+        // the many objects without specials
+        UniverseObject::SpecialList old_specials(copy_to_object->SpecialIDs());
         copy_to_object->Copy(obj, empire_id);           // there already is a version of this object present in this ObjectMap, so just update it
+        if (copy_to_object->Owner() != old_owner)
+            ObjectOwnerChanged(copy_to_object, old_owner);
+        if (copy_to_object->SpecialIDs() != old_specials) {
+            for (UniverseObject::SpecialList::const_iterator it = old_specials.begin(); it != old_specials.end(); ++it)
+                ObjectSpecialRemoved(copy_to_object, it->first);
+            AddToSpecialIndex(copy_to_object);
+        }
     } else {
         UniverseObject* clone = obj->Clone(empire_id);  // this object is not yet present in this ObjectMap, so add a new UniverseObject object for it
         this->Insert(object_id, clone);
     }
+
+    if (const Ship* ship = this->Object<Ship>(object_id)) {
+        if (Fleet* fleet = this->Object<Fleet>(old_fleet_id))
+            fleet->InvalidateAggregates();
+        if (ship->FleetID() != old_fleet_id)
+            if (Fleet* fleet = this->Object<Fleet>(ship->FleetID()))
+                fleet->InvalidateAggregates();
+    }
 }
 
 void ObjectMap::CompleteCopyVisible(const ObjectMap& copied_map, int empire_id/* = ALL_EMPIRES*/)
@@ -82,6 +132,63 @@ int ObjectMap::NumObjects() const
 bool ObjectMap::Empty() const
 { return m_objects.empty(); }
 
+int ObjectMap::NumOwnedObjects(int empire_id, UniverseObjectType type) const
+{ return static_cast<int>(OwnedObjectIDs(empire_id, type).size()); }
+
+int ObjectMap::NumOwnedObjects(int empire_id) const
+{
+    std::map<int, std::vector<std::set<int> > >::const_iterator it = m_owned_object_ids.find(empire_id);
+    if (it == m_owned_object_ids.end())
+        return 0;
+    int retval = 0;
+    for (std::vector<std::set<int> >::const_iterator type_it = it->second.begin(); type_it != it->second.end(); ++type_it)
+        retval += static_cast<int>(type_it->size());
+    return retval;
+}
+
+const std::set<int>& ObjectMap::OwnedObjectIDs(int empire_id, UniverseObjectType type) const
+{
+    static const std::set<int> EMPTY_SET;
+    if (type < 0 || type >= NUM_OBJ_TYPES)
+        return EMPTY_SET;
+    std::map<int, std::vector<std::set<int> > >::const_iterator it = m_owned_object_ids.find(empire_id);
+    if (it == m_owned_object_ids.end())
+        return EMPTY_SET;
+    return it->second[type];
+}
+
+const std::set<int>& ObjectMap::SpecialObjectIDs(int special_id) const
+{
+    static const std::set<int> EMPTY_SET;
+    std::map<int, std::set<int> >::const_iterator it = m_special_object_ids.find(special_id);
+    if (it == m_special_object_ids.end())
+        return EMPTY_SET;
+    return it->second;
+}
+
+std::vector<int> ObjectMap::FindObjectIDsWithSpecials() const
+{
+    std::vector<int> retval;
+    for (std::map<int, std::set<int> >::const_iterator it = m_special_object_ids.begin();
+         it != m_special_object_ids.end(); ++it)
+    { retval.insert(retval.end(), it->second.begin(), it->second.end()); }
+    std::sort(retval.begin(), retval.end());
+    retval.erase(std::unique(retval.begin(), retval.end()), retval.end());
+    return retval;
+}
+
+std::vector<int> ObjectMap::FindOwnedObjectIDs(int empire_id) const
+{
+    std::vector<int> retval;
+    std::map<int, std::vector<std::set<int> > >::const_iterator it = m_owned_object_ids.find(empire_id);
+    if (it == m_owned_object_ids.end())
+        return retval;
+    for (std::vector<std::set<int> >::const_iterator type_it = it->second.begin(); type_it != it->second.end(); ++type_it)
+        retval.insert(retval.end(), type_it->begin(), type_it->end());
+    std::sort(retval.begin(), retval.end());
+    return retval;
+}
+
 const UniverseObject* ObjectMap::Object(int id) const
 {
     const_iterator it = m_const_objects.find(id);
@@ -184,6 +291,8 @@ UniverseObject* ObjectMap::Insert(int id, UniverseObject* obj)
         // the new object
         m_objects[id] = obj;
         m_const_objects[id] = obj;
+        AddToOwnerIndex(obj, obj->Owner());
+        AddToSpecialIndex(obj);
         return 0;
     }
 
@@ -193,6 +302,10 @@ UniverseObject* ObjectMap::Insert(int id, UniverseObject* obj)
     // and update maps
     it->second = obj;
     m_const_objects[id] = obj;
+    RemoveFromOwnerIndex(old_obj, old_obj->Owner());
+    AddToOwnerIndex(obj, obj->Owner());
+    RemoveFromSpecialIndex(old_obj);
+    AddToSpecialIndex(obj);
 
     // and return old object for external handling
     return old_obj;
@@ -211,6 +324,8 @@ UniverseObject* ObjectMap::Remove(int id)
     // and erase from pointer maps
     m_objects.erase(it);
     m_const_objects.erase(id);
+    RemoveFromOwnerIndex(retval, retval->Owner());
+    RemoveFromSpecialIndex(retval);
 
     return retval;
 }
@@ -224,12 +339,52 @@ void ObjectMap::Clear()
         delete it->second;
     m_objects.clear();
     m_const_objects.clear();
+    m_owned_object_ids.clear();
+    m_special_object_ids.clear();
 }
 
 void ObjectMap::swap(ObjectMap& rhs)
 {
     m_objects.swap(rhs.m_objects);
     m_const_objects.swap(rhs.m_const_objects);
+    m_owned_object_ids.swap(rhs.m_owned_object_ids);
+    m_special_object_ids.swap(rhs.m_special_object_ids);
+}
+
+void ObjectMap::ObjectOwnerChanged(const UniverseObject* obj, int old_owner)
+{
+    if (!obj)
+        return;
+    std::map<int, const UniverseObject*>::const_iterator it = m_const_objects.find(obj->ID());
+    if (it == m_const_objects.end() || it->second != obj)
+        return;
+    RemoveFromOwnerIndex(obj, old_owner);
+    AddToOwnerIndex(obj, obj->Owner());
+}
+
+void ObjectMap::ObjectSpecialAdded(const UniverseObject* obj, int special_id)
+{
+    if (!obj)
+        return;
+    std::map<int, const UniverseObject*>::const_iterator it = m_const_objects.find(obj->ID());
+    if (it == m_const_objects.end() || it->second != obj)
+        return;
+    m_special_object_ids[special_id].insert(obj->ID());
+}
+
+void ObjectMap::ObjectSpecialRemoved(const UniverseObject* obj, int special_id)
+{
+    if (!obj)
+        return;
+    std::map<int, const UniverseObject*>::const_iterator it = m_const_objects.find(obj->ID());
+    if (it == m_const_objects.end() || it->second != obj)
+        return;
+    std::map<int, std::set<int> >::iterator special_it = m_special_object_ids.find(special_id);
+    if (special_it == m_special_object_ids.end())
+        return;
+    special_it->second.erase(obj->ID());
+    if (special_it->second.empty())
+        m_special_object_ids.erase(special_it);
 }
 
 void ObjectMap::CopyObjectsToConstObjects()
@@ -239,6 +394,84 @@ void ObjectMap::CopyObjectsToConstObjects()
     m_const_objects.insert(m_objects.begin(), m_objects.end());
 }
 
+void ObjectMap::RebuildOwnerIndex()
+{
+    m_owned_object_ids.clear();
+    for (iterator it = m_objects.begin(); it != m_objects.end(); ++it)
+        AddToOwnerIndex(it->second, it->second->Owner());
+}
+
+void ObjectMap::AddToOwnerIndex(const UniverseObject* obj, int owner)
+{
+    if (owner == ALL_EMPIRES)
+        return;
+    UniverseObjectType type = ObjectTypeOf(obj);
+    if (type == INVALID_UNIVERSE_OBJECT_TYPE)
+        return;
+    std::vector<std::set<int> >& owned_ids = m_owned_object_ids[owner];
+    if (owned_ids.empty())
+        owned_ids.resize(NUM_OBJ_TYPES);
+    owned_ids[type].insert(obj->ID());
+}
+
+void ObjectMap::RemoveFromOwnerIndex(const UniverseObject* obj, int owner)
+{
+    if (owner == ALL_EMPIRES)
+        return;
+    UniverseObjectType type = ObjectTypeOf(obj);
+    if (type == INVALID_UNIVERSE_OBJECT_TYPE)
+        return;
+    std::map<int, std::vector<std::set<int> > >::iterator it = m_owned_object_ids.find(owner);
+    if (it == m_owned_object_ids.end() || !it->second[type].erase(obj->ID()))
+        Logger().errorStream() << "ObjectMap::RemoveFromOwnerIndex couldn't find object " << obj->ID() << " in index for empire " << owner;
+}
+
+void ObjectMap::RebuildSpecialIndex()
+{
+    m_special_object_ids.clear();
+    for (iterator it = m_objects.begin(); it != m_objects.end(); ++it)
+        AddToSpecialIndex(it->second);
+}
+
+void ObjectMap::AddToSpecialIndex(const UniverseObject* obj)
+{
+    const UniverseObject::SpecialList& specials = obj->SpecialIDs();
+    for (UniverseObject::SpecialList::const_iterator it = specials.begin(); it != specials.end(); ++it)
+        m_special_object_ids[it->first].insert(obj->ID());
+}
+
+void ObjectMap::RemoveFromSpecialIndex(const UniverseObject* obj)
+{
+    const UniverseObject::SpecialList& specials = obj->SpecialIDs();
+    for (UniverseObject::SpecialList::const_iterator it = specials.begin(); it != specials.end(); ++it) {
+        std::map<int, std::set<int> >::iterator special_it = m_special_object_ids.find(it->first);
+        if (special_it == m_special_object_ids.end())
+            continue;
+        special_it->second.erase(obj->ID());
+        if (special_it->second.empty())
+            m_special_object_ids.erase(special_it);
+    }
+}
+
+std::size_t ObjectMap::MemoryUsage() const
+{
+    std::size_t retval = MemoryEstimate::Bytes(m_objects) + MemoryEstimate::Bytes(m_const_objects) +
+                         MemoryEstimate::Bytes(m_owned_object_ids) + MemoryEstimate::Bytes(m_special_object_ids);
+    for (std::map<int, UniverseObject*>::const_iterator it = m_objects.begin(); it != m_objects.end(); ++it)
+        if (it->second)
+            retval += it->second->MemoryUsage();
+    for (std::map<int, std::set<int> >::const_iterator it = m_special_object_ids.begin(); it != m_special_object_ids.end(); ++it)
+        retval += MemoryEstimate::Bytes(it->second);
+    for (std::map<int, std::vector<std::set<int> > >::const_iterator it = m_owned_object_ids.begin();
+         it != m_owned_object_ids.end(); ++it)
+    {
+        retval += MemoryEstimate::Bytes(it->second);
+        for (std::vector<std::set<int> >::const_iterator type_it = it->second.begin(); type_it != it->second.end(); ++type_it)
+            retval += MemoryEstimate::Bytes(*type_it);
+    }
+    return retval;
+}
+
 std::string ObjectMap::Dump() const
 {
     std::ostringstream os;
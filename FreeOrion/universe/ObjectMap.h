@@ -2,7 +2,10 @@
 #ifndef _Object_Map_h_
 #define _Object_Map_h_
 
+#include "Enums.h"
+
 #include <map>
+#include <set>
 #include <vector>
 #include <string>
 
@@ -10,10 +13,26 @@
 
 class Universe;
 class UniverseObject;
+class Building;
+class Fleet;
+class Planet;
+class Ship;
+class System;
 struct UniverseObjectVisitor;
 
 extern const int ALL_EMPIRES;
 
+/** The UniverseObjectType of UniverseObject subclass \a T, or
+  * INVALID_UNIVERSE_OBJECT_TYPE for classes (such as UniverseObject itself)
+  * that do not correspond to a single object type. */
+template <class T>
+struct UniverseObjectTypeOf { static const UniverseObjectType value = INVALID_UNIVERSE_OBJECT_TYPE; };
+template <> struct UniverseObjectTypeOf<Building>   { static const UniverseObjectType value = OBJ_BUILDING; };
+template <> struct UniverseObjectTypeOf<Fleet>      { static const UniverseObjectType value = OBJ_FLEET; };
+template <> struct UniverseObjectTypeOf<Planet>     { static const UniverseObjectType value = OBJ_PLANET; };
+template <> struct UniverseObjectTypeOf<Ship>       { static const UniverseObjectType value = OBJ_SHIP; };
+template <> struct UniverseObjectTypeOf<System>     { static const UniverseObjectType value = OBJ_SYSTEM; };
+
 /** Contains a set of objects that make up a (known or complete) Universe. */
 class ObjectMap {
 public:
@@ -37,6 +56,52 @@ public:
     /** Returns true if this ObjectMap contains no objects */
     bool                    Empty() const;
 
+    /** Returns the number of objects of type \a type in this ObjectMap that
+      * are owned by the empire with id \a empire_id.  The per-owner index is
+      * maintained as objects are inserted, removed or change owner, so this
+      * is O(1). */
+    int                     NumOwnedObjects(int empire_id, UniverseObjectType type) const;
+
+    /** Returns the number of objects of any type in this ObjectMap that are
+      * owned by the empire with id \a empire_id. */
+    int                     NumOwnedObjects(int empire_id) const;
+
+    /** Returns the IDs of the objects of type \a type in this ObjectMap that
+      * are owned by the empire with id \a empire_id. */
+    const std::set<int>&    OwnedObjectIDs(int empire_id, UniverseObjectType type) const;
+
+    /** Returns the IDs of all objects owned by the empire with id
+      * \a empire_id, in ascending ID order (the same order as iteration over
+      * this ObjectMap). */
+    std::vector<int>        FindOwnedObjectIDs(int empire_id) const;
+
+    /** Returns the IDs of the objects in this ObjectMap that have the special
+      * with id \a special_id (see SpecialID()).  The per-special index is
+      * maintained as objects are inserted or removed and as specials are
+      * added to or removed from them. */
+    const std::set<int>&    SpecialObjectIDs(int special_id) const;
+
+    /** Returns the IDs of the objects in this ObjectMap that have any
+      * specials, in ascending ID order. */
+    std::vector<int>        FindObjectIDsWithSpecials() const;
+
+    /** Returns the IDs of the objects of type T owned by the empire with id
+      * \a empire_id, in ascending ID order. */
+    template <class T>
+    std::vector<int>        FindOwnedObjectIDs(int empire_id) const;
+
+    /** Returns the objects of type T owned by the empire with id
+      * \a empire_id, in ascending ID order.  Equivalent to
+      * FindObjects(OwnedVisitor<T>(empire_id)) but proportional to the size
+      * of the empire's holdings rather than that of the whole map. */
+    template <class T>
+    std::vector<const T*>   FindOwnedObjects(int empire_id) const;
+
+    /** Returns the objects of type T owned by the empire with id
+      * \a empire_id, in ascending ID order. */
+    template <class T>
+    std::vector<T*>         FindOwnedObjects(int empire_id);
+
     /** Returns a pointer to the universe object with ID number \a id, or 0 if
       * none exists */
     const UniverseObject*   Object(int id) const;
@@ -94,6 +159,10 @@ public:
     const_iterator      const_end() const;
 
     std::string         Dump() const;
+
+    /** Returns the approximate bytes used by the objects in this ObjectMap and
+      * by its indices, not counting the ObjectMap itself. */
+    std::size_t         MemoryUsage() const;
     //@}
 
     /** \name Mutators */ //@{
@@ -155,13 +224,31 @@ public:
 
     /** Swaps the contents of *this with \a rhs. */
     void                swap(ObjectMap& rhs);
+
+    /** Updates the per-owner index after the owner of \a obj changed from
+      * \a old_owner.  Does nothing if \a obj is not in this map. */
+    void                ObjectOwnerChanged(const UniverseObject* obj, int old_owner);
+
+    /** Update the per-special index after the special with id \a special_id
+      * was added to or removed from \a obj.  Do nothing if \a obj is not in
+      * this map. */
+    void                ObjectSpecialAdded(const UniverseObject* obj, int special_id);
+    void                ObjectSpecialRemoved(const UniverseObject* obj, int special_id);
     //@}
 
 private:
     void                CopyObjectsToConstObjects();
-
-    std::map<int, UniverseObject*>          m_objects;
-    std::map<int, const UniverseObject*>    m_const_objects;
+    void                RebuildOwnerIndex();
+    void                AddToOwnerIndex(const UniverseObject* obj, int owner);
+    void                RemoveFromOwnerIndex(const UniverseObject* obj, int owner);
+    void                RebuildSpecialIndex();
+    void                AddToSpecialIndex(const UniverseObject* obj);
+    void                RemoveFromSpecialIndex(const UniverseObject* obj);
+
+    std::map<int, UniverseObject*>                  m_objects;
+    std::map<int, const UniverseObject*>            m_const_objects;
+    std::map<int, std::vector<std::set<int> > >     m_owned_object_ids; ///< IDs of objects owned by each empire, indexed by empire id and then UniverseObjectType
+    std::map<int, std::set<int> >                   m_special_object_ids;   ///< IDs of objects that have each special, indexed by special id
 
     friend class Universe;
     friend class boost::serialization::access;
@@ -225,4 +312,46 @@ std::vector<int> ObjectMap::FindObjectIDs() const
     return retval;
 }
 
+template <class T>
+std::vector<int> ObjectMap::FindOwnedObjectIDs(int empire_id) const
+{
+    UniverseObjectType type = UniverseObjectTypeOf<typename boost::remove_const<T>::type>::value;
+    if (type != INVALID_UNIVERSE_OBJECT_TYPE) {
+        const std::set<int>& ids = OwnedObjectIDs(empire_id, type);
+        return std::vector<int>(ids.begin(), ids.end());
+    }
+
+    // not a single concrete object type, so check each owned object
+    std::vector<int> retval;
+    std::vector<int> owned_ids = FindOwnedObjectIDs(empire_id);
+    for (std::vector<int>::const_iterator it = owned_ids.begin(); it != owned_ids.end(); ++it)
+        if (Object<T>(*it))
+            retval.push_back(*it);
+    return retval;
+}
+
+template <class T>
+std::vector<const T*> ObjectMap::FindOwnedObjects(int empire_id) const
+{
+    std::vector<const T*> retval;
+    std::vector<int> ids = FindOwnedObjectIDs<T>(empire_id);
+    retval.reserve(ids.size());
+    for (std::vector<int>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+        if (const T* obj = Object<T>(*it))
+            retval.push_back(obj);
+    return retval;
+}
+
+template <class T>
+std::vector<T*> ObjectMap::FindOwnedObjects(int empire_id)
+{
+    std::vector<T*> retval;
+    std::vector<int> ids = FindOwnedObjectIDs<T>(empire_id);
+    retval.reserve(ids.size());
+    for (std::vector<int>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+        if (T* obj = Object<T>(*it))
+            retval.push_back(obj);
+    return retval;
+}
+
 #endif
@@ -4,6 +4,7 @@
 #include "Fleet.h"
 #include "Ship.h"
 #include "System.h"
+#include "MemoryReport.h"
 #include "Predicates.h"
 #include "Species.h"
 #include "Condition.h"
@@ -130,7 +131,7 @@ void Planet::Copy(const UniverseObject* copied_object, int empire_id) {
     ResourceCenter::Copy(copied_planet, vis);
 
     if (vis >= VIS_BASIC_VISIBILITY) {
-        this->m_buildings =                 copied_planet->VisibleContainedObjects(empire_id);
+        CopyVisibleIfChanged(this->m_buildings, copied_planet->m_buildings, empire_id);
         this->m_type =                      copied_planet->m_type;
         this->m_size =                      copied_planet->m_size;
         this->m_orbital_period =            copied_planet->m_orbital_period;
@@ -160,6 +161,13 @@ void Planet::Copy(const UniverseObject* copied_object, int empire_id) {
 const std::string& Planet::TypeName() const
 { return UserString("PLANET"); }
 
+std::size_t Planet::MemoryUsage() const
+{
+    return sizeof(Planet) + UniverseObject::AllocatedMemory() +
+           MemoryEstimate::Bytes(m_buildings) + MemoryEstimate::Bytes(SpeciesName()) +
+           MemoryEstimate::Bytes(Focus());
+}
+
 std::string Planet::Dump() const {
     std::stringstream os;
     os << UniverseObject::Dump();
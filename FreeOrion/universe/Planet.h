@@ -82,7 +82,8 @@ public:
 class Planet :
     public UniverseObject,
     public PopCenter,
-    public ResourceCenter
+    public ResourceCenter,
+    public PoolAllocated<Planet>
 {
 public:
     /** \name Structors */ //@{
@@ -95,6 +96,7 @@ public:
     /** \name Accessors */ //@{
     virtual const std::string&  TypeName() const;                       ///< returns user-readable string indicating the type of UniverseObject this is
     virtual std::string         Dump() const;
+    virtual std::size_t         MemoryUsage() const;
 
     PlanetType                  Type() const {return m_type;}
     PlanetSize                  Size() const {return m_size;}
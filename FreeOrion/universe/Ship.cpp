@@ -3,6 +3,7 @@
 #include "../util/AppInterface.h"
 #include "../util/MultiplayerCommon.h"
 #include "Fleet.h"
+#include "MemoryReport.h"
 #include "Predicates.h"
 #include "ShipDesign.h"
 #include "Species.h"
@@ -67,34 +68,21 @@ Ship::Ship(int empire_id, int design_id, const std::string& species_name,
     AddMeter(METER_STARLANE_SPEED);
 
     const std::vector<std::string>& part_names = Design()->Parts();
+    const std::vector<const PartType*>& part_types = Design()->PartTypes();
     for (std::size_t i = 0; i < part_names.size(); ++i) {
         if (part_names[i] != "") {
-            const PartType* part = GetPartType(part_names[i]);
+            const PartType* part = part_types[i];
             if (!part) {
                 Logger().errorStream() << "Ship::Ship couldn't get part with name " << part_names[i];
                 continue;
             }
 
             switch (part->Class()) {
-            case PC_SHORT_RANGE:
-            case PC_POINT_DEFENSE: {
-                m_part_meters[std::make_pair(METER_DAMAGE,              part->Name())];
-                m_part_meters[std::make_pair(METER_ROF,                 part->Name())];
-                m_part_meters[std::make_pair(METER_RANGE,               part->Name())];
-                break;
-            }
             case PC_MISSILES: {
                 std::pair<std::size_t, std::size_t>& part_missiles =
                     m_missiles[part_names[i]];
                 ++part_missiles.first;
                 part_missiles.second += boost::get<LRStats>(part->Stats()).m_capacity;
-                m_part_meters[std::make_pair(METER_DAMAGE,              part->Name())];
-                m_part_meters[std::make_pair(METER_ROF,                 part->Name())];
-                m_part_meters[std::make_pair(METER_RANGE,               part->Name())];
-                m_part_meters[std::make_pair(METER_SPEED,               part->Name())];
-                m_part_meters[std::make_pair(METER_STEALTH,             part->Name())];
-                m_part_meters[std::make_pair(METER_STRUCTURE,           part->Name())];
-                m_part_meters[std::make_pair(METER_CAPACITY,            part->Name())];
                 break;
             }
             case PC_FIGHTERS: {
@@ -102,15 +90,6 @@ Ship::Ship(int empire_id, int design_id, const std::string& species_name,
                     m_fighters[part_names[i]];
                 ++part_fighters.first;
                 part_fighters.second += boost::get<FighterStats>(part->Stats()).m_capacity;
-                m_part_meters[std::make_pair(METER_ANTI_SHIP_DAMAGE,    part->Name())];
-                m_part_meters[std::make_pair(METER_ANTI_FIGHTER_DAMAGE, part->Name())];
-                m_part_meters[std::make_pair(METER_LAUNCH_RATE,         part->Name())];
-                m_part_meters[std::make_pair(METER_FIGHTER_WEAPON_RANGE,part->Name())];
-                m_part_meters[std::make_pair(METER_SPEED,               part->Name())];
-                m_part_meters[std::make_pair(METER_STEALTH,             part->Name())];
-                m_part_meters[std::make_pair(METER_STRUCTURE,           part->Name())];
-                m_part_meters[std::make_pair(METER_DETECTION,           part->Name())];
-                m_part_meters[std::make_pair(METER_CAPACITY,            part->Name())];
                 break;
             }
             default:
@@ -118,6 +97,8 @@ Ship::Ship(int empire_id, int design_id, const std::string& species_name,
             }
         }
     }
+
+    m_part_meters.resize(Design()->PartMeterKeys().size());
 }
 
 Ship* Ship::Clone(int empire_id) const {
@@ -150,14 +131,10 @@ void Ship::Copy(const UniverseObject* copied_object, int empire_id) {
 
         if (vis >= VIS_PARTIAL_VISIBILITY) {
             this->m_design_id =             copied_ship->m_design_id;
-            this->m_fighters =              copied_ship->m_fighters;
-            this->m_missiles =              copied_ship->m_missiles;
-            for (PartMeters::const_iterator it = copied_ship->m_part_meters.begin();
-                 it != copied_ship->m_part_meters.end();
-                 ++it) {
-                this->m_part_meters[it->first];
-            }
-            this->m_species_name =          copied_ship->m_species_name;
+            CopyIfChanged(this->m_fighters,     copied_ship->m_fighters);
+            CopyIfChanged(this->m_missiles,     copied_ship->m_missiles);
+            this->m_part_meters.resize(copied_ship->m_part_meters.size());
+            CopyIfChanged(this->m_species_name, copied_ship->m_species_name);
 
             if (vis >= VIS_FULL_VISIBILITY) {
                 this->m_ordered_scrapped =          copied_ship->m_ordered_scrapped;
@@ -173,6 +150,13 @@ void Ship::Copy(const UniverseObject* copied_object, int empire_id) {
 const std::string& Ship::TypeName() const
 { return UserString("SHIP"); }
 
+std::size_t Ship::MemoryUsage() const
+{
+    return sizeof(Ship) + UniverseObject::AllocatedMemory() +
+           MemoryEstimate::BytesWithKeys(m_fighters) + MemoryEstimate::BytesWithKeys(m_missiles) +
+           MemoryEstimate::Bytes(m_part_meters) + MemoryEstimate::Bytes(m_species_name);
+}
+
 std::string Ship::Dump() const {
     std::stringstream os;
     os << UniverseObject::Dump();
@@ -195,16 +179,16 @@ std::string Ship::Dump() const {
         ++it;
         os << part_name << ": " << num_consumables_available << (it == m_missiles.end() ? "" : ", ");
     }
-    //typedef std::map<std::pair<MeterType, std::string>, Meter> PartMeters;
     os << " part meters: ";
-    for (PartMeters::const_iterator it = m_part_meters.begin(); it != m_part_meters.end();) {
-        const std::string part_name = it->first.second;
-        MeterType meter_type = it->first.first;
-        const Meter& meter = it->second;
-        ++it;
-        os << UserString(part_name) << " "
-           << UserString(GG::GetEnumMap<MeterType>().FromEnum(meter_type))
-           << ": " << meter.Current() << "  ";
+    if (const ShipDesign* design = Design()) {
+        const std::vector<std::pair<MeterType, std::string> >& part_meter_keys = design->PartMeterKeys();
+        for (std::size_t i = 0; i < m_part_meters.size() && i < part_meter_keys.size(); ++i) {
+            const std::string& part_name = part_meter_keys[i].second;
+            MeterType meter_type = part_meter_keys[i].first;
+            os << UserString(part_name) << " "
+               << UserString(GG::GetEnumMap<MeterType>().FromEnum(meter_type))
+               << ": " << m_part_meters[i].Current() << "  ";
+        }
     }
     return os.str();
 }
@@ -232,18 +216,20 @@ bool Ship::IsArmed() const {
 bool Ship::CanColonize() const {
     if (m_species_name.empty())
         return false;
-    const Species* species = GetSpecies(m_species_name);
-    if (!species)
-        return false;
-    if (!species->CanColonize())
-        return false;
 
+    // check the design first, as most ships have no colony parts
     const ShipDesign* design = Design();
     if (!design)
         return false;
     if (!design->CanColonize())
         return false;
 
+    const Species* species = GetSpecies(m_species_name);
+    if (!species)
+        return false;
+    if (!species->CanColonize())
+        return false;
+
     return true;
 }
 
@@ -298,6 +284,9 @@ double Ship::NextTurnCurrentMeterValue(MeterType type) const {
 const Meter* Ship::GetMeter(MeterType type, const std::string& part_name) const
 { return const_cast<Ship*>(this)->GetMeter(type, part_name); }
 
+const Meter* Ship::GetPartMeter(std::size_t slot, MeterType type) const
+{ return const_cast<Ship*>(this)->GetPartMeter(slot, type); }
+
 void Ship::SetFleetID(int fleet_id) {
     m_fleet_id = fleet_id;
     StateChangedSignal();
@@ -312,6 +301,8 @@ void Ship::Resupply() {
     }
 
     fuel_meter->SetCurrent(max_fuel_meter->Current());
+    if (Fleet* fleet = GetObject<Fleet>(m_fleet_id))
+        fleet->InvalidateAggregates();
 
     for (ConsumablesMap::iterator it = m_fighters.begin();
          it != m_fighters.end(); ++it)
@@ -355,6 +346,8 @@ void Ship::SetSpecies(const std::string& species_name) {
     if (!GetSpecies(species_name))
         Logger().errorStream() << "Ship::SetSpecies couldn't get species with name " << species_name;
     m_species_name = species_name;
+    if (Fleet* fleet = GetObject<Fleet>(m_fleet_id))
+        fleet->InvalidateAggregates();
 }
 
 void Ship::MoveTo(double x, double y) {
@@ -406,11 +399,23 @@ void Ship::ClearInvadePlanet() {
 }
 
 Meter* Ship::GetMeter(MeterType type, const std::string& part_name) {
-    Meter* retval = 0;
-    PartMeters::iterator it = m_part_meters.find(std::make_pair(type, part_name));
-    if (it != m_part_meters.end())
-        retval = &it->second;
-    return retval;
+    const ShipDesign* design = Design();
+    if (!design)
+        return 0;
+    int index = design->PartMeterIndex(type, part_name);
+    if (index < 0 || static_cast<int>(m_part_meters.size()) <= index)
+        return 0;
+    return &m_part_meters[index];
+}
+
+Meter* Ship::GetPartMeter(std::size_t slot, MeterType type) {
+    const ShipDesign* design = Design();
+    if (!design)
+        return 0;
+    int index = design->PartMeterIndex(slot, type);
+    if (index < 0 || static_cast<int>(m_part_meters.size()) <= index)
+        return 0;
+    return &m_part_meters[index];
 }
 
 void Ship::ResetTargetMaxUnpairedMeters() {
@@ -425,7 +430,7 @@ void Ship::ResetTargetMaxUnpairedMeters() {
     UniverseObject::GetMeter(METER_STARLANE_SPEED)->ResetCurrent();
 
     for (PartMeters::iterator it = m_part_meters.begin(); it != m_part_meters.end(); ++it)
-        it->second.ResetCurrent();
+        it->ResetCurrent();
 }
 
 void Ship::PopGrowthProductionResearchPhase() {
@@ -441,6 +446,7 @@ void Ship::ClampMeters() {
 
     UniverseObject::GetMeter(METER_MAX_FUEL)->ClampCurrentToRange();
     UniverseObject::GetMeter(METER_FUEL)->ClampCurrentToRange(Meter::DEFAULT_VALUE, UniverseObject::GetMeter(METER_MAX_FUEL)->Current());
+
     UniverseObject::GetMeter(METER_MAX_SHIELD)->ClampCurrentToRange();
     UniverseObject::GetMeter(METER_SHIELD)->ClampCurrentToRange(Meter::DEFAULT_VALUE, UniverseObject::GetMeter(METER_MAX_SHIELD)->Current());
     UniverseObject::GetMeter(METER_MAX_STRUCTURE)->ClampCurrentToRange();
@@ -451,5 +457,9 @@ void Ship::ClampMeters() {
     UniverseObject::GetMeter(METER_STARLANE_SPEED)->ClampCurrentToRange();
 
     for (PartMeters::iterator it = m_part_meters.begin(); it != m_part_meters.end(); ++it)
-        it->second.ClampCurrentToRange();
+        it->ClampCurrentToRange();
+
+    // meters are clamped after every update of them by effects
+    if (Fleet* fleet = GetObject<Fleet>(m_fleet_id))
+        fleet->InvalidateAggregates();
 }
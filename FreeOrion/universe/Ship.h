@@ -10,7 +10,7 @@ class Fleet;
 class ShipDesign;
 
 /** a class representing a single FreeOrion ship*/
-class Ship : public UniverseObject
+class Ship : public UniverseObject, public PoolAllocated<Ship>
 {
 public:
     // map from part type name to (number of parts in the design of that type,
@@ -35,6 +35,7 @@ public:
 
     virtual const std::string&  PublicName(int empire_id) const;
     virtual std::string         Dump() const;
+    virtual std::size_t         MemoryUsage() const;
 
     bool                        IsMonster() const;
     bool                        IsArmed() const;
@@ -55,6 +56,7 @@ public:
     int                         OrderedInvadePlanet() const     { return m_ordered_invade_planet_id; }  ///< returns the ID of the planet this ship has been ordered to invade with ground troops, or INVALID_OBJECT_ID if this ship hasn't been ordered to invade a planet
 
     const Meter*                GetMeter(MeterType type, const std::string& part_name) const; ///< returns the requested Meter, or 0 if no such Meter of that type is found in this object
+    const Meter*                GetPartMeter(std::size_t slot, MeterType type) const;         ///< returns the Meter of type \a type for the part in slot \a slot of this ship's design, or 0 if there is no such meter
     //@}
 
     /** \name Mutators */ //@{
@@ -79,6 +81,7 @@ public:
     void            ClearInvadePlanet();                                    ///< marks ship to invade no planets
 
     Meter*          GetMeter(MeterType type, const std::string& part_name); ///< returns the requested Meter, or 0 if no such Meter of that type is found in this object
+    Meter*          GetPartMeter(std::size_t slot, MeterType type);         ///< returns the Meter of type \a type for the part in slot \a slot of this ship's design, or 0 if there is no such meter
     //@}
 
 protected:
@@ -87,7 +90,9 @@ protected:
 private:
     virtual void    PopGrowthProductionResearchPhase();
 
-    typedef std::map<std::pair<MeterType, std::string>, Meter> PartMeters;
+    /** Part meters, in the order of the design's ShipDesign::PartMeterKeys(),
+      * which is also the order of the map in which they were once stored. */
+    typedef std::vector<Meter> PartMeters;
 
     virtual void    ClampMeters();
 
@@ -107,4 +112,6 @@ private:
     void serialize(Archive& ar, const unsigned int version);
 };
 
+BOOST_CLASS_VERSION(Ship, 1)
+
 #endif // _Ship_h_
@@ -21,6 +21,43 @@ extern int g_indent;
 
 namespace {
     const bool CHEAP_AND_FAST_SHIP_PRODUCTION = false;    // makes all ships cost 1 PP and take 1 turn to build
+
+    /** The types of the meters ships have for each part of each class,
+      * indexed by ShipPartClass. */
+    struct PartClassMeterTypes
+    {
+        PartClassMeterTypes() :
+            meter_types(NUM_SHIP_PART_CLASSES)
+        {
+            std::vector<MeterType>& direct_fire = meter_types[PC_SHORT_RANGE];
+            direct_fire.push_back(METER_DAMAGE);
+            direct_fire.push_back(METER_ROF);
+            direct_fire.push_back(METER_RANGE);
+            meter_types[PC_POINT_DEFENSE] = direct_fire;
+
+            std::vector<MeterType>& missiles = meter_types[PC_MISSILES];
+            missiles.push_back(METER_DAMAGE);
+            missiles.push_back(METER_ROF);
+            missiles.push_back(METER_RANGE);
+            missiles.push_back(METER_SPEED);
+            missiles.push_back(METER_STEALTH);
+            missiles.push_back(METER_STRUCTURE);
+            missiles.push_back(METER_CAPACITY);
+
+            std::vector<MeterType>& fighters = meter_types[PC_FIGHTERS];
+            fighters.push_back(METER_ANTI_SHIP_DAMAGE);
+            fighters.push_back(METER_ANTI_FIGHTER_DAMAGE);
+            fighters.push_back(METER_LAUNCH_RATE);
+            fighters.push_back(METER_FIGHTER_WEAPON_RANGE);
+            fighters.push_back(METER_SPEED);
+            fighters.push_back(METER_STEALTH);
+            fighters.push_back(METER_STRUCTURE);
+            fighters.push_back(METER_DETECTION);
+            fighters.push_back(METER_CAPACITY);
+        }
+
+        std::vector<std::vector<MeterType> >    meter_types;
+    };
 }
 
 namespace {
@@ -451,6 +488,14 @@ bool PartType::CanMountInSlotType(ShipSlotType slot_type) const {
     return false;
 }
 
+const std::vector<MeterType>& PartType::MeterTypes() const {
+    static const PartClassMeterTypes s_part_class_meter_types;
+    static const std::vector<MeterType> s_no_meter_types;
+    if (m_class < 0 || NUM_SHIP_PART_CLASSES <= m_class)
+        return s_no_meter_types;
+    return s_part_class_meter_types.meter_types[m_class];
+}
+
 
 ////////////////////////////////////////////////
 // HullType stats                             //
@@ -635,6 +680,8 @@ ShipDesign::ShipDesign() :
     m_graphic(""),
     m_3D_model(""),
     m_name_desc_in_stringtable(false),
+    m_attack(0.0),
+    m_defense(0.0),
     m_is_armed(false),
     m_detection(0.0),
     m_colony_capacity(0.0),
@@ -674,6 +721,8 @@ ShipDesign::ShipDesign(const std::string& name, const std::string& description,
     m_graphic(graphic),
     m_3D_model(model),
     m_name_desc_in_stringtable(name_desc_in_stringtable),
+    m_attack(0.0),
+    m_defense(0.0),
     m_is_armed(false),
     m_detection(0.0),
     m_colony_capacity(0.0),
@@ -742,55 +791,34 @@ int ShipDesign::ProductionTime() const {
 }
 
 
-//// TEMPORARY
-double ShipDesign::Defense() const {
-    // accumulate defense from defensive parts in design.
-    double total_defense = 0.0;
-    const PartTypeManager& part_manager = GetPartTypeManager();
-    std::vector<std::string> all_parts = Parts();
-    for (std::vector<std::string>::const_iterator it = all_parts.begin(); it != all_parts.end(); ++it) {
-        const PartType* part = part_manager.GetPartType(*it);
-        if (part && (part->Class() == PC_SHIELD || part->Class() == PC_ARMOUR))
-            total_defense += boost::get<double>(part->Stats());
-    }
-    return total_defense;
+double ShipDesign::PartClassTotal(ShipPartClass part_class) const {
+    if (part_class < 0 || static_cast<std::size_t>(part_class) >= m_part_class_totals.size())
+        return 0.0;
+    return m_part_class_totals[part_class];
 }
 
-double ShipDesign::Attack() const {
-    // accumulate attack stat from all weapon parts in design
-    const PartTypeManager& manager = GetPartTypeManager();
-
-    double total_attack = 0.0;
-    std::vector<std::string> all_parts = Parts();
-    for (std::vector<std::string>::const_iterator it = all_parts.begin(); it != all_parts.end(); ++it) {
-        const PartType* part = manager.GetPartType(*it);
-        if (part) {
-            if (part->Class() == PC_SHORT_RANGE || part->Class() == PC_POINT_DEFENSE)
-                total_attack += boost::get<DirectFireStats>(part->Stats()).m_damage;
-            else if (part->Class() == PC_MISSILES)
-                total_attack += boost::get<LRStats>(part->Stats()).m_damage;
-            else if (part->Class() == PC_FIGHTERS)
-                total_attack += boost::get<FighterStats>(part->Stats()).m_anti_ship_damage;
-        }
-    }
-    return total_attack;
+const std::vector<int>& ShipDesign::PartIndices(ShipPartClass part_class) const {
+    static const std::vector<int> EMPTY_VEC;
+    if (part_class < 0 || static_cast<std::size_t>(part_class) >= m_part_class_indices.size())
+        return EMPTY_VEC;
+    return m_part_class_indices[part_class];
+}
+
+const std::vector<int>& ShipDesign::SlotIndices(ShipSlotType slot_type) const {
+    static const std::vector<int> EMPTY_VEC;
+    if (slot_type < 0 || static_cast<std::size_t>(slot_type) >= m_slot_type_indices.size())
+        return EMPTY_VEC;
+    return m_slot_type_indices[slot_type];
 }
-//// END TEMPORARY
 
 std::vector<std::string> ShipDesign::Parts(ShipSlotType slot_type) const {
     std::vector<std::string> retval;
 
-    const HullType* hull = GetHull();
-    assert(hull);
-    const std::vector<HullType::Slot>& slots = hull->Slots();
-
-    unsigned int size = m_parts.size();
-    assert(size == hull->NumSlots());
-
     // add to output vector each part that is in a slot of the indicated ShipSlotType 
-    for (unsigned int i = 0; i < size; ++i)
-        if (slots[i].type == slot_type)
-            retval.push_back(m_parts[i]);
+    const std::vector<int>& indices = SlotIndices(slot_type);
+    retval.reserve(indices.size());
+    for (std::vector<int>::const_iterator it = indices.begin(); it != indices.end(); ++it)
+        retval.push_back(m_parts[*it]);
 
     return retval;
 }
@@ -926,8 +954,33 @@ bool ShipDesign::ValidDesign(const std::string& hull, const std::vector<std::str
     return true;
 }
 
+int ShipDesign::PartMeterIndex(MeterType type, const std::string& part_name) const {
+    std::pair<MeterType, std::string> key(type, part_name);
+    std::vector<std::pair<MeterType, std::string> >::const_iterator it =
+        std::lower_bound(m_part_meter_keys.begin(), m_part_meter_keys.end(), key);
+    if (it == m_part_meter_keys.end() || *it != key)
+        return -1;
+    return it - m_part_meter_keys.begin();
+}
+
+int ShipDesign::PartMeterIndex(std::size_t slot, MeterType type) const {
+    std::size_t index = slot * NUM_METER_TYPES + type;
+    if (type < 0 || NUM_METER_TYPES <= type || m_slot_part_meter_indices.size() <= index)
+        return -1;
+    return m_slot_part_meter_indices[index];
+}
+
 void ShipDesign::BuildStatCaches()
 {
+    // the per-slot caches are sized to the parts first, so that users can
+    // index them by slot even if the hull is unknown; unknown parts are 0
+    m_part_types.assign(m_parts.size(), 0);
+    m_part_class_indices.assign(NUM_SHIP_PART_CLASSES, std::vector<int>());
+    m_part_class_totals.assign(NUM_SHIP_PART_CLASSES, 0.0);
+    m_slot_type_indices.assign(NUM_SHIP_SLOT_TYPES, std::vector<int>());
+    m_part_meter_keys.clear();
+    m_slot_part_meter_indices.assign(m_parts.size() * NUM_METER_TYPES, -1);
+
     const HullType* hull = GetHullType(m_hull);
     if (!hull) {
         Logger().errorStream() << "ShipDesign::BuildStatCaches couldn't get hull with name " << m_hull;
@@ -947,15 +1000,27 @@ void ShipDesign::BuildStatCaches()
     m_battle_speed =    hull->BattleSpeed();
     m_starlane_speed =  hull->StarlaneSpeed();
 
-    for (std::vector<std::string>::const_iterator it = m_parts.begin(); it != m_parts.end(); ++it) {
-        if (it->empty())
+    const std::vector<HullType::Slot>& slots = hull->Slots();
+    for (std::size_t i = 0; i < m_parts.size() && i < slots.size(); ++i) {
+        if (0 <= slots[i].type && slots[i].type < NUM_SHIP_SLOT_TYPES)
+            m_slot_type_indices[slots[i].type].push_back(i);
+    }
+
+    for (std::size_t i = 0; i < m_parts.size(); ++i) {
+        const std::string& part_name = m_parts[i];
+        if (part_name.empty())
             continue;
 
-        const PartType* part = GetPartType(*it);
+        const PartType* part = GetPartType(part_name);
         if (!part) {
-            Logger().errorStream() << "ShipDesign::BuildStatCaches couldn't get part with name " << *it;
+            Logger().errorStream() << "ShipDesign::BuildStatCaches couldn't get part with name " << part_name;
             continue;
         }
+        m_part_types[i] = part;
+
+        ShipPartClass part_class = part->Class();
+        if (0 <= part_class && part_class < NUM_SHIP_PART_CLASSES)
+            m_part_class_indices[part_class].push_back(i);
 
         m_production_time = std::max(m_production_time, part->ProductionTime()); // assume hull and parts are built in parallel
         m_production_cost += part->ProductionCost();                             // add up costs of all parts
@@ -966,6 +1031,7 @@ void ShipDesign::BuildStatCaches()
         case PC_SHORT_RANGE: {
             const DirectFireStats& stats = boost::get<DirectFireStats>(part->Stats());
             m_SR_weapons.insert(std::make_pair(stats.m_range, part));
+            m_part_class_totals[PC_SHORT_RANGE] += stats.m_damage;
             m_is_armed = true;
             m_min_SR_range = std::min(m_min_SR_range, stats.m_range);
             m_max_SR_range = std::max(m_max_SR_range, stats.m_range);
@@ -978,6 +1044,7 @@ void ShipDesign::BuildStatCaches()
         case PC_MISSILES: {
             const LRStats& stats = boost::get<LRStats>(part->Stats());
             m_LR_weapons.insert(std::make_pair(stats.m_range, part));
+            m_part_class_totals[PC_MISSILES] += stats.m_damage;
             m_is_armed = true;
             m_min_LR_range = std::min(m_min_LR_range, stats.m_range);
             m_max_LR_range = std::max(m_max_LR_range, stats.m_range);
@@ -989,11 +1056,13 @@ void ShipDesign::BuildStatCaches()
         }
         case PC_FIGHTERS:
             m_F_weapons.push_back(part);
+            m_part_class_totals[PC_FIGHTERS] += boost::get<FighterStats>(part->Stats()).m_anti_ship_damage;
             m_is_armed = true;
             break;
         case PC_POINT_DEFENSE: {
             const DirectFireStats& stats = boost::get<DirectFireStats>(part->Stats());
             m_PD_weapons.insert(std::make_pair(stats.m_range, part));
+            m_part_class_totals[PC_POINT_DEFENSE] += stats.m_damage;
             m_is_armed = true;
             m_min_PD_range = std::min(m_min_PD_range, stats.m_range);
             m_max_PD_range = std::max(m_max_PD_range, stats.m_range);
@@ -1002,30 +1071,39 @@ void ShipDesign::BuildStatCaches()
             break;
         }
         case PC_COLONY:
+            m_part_class_totals[PC_COLONY] += boost::get<double>(part->Stats());
             m_colony_capacity += boost::get<double>(part->Stats());
             break;
         case PC_TROOPS:
+            m_part_class_totals[PC_TROOPS] += boost::get<double>(part->Stats());
             m_troop_capacity += boost::get<double>(part->Stats());
             break;
         case PC_STEALTH:
+            m_part_class_totals[PC_STEALTH] += boost::get<double>(part->Stats());
             m_stealth += boost::get<double>(part->Stats());
             break;
         case PC_BATTLE_SPEED:
+            m_part_class_totals[PC_BATTLE_SPEED] += boost::get<double>(part->Stats());
             m_battle_speed += boost::get<double>(part->Stats());
             break;
         case PC_STARLANE_SPEED:
+            m_part_class_totals[PC_STARLANE_SPEED] += boost::get<double>(part->Stats());
             m_starlane_speed += boost::get<double>(part->Stats());
             break;
         case PC_SHIELD:
+            m_part_class_totals[PC_SHIELD] += boost::get<double>(part->Stats());
             m_shields += boost::get<double>(part->Stats());
             break;
         case PC_FUEL:
+            m_part_class_totals[PC_FUEL] += boost::get<double>(part->Stats());
             m_fuel += boost::get<double>(part->Stats());
             break;
         case PC_ARMOUR:
+            m_part_class_totals[PC_ARMOUR] += boost::get<double>(part->Stats());
             m_structure += boost::get<double>(part->Stats());
             break;
         case PC_DETECTION:
+            m_part_class_totals[PC_DETECTION] += boost::get<double>(part->Stats());
             m_detection += boost::get<double>(part->Stats());
             break;
         default:
@@ -1033,6 +1111,28 @@ void ShipDesign::BuildStatCaches()
         }
     }
 
+    // lay out the part meters of ships of this design
+    for (std::size_t i = 0; i < m_part_types.size(); ++i) {
+        if (!m_part_types[i])
+            continue;
+        const std::vector<MeterType>& meter_types = m_part_types[i]->MeterTypes();
+        for (std::vector<MeterType>::const_iterator it = meter_types.begin(); it != meter_types.end(); ++it)
+            m_part_meter_keys.push_back(std::make_pair(*it, m_parts[i]));
+    }
+    std::sort(m_part_meter_keys.begin(), m_part_meter_keys.end());
+    m_part_meter_keys.erase(std::unique(m_part_meter_keys.begin(), m_part_meter_keys.end()), m_part_meter_keys.end());
+    for (std::size_t i = 0; i < m_part_types.size(); ++i) {
+        if (!m_part_types[i])
+            continue;
+        const std::vector<MeterType>& meter_types = m_part_types[i]->MeterTypes();
+        for (std::vector<MeterType>::const_iterator it = meter_types.begin(); it != meter_types.end(); ++it)
+            m_slot_part_meter_indices[i * NUM_METER_TYPES + *it] = PartMeterIndex(*it, m_parts[i]);
+    }
+
+    m_attack = m_part_class_totals[PC_SHORT_RANGE] + m_part_class_totals[PC_MISSILES] +
+               m_part_class_totals[PC_FIGHTERS] + m_part_class_totals[PC_POINT_DEFENSE];
+    m_defense = m_part_class_totals[PC_SHIELD] + m_part_class_totals[PC_ARMOUR];
+
     if (m_SR_weapons.empty())
         m_min_SR_range = 0.0;
     if (m_LR_weapons.empty())
@@ -169,6 +169,7 @@ public:
     ShipPartClass           Class() const           { return m_class; }         ///< returns that class of part that this is.
     const PartTypeStats&    Stats() const           { return m_stats; }         ///< returns how good the part is at its function.  might be weapon or shield strength, or cargo hold capacity
     bool                    CanMountInSlotType(ShipSlotType slot_type) const;   ///< returns true if this part can be placed in a slot of the indicated type
+    const std::vector<MeterType>& MeterTypes() const;                           ///< returns the types of the meters that ships have for each part of this type, which depend on the part's class
     double                  ProductionCost() const  { return m_production_cost;}///< returns total cost of part
     int                     ProductionTime() const  { return m_production_time;}///< returns turns taken to build this part (the minimum time to build a ship design containing this part)
     bool                    Producible() const      { return m_producible; }    ///< returns whether this part type is producible by players and appears on the design screen
@@ -468,10 +469,28 @@ public:
     double  MaxNonPDWeaponRange() const { return m_max_non_PD_weapon_range; }
 
     /////// TEMPORARY ///////
-    double  Defense() const;
-    double  Attack() const;
+    double  Defense() const             { return m_defense; }   ///< returns the total shield and armour of the parts in this design
+    double  Attack() const              { return m_attack; }    ///< returns the total damage of the weapons in this design
     /////// TEMPORARY ///////
 
+    /** Returns the total of the main stat of the parts of class \a part_class
+      * in this design: the damage of weapons (anti-ship damage for fighters),
+      * and the single stat of other classes.  Fighters' and missiles'
+      * capacities are not included. */
+    double                          PartClassTotal(ShipPartClass part_class) const;
+
+    /** Returns the number of parts of class \a part_class in this design. */
+    int                             PartCount(ShipPartClass part_class) const
+    { return PartIndices(part_class).size(); }
+
+    /** Returns the indices, in Parts(), of the parts of class \a part_class
+      * in this design. */
+    const std::vector<int>&         PartIndices(ShipPartClass part_class) const;
+
+    /** Returns the indices, in Parts(), of the slots of type \a slot_type in
+      * this design's hull. */
+    const std::vector<int>&         SlotIndices(ShipSlotType slot_type) const;
+
 
     const std::string&              Hull() const            { return m_hull; }      ///< returns name of hull on which design is based
     const HullType*                 GetHull() const
@@ -480,6 +499,27 @@ public:
     const std::vector<std::string>& Parts() const           { return m_parts; }     ///< returns vector of names of all parts in design
     std::vector<std::string>        Parts(ShipSlotType slot_type) const;            ///< returns vector of names of parts in slots of indicated type
 
+    /** returns the PartType of the part in each slot, in the same order as
+      * Parts(); empty slots and unknown parts are 0 */
+    const std::vector<const PartType*>& PartTypes() const   { return m_part_types; }
+
+    /** Returns the meters that ships of this design have for their parts,
+      * as (meter type, part name) pairs, in ascending order.  Ships store
+      * their part meters in an array in this order; parts of the same type
+      * share meters. */
+    const std::vector<std::pair<MeterType, std::string> >& PartMeterKeys() const
+    { return m_part_meter_keys; }
+
+    /** Returns the index in PartMeterKeys() of the meter of type \a type for
+      * the part named \a part_name, or -1 if ships of this design have no
+      * such meter. */
+    int                             PartMeterIndex(MeterType type, const std::string& part_name) const;
+
+    /** Returns the index in PartMeterKeys() of the meter of type \a type for
+      * the part in slot \a slot, or -1 if the slot is empty or its part has
+      * no such meter. */
+    int                             PartMeterIndex(std::size_t slot, MeterType type) const;
+
     const std::string&              Graphic() const         { return m_graphic; }   ///< returns filename of graphic for design
     const std::string&              Model() const           { return m_3D_model; }  ///< returns filename of 3D model that represents ships of design
 
@@ -525,7 +565,18 @@ private:
     bool                        m_name_desc_in_stringtable;
 
     // Note that these are fine to compute on demand and cache here -- it is
-    // not necessary to serialize them.
+    // not necessary to serialize them.  Together they profile the design, so
+    // that the per-ship queries made in fleet movement, combat and the AI
+    // don't look up each part by name.
+    std::vector<const PartType*>    m_part_types;
+    std::vector<std::vector<int> >  m_part_class_indices;   ///< indexed by ShipPartClass
+    std::vector<double>             m_part_class_totals;    ///< indexed by ShipPartClass
+    std::vector<std::vector<int> >  m_slot_type_indices;    ///< indexed by ShipSlotType
+    std::vector<std::pair<MeterType, std::string> >
+                                    m_part_meter_keys;
+    std::vector<int>                m_slot_part_meter_indices;  ///< indexed by slot * NUM_METER_TYPES + MeterType
+    double  m_attack;
+    double  m_defense;
     bool    m_is_armed;
     double  m_detection;
     double  m_colony_capacity;
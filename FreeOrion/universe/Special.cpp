@@ -8,6 +8,10 @@
 #include "../util/Directories.h"
 
 #include <boost/filesystem/fstream.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <deque>
+#include <map>
 
 std::string DumpIndent();
 
@@ -42,8 +46,17 @@ namespace {
         static SpecialManager special_manager;
         return special_manager;
     }
+
+    // names of specials, indexed by id, and the ids of names.  names are
+    // never removed, and a deque doesn't move its elements when appended to,
+    // so references returned by SpecialName remain valid
+    std::deque<std::string>     s_special_names;
+    std::map<std::string, int>  s_special_ids;
+    boost::mutex                s_special_ids_mutex;
 }
 
+const int INVALID_SPECIAL_ID = -1;
+
 /////////////////////////////////////////////////
 // Special                                     //
 /////////////////////////////////////////////////
@@ -86,3 +99,31 @@ const Special* GetSpecial(const std::string& name)
 
 std::vector<std::string> SpecialNames()
 { return GetSpecialManager().SpecialNames(); }
+
+int SpecialID(const std::string& name)
+{
+    boost::mutex::scoped_lock lock(s_special_ids_mutex);
+    std::map<std::string, int>::const_iterator it = s_special_ids.find(name);
+    if (it != s_special_ids.end())
+        return it->second;
+    int special_id = static_cast<int>(s_special_names.size());
+    s_special_names.push_back(name);
+    s_special_ids[name] = special_id;
+    return special_id;
+}
+
+int FindSpecialID(const std::string& name)
+{
+    boost::mutex::scoped_lock lock(s_special_ids_mutex);
+    std::map<std::string, int>::const_iterator it = s_special_ids.find(name);
+    return it != s_special_ids.end() ? it->second : INVALID_SPECIAL_ID;
+}
+
+const std::string& SpecialName(int special_id)
+{
+    static const std::string EMPTY_STRING;
+    boost::mutex::scoped_lock lock(s_special_ids_mutex);
+    if (special_id < 0 || static_cast<std::size_t>(special_id) >= s_special_names.size())
+        return EMPTY_STRING;
+    return s_special_names[special_id];
+}
@@ -77,6 +77,23 @@ const Special* GetSpecial(const std::string& name);
 /** Returns names of all specials. */
 std::vector<std::string> SpecialNames();
 
+/** The id returned by FindSpecialID() for names that have no id. */
+extern const int INVALID_SPECIAL_ID;
+
+/** Returns the id under which UniverseObjects store specials named \a name,
+  * assigning the next unused id if \a name doesn't have one yet.  Ids are
+  * small, dense integers assigned in the order names are first seen, so they
+  * may differ between processes; objects' specials are serialized by name. */
+int SpecialID(const std::string& name);
+
+/** Returns the id of specials named \a name, or INVALID_SPECIAL_ID if it
+  * doesn't have one, in which case no object has such a special. */
+int FindSpecialID(const std::string& name);
+
+/** Returns the name of specials with id \a special_id, or an empty string if
+  * no name has that id. */
+const std::string& SpecialName(int special_id);
+
 // template implementations
 template <class Archive>
 void Special::serialize(Archive& ar, const unsigned int version)
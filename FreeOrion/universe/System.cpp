@@ -2,6 +2,7 @@
 
 #include "Fleet.h"
 #include "Planet.h"
+#include "MemoryReport.h"
 #include "Predicates.h"
 
 #include "../Empire/Empire.h"
@@ -93,7 +94,7 @@ void System::Copy(const UniverseObject* copied_object, int empire_id)
     UniverseObject::Copy(copied_object, vis);
 
     if (vis >= VIS_BASIC_VISIBILITY) {
-        this->m_objects =                   copied_system->VisibleContainedObjects(empire_id);
+        CopyVisibleIfChanged(this->m_objects, copied_system->m_objects, empire_id);
 
         // add any visible lanes, without removing existing entries
         StarlaneMap visible_lanes_holes = copied_system->VisibleStarlanesWormholes(empire_id);
@@ -137,6 +138,13 @@ void System::Copy(const UniverseObject* copied_object, int empire_id)
 const std::string& System::TypeName() const
 { return UserString("SYSTEM"); }
 
+std::size_t System::MemoryUsage() const
+{
+    return sizeof(System) + UniverseObject::AllocatedMemory() +
+           MemoryEstimate::Bytes(m_objects) + MemoryEstimate::Bytes(m_starlanes_wormholes) +
+           MemoryEstimate::Bytes(m_empires_with_planets_here);
+}
+
 std::string System::Dump() const
 {
     std::stringstream os;
@@ -172,8 +180,7 @@ const std::string& System::ApparentName(int empire_id, bool blank_unexplored_and
         return this->PublicName(empire_id);
 
     // has the indicated empire ever detected this system?
-    const Universe::VisibilityTurnMap& vtm = GetUniverse().GetObjectVisibilityTurnMapByEmpire(this->ID(), empire_id);
-    if (vtm.find(VIS_PARTIAL_VISIBILITY) == vtm.end()) {
+    if (GetUniverse().GetObjectVisibilityTurnByEmpire(this->ID(), empire_id, VIS_PARTIAL_VISIBILITY) == INVALID_GAME_TURN) {
         if (blank_unexplored_and_none)
             return EMPTY_STRING;
 
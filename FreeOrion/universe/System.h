@@ -23,7 +23,7 @@ struct UniverseObjectVisitor;
    functions.  Iteration is available over all starlanes and wormholes
    (together), all system objects, all free system objects (those not in an
    orbit), and all objects in a paricular orbit.*/
-class System : public UniverseObject
+class System : public UniverseObject, public PoolAllocated<System>
 {
 private:
     typedef std::multimap<int, int>             ObjectMultimap;         ///< each key value represents an orbit (-1 represents general system contents not in any orbit); there may be many or no objects at each orbit (including -1)
@@ -61,6 +61,7 @@ public:
     /** \name Accessors */ //@{
     virtual const std::string&  TypeName() const;                       ///< returns user-readable string indicating the type of UniverseObject this is
     virtual std::string         Dump() const;
+    virtual std::size_t         MemoryUsage() const;
 
     /** returns the name to display for players for this system.  While all
       * systems may have a proper name assigned, if they contain no planets or
@@ -2,6 +2,7 @@
 
 #include "../util/AppInterface.h"
 #include "../util/DataTable.h"
+#include "../util/GameContext.h"
 #include "../util/MultiplayerCommon.h"
 #include "../util/OptionsDB.h"
 #include "../util/Directories.h"
@@ -17,6 +18,7 @@
 #include "System.h"
 #include "UniverseObject.h"
 #include "Effect.h"
+#include "MemoryReport.h"
 #include "Predicates.h"
 #include "Special.h"
 #include "Species.h"
@@ -33,6 +35,7 @@
 #include <boost/graph/johnson_all_pairs_shortest.hpp>
 #include <boost/timer.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
@@ -358,6 +361,20 @@ struct Universe::GraphImpl
     typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS,
                                   vertex_property_t, edge_property_t> SystemGraph;
 
+    /** The starlanes an empire knows of, as the graph indices of the systems
+      * at the other ends of the known lanes from each system, indexed by graph
+      * index.  Only used while valid is true. */
+    struct KnownStarlanes
+    {
+        KnownStarlanes() :
+            valid(false)
+        {}
+
+        bool                            valid;
+        std::vector<std::vector<int> >  lanes;
+    };
+    typedef std::map<int, boost::shared_ptr<KnownStarlanes> > EmpireKnownStarlanesMap;
+
     struct EdgeVisibilityFilter
     {
         EdgeVisibilityFilter() :
@@ -365,9 +382,11 @@ struct Universe::GraphImpl
             m_empire_id(ALL_EMPIRES)
         {}
 
-        EdgeVisibilityFilter(const SystemGraph* graph, int empire_id) :
+        EdgeVisibilityFilter(const SystemGraph* graph, int empire_id,
+                             const boost::shared_ptr<const KnownStarlanes>& known_starlanes) :
             m_graph(graph),
-            m_empire_id(empire_id)
+            m_empire_id(empire_id),
+            m_known_starlanes(known_starlanes)
         {
             if (!graph)
                 Logger().errorStream() << "EdgeVisibilityFilter passed null graph pointer";
@@ -379,6 +398,15 @@ struct Universe::GraphImpl
             if (!m_graph)
                 return false;
 
+            // use precomputed starlanes, if available
+            if (m_known_starlanes && m_known_starlanes->valid) {
+                std::size_t sys_graph_index_1 = boost::source(edge, *m_graph);
+                if (m_known_starlanes->lanes.size() <= sys_graph_index_1)
+                    return false;
+                const std::vector<int>& lanes = m_known_starlanes->lanes[sys_graph_index_1];
+                return std::find(lanes.begin(), lanes.end(), static_cast<int>(boost::target(edge, *m_graph))) != lanes.end();
+            }
+
             // get system ids from graph indices
             ConstSystemIDPropertyMap sys_id_property_map = boost::get(vertex_system_id_t(), *m_graph); // for reverse-lookup System universe ID from graph index
             int sys_graph_index_1 = boost::source(edge, *m_graph);
@@ -400,8 +428,9 @@ struct Universe::GraphImpl
         }
 
     private:
-        const SystemGraph*      m_graph;
-        int                     m_empire_id;
+        const SystemGraph*                          m_graph;
+        int                                         m_empire_id;
+        boost::shared_ptr<const KnownStarlanes>     m_known_starlanes;
     };
     typedef boost::filtered_graph<SystemGraph, EdgeVisibilityFilter> EmpireViewSystemGraph;
     typedef std::map<int, boost::shared_ptr<EmpireViewSystemGraph> > EmpireViewSystemGraphMap;
@@ -414,8 +443,19 @@ struct Universe::GraphImpl
     typedef boost::property_map<SystemGraph, boost::edge_weight_t>::const_type      ConstEdgeWeightPropertyMap;
     typedef boost::property_map<SystemGraph, boost::edge_weight_t>::type            EdgeWeightPropertyMap;
 
+    /** Returns the starlanes known to the empire with id \a empire_id, which
+      * are shared with that empire's filtered graphs. */
+    const boost::shared_ptr<KnownStarlanes>& EmpireKnownStarlanes(int empire_id)
+    {
+        boost::shared_ptr<KnownStarlanes>& retval = empire_known_starlanes[empire_id];
+        if (!retval)
+            retval.reset(new KnownStarlanes);
+        return retval;
+    }
+
     SystemGraph                 system_graph;                 ///< a graph in which the systems are vertices and the starlanes are edges
     EmpireViewSystemGraphMap    empire_system_graph_views;    ///< a map of empire IDs to the views of the system graph by those empires
+    EmpireKnownStarlanesMap     empire_known_starlanes;       ///< a map of empire IDs to the starlanes known to those empires, used by their views of the system graph
 };
 
 /////////////////////////////////////////////
@@ -423,12 +463,10 @@ struct Universe::GraphImpl
 /////////////////////////////////////////////
 // static(s)
 const bool  Universe::ALL_OBJECTS_VISIBLE =                 false;
-double      Universe::s_universe_width =                    1000.0;
-bool        Universe::s_inhibit_universe_object_signals =   false;
-int         Universe::s_encoding_empire =                   ALL_EMPIRES;
 
 Universe::Universe() :
     m_graph_impl(new GraphImpl),
+    m_system_graph_version(0),
     m_last_allocated_object_id(-1), // this is conicidentally equal to UniverseObject::INVALID_OBJECT_ID as of this writing, but the reason for this to be -1 is so that the first object has id 0, and all object ids are non-negative
     m_last_allocated_design_id(-1)  // same, but for ShipDesign::INVALID_DESIGN_ID
 {}
@@ -441,6 +479,8 @@ Universe::~Universe()
 
 void Universe::Clear()
 {
+    InvalidateEmpireKnownStarlanes();
+
     // empty object maps
     m_objects.Clear();
     for (EmpireObjectMap::iterator it = m_empire_latest_known_objects.begin(); it != m_empire_latest_known_objects.end(); ++it)
@@ -510,13 +550,18 @@ std::set<int> Universe::EmpireVisibleObjectIDs(int empire_id/* = ALL_EMPIRES*/)
     return retval;
 }
 
-const std::set<int>& Universe::EmpireKnownDestroyedObjectIDs(int empire_id) const
+std::set<int> Universe::EmpireKnownDestroyedObjectIDs(int empire_id) const
 {
-    ObjectKnowledgeMap::const_iterator it = m_empire_known_destroyed_object_ids.find(empire_id);
-    if (it != m_empire_known_destroyed_object_ids.end())
-        return it->second;
-    static const std::set<int> empty_set;
-    return empty_set;
+    EmpireVisibilityMap::const_iterator it = m_empire_visibility.find(empire_id);
+    if (it != m_empire_visibility.end())
+        return it->second.KnownDestroyedObjectIDs();
+    return std::set<int>();
+}
+
+bool Universe::EmpireKnowsObjectDestroyed(int object_id, int empire_id) const
+{
+    EmpireVisibilityMap::const_iterator it = m_empire_visibility.find(empire_id);
+    return it != m_empire_visibility.end() && it->second.KnowsDestroyed(object_id);
 }
 
 const ShipDesign* Universe::GetShipDesign(int ship_design_id) const
@@ -555,33 +600,29 @@ Visibility Universe::GetObjectVisibilityByEmpire(int object_id, int empire_id) c
     if (empire_id == ALL_EMPIRES || Universe::ALL_OBJECTS_VISIBLE)
         return VIS_FULL_VISIBILITY;
 
-    EmpireObjectVisibilityMap::const_iterator empire_it = m_empire_object_visibility.find(empire_id);
-    if (empire_it == m_empire_object_visibility.end())
-        return VIS_NO_VISIBILITY;
-
-    const ObjectVisibilityMap& vis_map = empire_it->second;
-
-    ObjectVisibilityMap::const_iterator vis_map_it = vis_map.find(object_id);
-    if (vis_map_it == vis_map.end())
+    EmpireVisibilityMap::const_iterator empire_it = m_empire_visibility.find(empire_id);
+    if (empire_it == m_empire_visibility.end())
         return VIS_NO_VISIBILITY;
 
-    return vis_map_it->second;
+    return empire_it->second.GetVisibility(object_id);
 }
 
-const Universe::VisibilityTurnMap& Universe::GetObjectVisibilityTurnMapByEmpire(int object_id, int empire_id) const
+Universe::VisibilityTurnMap Universe::GetObjectVisibilityTurnMapByEmpire(int object_id, int empire_id) const
 {
-    static const std::map<Visibility, int> empty_map;
+    EmpireVisibilityMap::const_iterator empire_it = m_empire_visibility.find(empire_id);
+    if (empire_it == m_empire_visibility.end())
+        return VisibilityTurnMap();
 
-    EmpireObjectVisibilityTurnMap::const_iterator empire_it = m_empire_object_visibility_turns.find(empire_id);
-    if (empire_it == m_empire_object_visibility_turns.end())
-        return empty_map;
+    return empire_it->second.VisibilityTurns(object_id);
+}
 
-    const ObjectVisibilityTurnMap& obj_vis_turn_map = empire_it->second;
-    ObjectVisibilityTurnMap::const_iterator object_it = obj_vis_turn_map.find(object_id);
-    if (object_it == obj_vis_turn_map.end())
-        return empty_map;
+int Universe::GetObjectVisibilityTurnByEmpire(int object_id, int empire_id, Visibility vis) const
+{
+    EmpireVisibilityMap::const_iterator empire_it = m_empire_visibility.find(empire_id);
+    if (empire_it == m_empire_visibility.end())
+        return INVALID_GAME_TURN;
 
-    return object_it->second;
+    return empire_it->second.VisibilityTurn(object_id, vis);
 }
 
 double Universe::LinearDistance(int system1_id, int system2_id) const
@@ -703,6 +744,55 @@ std::map<double, int> Universe::ImmediateNeighbors(int system_id, int empire_id/
     return std::map<double, int>();
 }
 
+void Universe::GetMemoryReport(MemoryReport& report) const
+{
+    report.Add("objects", m_objects.NumObjects(), m_objects.MemoryUsage());
+
+    std::size_t latest_known_objects = 0, latest_known_bytes = MemoryEstimate::Bytes(m_empire_latest_known_objects);
+    for (EmpireObjectMap::const_iterator it = m_empire_latest_known_objects.begin(); it != m_empire_latest_known_objects.end(); ++it) {
+        latest_known_objects += it->second.NumObjects();
+        latest_known_bytes += it->second.MemoryUsage();
+    }
+    report.Add("latest known objects", latest_known_objects, latest_known_bytes);
+
+    std::size_t visibility_bytes = MemoryEstimate::Bytes(m_empire_visibility);
+    for (EmpireVisibilityMap::const_iterator it = m_empire_visibility.begin(); it != m_empire_visibility.end(); ++it)
+        visibility_bytes += it->second.MemoryUsage();
+    report.Add("visibility", m_empire_visibility.size(), visibility_bytes);
+
+    std::size_t accounting_infos = 0, accounting_bytes = MemoryEstimate::Bytes(m_effect_accounting_map);
+    for (Effect::AccountingMap::const_iterator object_it = m_effect_accounting_map.begin();
+         object_it != m_effect_accounting_map.end(); ++object_it)
+    {
+        accounting_bytes += MemoryEstimate::Bytes(object_it->second);
+        for (std::map<MeterType, std::vector<Effect::AccountingInfo> >::const_iterator meter_it = object_it->second.begin();
+             meter_it != object_it->second.end(); ++meter_it)
+        {
+            accounting_infos += meter_it->second.size();
+            accounting_bytes += MemoryEstimate::Bytes(meter_it->second);
+            for (std::vector<Effect::AccountingInfo>::const_iterator info_it = meter_it->second.begin();
+                 info_it != meter_it->second.end(); ++info_it)
+            { accounting_bytes += MemoryEstimate::Bytes(info_it->specific_cause); }
+        }
+    }
+    report.Add("effect accounting", accounting_infos, accounting_bytes);
+
+    report.Add("system matrices", m_system_id_to_graph_index.size(),
+               m_system_distances.MemoryUsage() + m_system_jumps.MemoryUsage());
+
+    std::size_t design_bytes = MemoryEstimate::Bytes(m_ship_designs);
+    for (ShipDesignMap::const_iterator it = m_ship_designs.begin(); it != m_ship_designs.end(); ++it) {
+        const ShipDesign* design = it->second;
+        if (!design)
+            continue;
+        design_bytes += sizeof(ShipDesign) + MemoryEstimate::Bytes(design->Name(false)) +
+                        MemoryEstimate::Bytes(design->Description(false)) + MemoryEstimate::Bytes(design->Parts());
+        for (std::vector<std::string>::const_iterator part_it = design->Parts().begin(); part_it != design->Parts().end(); ++part_it)
+            design_bytes += MemoryEstimate::Bytes(*part_it);
+    }
+    report.Add("ship designs", m_ship_designs.size(), design_bytes);
+}
+
 int Universe::Insert(UniverseObject* obj)
 {
     if (!obj)
@@ -870,6 +960,9 @@ void Universe::InitMeterEstimatesAndDiscrepancies()
 
             // correct current max meter estimate for discrepancy
             meter->AddToCurrent(discrepancy);
+            if (Ship* ship = universe_object_cast<Ship*>(obj))
+                if (Fleet* fleet = m_objects.Object<Fleet>(ship->FleetID()))
+                    fleet->InvalidateAggregates();
 
             // add discrepancy adjustment to meter accounting
             Effect::AccountingInfo info;
@@ -1087,11 +1180,17 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes, const
                                              all_potential_targets, targets_causes);
     }
 
-    // 1) EffectsGroups from Specials
+    // 1) EffectsGroups from Specials.  the per-special index gives the few
+    // objects that have specials, whose specials are then taken in order of
+    // name, as they were when objects stored them by name
     Logger().debugStream() << "Universe::GetEffectsAndTargets for SPECIALS";
-    for (ObjectMap::const_iterator it = m_objects.const_begin(); it != m_objects.const_end(); ++it) {
-        int source_object_id = it->first;
-        const std::map<std::string, int>& specials = it->second->Specials();
+    std::vector<int> special_source_ids = m_objects.FindObjectIDsWithSpecials();
+    for (std::vector<int>::const_iterator it = special_source_ids.begin(); it != special_source_ids.end(); ++it) {
+        int source_object_id = *it;
+        const UniverseObject* source = m_objects.Object(source_object_id);
+        if (!source)
+            continue;
+        std::map<std::string, int> specials = source->Specials();
         for (std::map<std::string, int>::const_iterator special_it = specials.begin(); special_it != specials.end(); ++special_it) {
             const Special* special = GetSpecial(special_it->first);
             if (!special) {
@@ -1117,12 +1216,12 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes, const
         {
             // find alternate object owned by this empire to act as source
             // first try to get a planet
-            std::vector<int> empire_planets = m_objects.FindObjectIDs(OwnedVisitor<Planet>(empire->EmpireID()));
+            const std::set<int>& empire_planets = m_objects.OwnedObjectIDs(empire->EmpireID(), OBJ_PLANET);
             if (!empire_planets.empty()) {
                 source_id = *empire_planets.begin();
             } else {
                 // if no planet, use any owned object
-                std::vector<int> empire_objects = m_objects.FindObjectIDs(OwnedVisitor<UniverseObject>(empire->EmpireID()));
+                std::vector<int> empire_objects = m_objects.FindOwnedObjectIDs(empire->EmpireID());
                 if (!empire_objects.empty()) {
                     source_id = *empire_objects.begin();
                 } else {
@@ -1182,11 +1281,11 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes, const
                                              all_potential_targets, targets_causes);
 
         const std::vector<std::string>& parts = ship_design->Parts();
-        for (std::vector<std::string>::const_iterator part_it = parts.begin(); part_it != parts.end(); ++part_it) {
-            const std::string& part = *part_it;
-            if (part.empty())
+        const std::vector<const PartType*>& part_types = ship_design->PartTypes();
+        for (std::size_t i = 0; i < parts.size(); ++i) {
+            if (parts[i].empty())
                 continue;
-            const PartType* part_type = GetPartType(*part_it);
+            const PartType* part_type = part_types[i];
             if (!part_type) {
                 Logger().errorStream() << "GetEffectsAndTargets couldn't get PartType";
                 continue;
@@ -1329,25 +1428,12 @@ void Universe::ExecuteEffects(const Effect::TargetsCauses& targets_causes, bool
 namespace {
     /** Sets visibilities for indicated \a empire of object with \a object_id
       * in the passed-in \a empire_vis_map to \a vis */
-    void SetEmpireObjectVisibility(Universe::EmpireObjectVisibilityMap& empire_vis_map,
+    void SetEmpireObjectVisibility(Universe::EmpireVisibilityMap& empire_vis_map,
                                    std::map<int, std::set<int> >& empire_known_design_ids,
                                    int empire_id, int object_id, Visibility vis)
     {
-        // get visibility map for empire and find object in it
-        Universe::ObjectVisibilityMap& vis_map = empire_vis_map[empire_id];
-        Universe::ObjectVisibilityMap::iterator vis_map_it = vis_map.find(object_id);
-
-        // if object not already present, store default value (which may be replaced)
-        if (vis_map_it == vis_map.end()) {
-            vis_map[object_id] = VIS_NO_VISIBILITY;
-
-            // get iterator pointing at newly-created entry
-            vis_map_it = vis_map.find(object_id);
-        }
-
         // increase stored value if new visibility is higher than last recorded
-        if (vis > vis_map_it->second)
-            vis_map_it->second = vis;
+        empire_vis_map[empire_id].RaiseVisibility(object_id, vis);
 
         // if object is a ship, empire also gets knowledge of its design
         if (vis >= VIS_PARTIAL_VISIBILITY) {
@@ -1376,7 +1462,10 @@ void Universe::UpdateEmpireObjectVisibilities() {
     }
 
 
-    m_empire_object_visibility.clear();
+    // forget last turn's visibilities, but keep the turns on which objects
+    // were seen and which objects are known destroyed
+    for (EmpireVisibilityMap::iterator it = m_empire_visibility.begin(); it != m_empire_visibility.end(); ++it)
+        it->second.ClearVisibilities();
 
 
     if (ALL_OBJECTS_VISIBLE) {
@@ -1387,7 +1476,7 @@ void Universe::UpdateEmpireObjectVisibilities() {
 
         for (ObjectMap::const_iterator obj_it = m_objects.const_begin(); obj_it != m_objects.const_end(); ++obj_it)
             for (std::set<int>::const_iterator empire_it = all_empire_ids.begin(); empire_it != all_empire_ids.end(); ++empire_it)
-                SetEmpireObjectVisibility(m_empire_object_visibility, m_empire_known_ship_design_ids, *empire_it, obj_it->first, VIS_FULL_VISIBILITY);
+                SetEmpireObjectVisibility(m_empire_visibility, m_empire_known_ship_design_ids, *empire_it, obj_it->first, VIS_FULL_VISIBILITY);
 
         return;
     }
@@ -1406,7 +1495,7 @@ void Universe::UpdateEmpireObjectVisibilities() {
 
 
         // owner of an object gets full visibility of it
-        SetEmpireObjectVisibility(m_empire_object_visibility, m_empire_known_ship_design_ids,
+        SetEmpireObjectVisibility(m_empire_visibility, m_empire_known_ship_design_ids,
                                   detector->Owner(), detector_id, VIS_FULL_VISIBILITY);
 
 
@@ -1512,12 +1601,37 @@ void Universe::UpdateEmpireObjectVisibilities() {
                 continue;
 
             // if target visible to detector, update visibility of target for detector's owner empire
-            SetEmpireObjectVisibility(m_empire_object_visibility, m_empire_known_ship_design_ids,
+            SetEmpireObjectVisibility(m_empire_visibility, m_empire_known_ship_design_ids,
                                       detector->Owner(), target->ID(), target_visibility_to_detector);
         }
     }
 
 
+    // share detection results with empires that have been granted them.
+    // sharing isn't transitive, so copy from a snapshot of what each empire
+    // detected by itself
+    bool any_sharing = false;
+    for (EmpireManager::const_iterator it1 = Empires().begin(); it1 != Empires().end() && !any_sharing; ++it1)
+        for (EmpireManager::const_iterator it2 = Empires().begin(); it2 != Empires().end() && !any_sharing; ++it2)
+            any_sharing = Empires().SharesVisibility(it1->first, it2->first);
+    if (any_sharing) {
+        const EmpireVisibilityMap detected_visibility = m_empire_visibility;
+        for (EmpireVisibilityMap::const_iterator sharer_it = detected_visibility.begin(); sharer_it != detected_visibility.end(); ++sharer_it) {
+            for (EmpireManager::const_iterator receiver_it = Empires().begin(); receiver_it != Empires().end(); ++receiver_it) {
+                if (!Empires().SharesVisibility(sharer_it->first, receiver_it->first))
+                    continue;
+                const EmpireVisibility& shared_vis = sharer_it->second;
+                for (int object_id = 0; object_id < shared_vis.Size(); ++object_id) {
+                    Visibility vis = shared_vis.GetVisibility(object_id);
+                    if (vis > VIS_NO_VISIBILITY)
+                        SetEmpireObjectVisibility(m_empire_visibility, m_empire_known_ship_design_ids,
+                                                  receiver_it->first, object_id, vis);
+                }
+            }
+        }
+    }
+
+
     // propegate visibility from contained to container objects
     for (ObjectMap::const_iterator container_object_it = m_objects.const_begin(); container_object_it != m_objects.const_end(); ++container_object_it) {
         int container_obj_id = container_object_it->first;
@@ -1545,65 +1659,51 @@ void Universe::UpdateEmpireObjectVisibilities() {
             //Logger().debugStream() << " ... contained object (" << contained_obj_id << ")";
 
             // for each empire with a visibility map
-            for (EmpireObjectVisibilityMap::iterator empire_it = m_empire_object_visibility.begin(); empire_it != m_empire_object_visibility.end(); ++empire_it) {
-                ObjectVisibilityMap& vis_map = empire_it->second;
+            for (EmpireVisibilityMap::iterator empire_it = m_empire_visibility.begin(); empire_it != m_empire_visibility.end(); ++empire_it) {
+                EmpireVisibility& empire_vis = empire_it->second;
 
                 //Logger().debugStream() << " ... ... empire id " << empire_it->first;
 
-                // find current empire's visibility entry for current container object
-                ObjectVisibilityMap::iterator container_vis_it = vis_map.find(container_obj_id);
-                // if no entry yet stored for this object, default to not visible
-                if (container_vis_it == vis_map.end()) {
-                    vis_map[container_obj_id] = VIS_NO_VISIBILITY;
-
-                    // get iterator pointing at newly-created entry
-                    container_vis_it = vis_map.find(container_obj_id);
-                } else {
-                    // check whether having a contained object would change container's visibility
-                    if (container_fleet) {
-                        // special case for fleets: grant partial visibility if
-                        // a contained ship is seen with partial visibility or
-                        // higher visibilitly
-                        if (container_vis_it->second >= VIS_PARTIAL_VISIBILITY)
-                            continue;
-                    } else if (container_vis_it->second >= VIS_BASIC_VISIBILITY) {
-                        // general case: for non-fleets, having visible
-                        // contained object grants basic vis only.  if
-                        // container already has this or better for the current
-                        // empire, don't need to propegate anything
+                // check whether having a contained object would change container's visibility
+                Visibility container_vis = empire_vis.GetVisibility(container_obj_id);
+                if (container_fleet) {
+                    // special case for fleets: grant partial visibility if
+                    // a contained ship is seen with partial visibility or
+                    // higher visibilitly
+                    if (container_vis >= VIS_PARTIAL_VISIBILITY)
                         continue;
-                    }
+                } else if (container_vis >= VIS_BASIC_VISIBILITY) {
+                    // general case: for non-fleets, having visible
+                    // contained object grants basic vis only.  if
+                    // container already has this or better for the current
+                    // empire, don't need to propegate anything
+                    continue;
                 }
 
 
-                // find contained object's entry in visibility map
-                ObjectVisibilityMap::iterator contained_vis_it = vis_map.find(contained_obj_id);
-                if (contained_vis_it != vis_map.end()) {
-                    // get contained object's visibility for current empire
-                    Visibility contained_obj_vis = contained_vis_it->second;
-
-                    // no need to propegate if contained object isn't visible to current empire
-                    if (contained_obj_vis <= VIS_NO_VISIBILITY)
-                        continue;
+                // get contained object's visibility for current empire
+                Visibility contained_obj_vis = empire_vis.GetVisibility(contained_obj_id);
 
-                    //Logger().debugStream() << " ... ... contained object vis: " << contained_obj_vis;
-
-                    // contained object is at least basically visible.
-                    // container should be at least partially visible, but don't
-                    // want to decrease visibility of container if it is already
-                    // higher than partially visible
-                    if (container_vis_it->second < VIS_BASIC_VISIBILITY)
-                        container_vis_it->second = VIS_BASIC_VISIBILITY;
+                // no need to propegate if contained object isn't visible to current empire
+                if (contained_obj_vis <= VIS_NO_VISIBILITY)
+                    continue;
 
-                    // special case for fleets: grant partial visibility if
-                    // visible contained object is partially or better visible
-                    // this way fleet ownership is known to players who can 
-                    // see ships with partial or better visibility (and thus
-                    // know the owner of the ships and thus should know the
-                    // owners of the fleet)
-                    if (container_fleet && contained_obj_vis >= VIS_PARTIAL_VISIBILITY && container_vis_it->second < VIS_PARTIAL_VISIBILITY)
-                        container_vis_it->second = VIS_PARTIAL_VISIBILITY;
-                }
+                //Logger().debugStream() << " ... ... contained object vis: " << contained_obj_vis;
+
+                // contained object is at least basically visible.
+                // container should be at least partially visible, but don't
+                // want to decrease visibility of container if it is already
+                // higher than partially visible
+                empire_vis.RaiseVisibility(container_obj_id, VIS_BASIC_VISIBILITY);
+
+                // special case for fleets: grant partial visibility if
+                // visible contained object is partially or better visible
+                // this way fleet ownership is known to players who can 
+                // see ships with partial or better visibility (and thus
+                // know the owner of the ships and thus should know the
+                // owners of the fleet)
+                if (container_fleet && contained_obj_vis >= VIS_PARTIAL_VISIBILITY)
+                    empire_vis.RaiseVisibility(container_obj_id, VIS_PARTIAL_VISIBILITY);
             }   // end for empire visibility entries
         }   // end for contained objects
     }   // end for container objects
@@ -1616,16 +1716,11 @@ void Universe::UpdateEmpireObjectVisibilities() {
         int system_id = system->ID();
 
         // for each empire with a visibility map
-        for (EmpireObjectVisibilityMap::iterator empire_it = m_empire_object_visibility.begin(); empire_it != m_empire_object_visibility.end(); ++empire_it) {
-            ObjectVisibilityMap& vis_map = empire_it->second;
-
-            // find current system's visibility
-            ObjectVisibilityMap::iterator system_vis_it = vis_map.find(system_id);
-            if (system_vis_it == vis_map.end())
-                continue;
+        for (EmpireVisibilityMap::iterator empire_it = m_empire_visibility.begin(); empire_it != m_empire_visibility.end(); ++empire_it) {
+            EmpireVisibility& empire_vis = empire_it->second;
 
             // skip systems that aren't at least partially visible; they can't propegate visibility along starlanes
-            Visibility system_vis = system_vis_it->second;
+            Visibility system_vis = empire_vis.GetVisibility(system_id);
             if (system_vis <= VIS_BASIC_VISIBILITY)
                 continue;
 
@@ -1640,12 +1735,7 @@ void Universe::UpdateEmpireObjectVisibilities() {
                 // map, and upgrade to basic visibility if not already at that
                 // leve, so that starlanes will be visible if either system it
                 // ends at is partially visible or better
-                int lane_end_sys_id = lane_it->first;
-                ObjectVisibilityMap::iterator lane_end_vis_it = vis_map.find(lane_end_sys_id);
-                if (lane_end_vis_it == vis_map.end())
-                    vis_map[lane_end_sys_id] = VIS_BASIC_VISIBILITY;
-                else if (lane_end_vis_it->second < VIS_BASIC_VISIBILITY)
-                    lane_end_vis_it->second = VIS_BASIC_VISIBILITY;
+                empire_vis.RaiseVisibility(lane_it->first, VIS_BASIC_VISIBILITY);
             }
         }
     }
@@ -1666,23 +1756,9 @@ void Universe::UpdateEmpireObjectVisibilities() {
 
             // ensure fleet's owner has at least basic visibility of the next
             // and previous systems on the fleet's path
-            ObjectVisibilityMap& vis_map = m_empire_object_visibility[fleet->Owner()];
-
-            ObjectVisibilityMap::iterator system_vis_it = vis_map.find(prev);
-            if (system_vis_it == vis_map.end()) {
-                vis_map[prev] = VIS_BASIC_VISIBILITY;
-            } else {
-                if (system_vis_it->second < VIS_BASIC_VISIBILITY)
-                    system_vis_it->second = VIS_BASIC_VISIBILITY;
-            }
-
-            system_vis_it = vis_map.find(next);
-            if (system_vis_it == vis_map.end()) {
-                vis_map[next] = VIS_BASIC_VISIBILITY;
-            } else {
-                if (system_vis_it->second < VIS_BASIC_VISIBILITY)
-                    system_vis_it->second = VIS_BASIC_VISIBILITY;
-            }
+            EmpireVisibility& empire_vis = m_empire_visibility[fleet->Owner()];
+            empire_vis.RaiseVisibility(prev, VIS_BASIC_VISIBILITY);
+            empire_vis.RaiseVisibility(next, VIS_BASIC_VISIBILITY);
         }
     }
 }
@@ -1691,7 +1767,7 @@ void Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns()
 {
     //Logger().debugStream() << "Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns()";
 
-    // assumes m_empire_object_visibility has been updated
+    // assumes m_empire_visibility has been updated
 
     //  for each object in universe
     //      for each empire that can see object this turn
@@ -1711,16 +1787,14 @@ void Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns()
             Logger().errorStream() << "UpdateEmpireLatestKnownObjectsAndVisibilityTurns found null object in m_objects with id " << object_id;
             continue;
         }
+        bool is_system = universe_object_cast<const System*>(full_object) != 0;
 
         // for each empire with a visibility map
-        for (EmpireObjectVisibilityMap::const_iterator empire_it = m_empire_object_visibility.begin(); empire_it != m_empire_object_visibility.end(); ++empire_it) {
+        for (EmpireVisibilityMap::iterator empire_it = m_empire_visibility.begin(); empire_it != m_empire_visibility.end(); ++empire_it) {
 
             // can empire see object?
-            const ObjectVisibilityMap& vis_map = empire_it->second;    // stores level of visibility empire has for each object it can detect this turn
-            ObjectVisibilityMap::const_iterator vis_it = vis_map.find(object_id);
-            if (vis_it == vis_map.end())
-                continue;   // empire can't see current object, so move to next empire
-            const Visibility vis = vis_it->second;
+            EmpireVisibility& empire_vis = empire_it->second;   // stores level of visibility empire has for each object it can detect this turn
+            const Visibility vis = empire_vis.GetVisibility(object_id);
             if (vis <= VIS_NO_VISIBILITY)
                 continue;   // empire can't see current object, so move to next empire
 
@@ -1731,31 +1805,32 @@ void Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns()
             int empire_id = empire_it->first;
 
             ObjectMap&                  known_object_map = m_empire_latest_known_objects[empire_id];        // creates empty map if none yet present
-            ObjectVisibilityTurnMap&    object_vis_turn_map = m_empire_object_visibility_turns[empire_id];  // creates empty map if none yet present
-            VisibilityTurnMap&          vis_turn_map = object_vis_turn_map[object_id];                      // creates empty map if none yet present
 
 
             // update empire's latest known data about object, based on current visibility and historical visibility and knowledge of object
 
-            // is there already last known version of an UniverseObject stored for this empire?
-            if (UniverseObject* known_obj = known_object_map.Object(object_id)) {
-                known_obj->Copy(full_object, empire_id);                    // already a stored version of this object for this empire.  update it, limited by visibility this empire has for this object this turn
+            // updates a stored version of this object for this empire, or
+            // creates one if there is none, limited by the visibility this
+            // empire has for this object this turn.  the starlanes an empire
+            // knows of only change when those of its known systems do
+            if (is_system) {
+                const System* known_system = known_object_map.Object<System>(object_id);
+                System::StarlaneMap known_lanes;
+                if (known_system)
+                    known_lanes = known_system->StarlanesWormholes();
+                known_object_map.Copy(full_object, empire_id);
+                known_system = known_object_map.Object<System>(object_id);
+                if (!known_system || known_system->StarlanesWormholes() != known_lanes)
+                    InvalidateEmpireKnownStarlanes(empire_id);
             } else {
-                if (UniverseObject* new_obj = full_object->Clone(empire_id))    // no previously-recorded version of this object for this empire.  create a new one, copying only the information limtied by visibility, leaving the rest as default values
-                    known_object_map.Insert(object_id, new_obj);
+                known_object_map.Copy(full_object, empire_id);
             }
 
             //Logger().debugStream() << "Empire " << empire_id << " can see object " << object_id << " with vis level " << vis;
 
             // update empire's visibility turn history for current vis, and lesser vis levels
             if (vis >= VIS_BASIC_VISIBILITY) {
-                vis_turn_map[VIS_BASIC_VISIBILITY] = current_turn;
-                if (vis >= VIS_PARTIAL_VISIBILITY) {
-                    vis_turn_map[VIS_PARTIAL_VISIBILITY] = current_turn;
-                    if (vis >= VIS_FULL_VISIBILITY) {
-                        vis_turn_map[VIS_FULL_VISIBILITY] = current_turn;
-                    }
-                }
+                empire_vis.SetVisibilityTurns(object_id, vis, current_turn);
                 //Logger().debugStream() << " ... Setting empire " << empire_id << " object " << full_object->Name() << " (" << object_id << ") vis " << vis << " (and higher) turn to " << current_turn;
             } else {
                 Logger().errorStream() << "Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() found invalid visibility for object with id " << object_id << " by empire with id " << empire_id;
@@ -1776,7 +1851,7 @@ void Universe::SetEmpireKnowledgeOfDestroyedObject(int object_id, int empire_id)
     if (!empire) {
         Logger().errorStream() << "SetEmpireKnowledgeOfDestroyedObject called for invalid empire id: " << empire_id;
     }
-    m_empire_known_destroyed_object_ids[empire_id].insert(object_id);
+    m_empire_visibility[empire_id].SetKnownDestroyed(object_id);
 }
 
 void Universe::SetEmpireKnowledgeOfShipDesign(int ship_design_id, int empire_id) {
@@ -1906,6 +1981,8 @@ void Universe::InitializeSystemGraph(int for_empire_id)
     typedef boost::graph_traits<GraphImpl::SystemGraph>::edge_descriptor EdgeDescriptor;
     const ObjectMap& objects = EmpireKnownObjects(for_empire_id);
 
+    InvalidateEmpireKnownStarlanes();   // graph indices are about to change
+
     for (int i = static_cast<int>(boost::num_vertices(m_graph_impl->system_graph)) - 1; i >= 0; --i) {
         boost::clear_vertex(i, m_graph_impl->system_graph);
         boost::remove_vertex(i, m_graph_impl->system_graph);
@@ -1990,6 +2067,7 @@ void Universe::InitializeSystemGraph(int for_empire_id)
 
 void Universe::RebuildEmpireViewSystemGraphs(int for_empire_id)
 {
+    ++m_system_graph_version;
     m_graph_impl->empire_system_graph_views.clear();
 
     // if building system graph views for all empires, then each empire's graph
@@ -2005,14 +2083,16 @@ void Universe::RebuildEmpireViewSystemGraphs(int for_empire_id)
         // all empires get their own, accurately filtered graph
         for (EmpireManager::const_iterator it = Empires().begin(); it != Empires().end(); ++it) {
             int empire_id = it->first;
-            GraphImpl::EdgeVisibilityFilter filter(&m_graph_impl->system_graph, empire_id);
+            GraphImpl::EdgeVisibilityFilter filter(&m_graph_impl->system_graph, empire_id,
+                                                   m_graph_impl->EmpireKnownStarlanes(empire_id));
             boost::shared_ptr<GraphImpl::EmpireViewSystemGraph> filtered_graph_ptr(new GraphImpl::EmpireViewSystemGraph(m_graph_impl->system_graph, filter));
             m_graph_impl->empire_system_graph_views[empire_id] = filtered_graph_ptr;
         }
 
     } else {
         // all empires share a single filtered graph, filtered by the for_empire_id
-        GraphImpl::EdgeVisibilityFilter filter(&m_graph_impl->system_graph, for_empire_id);
+        GraphImpl::EdgeVisibilityFilter filter(&m_graph_impl->system_graph, for_empire_id,
+                                               m_graph_impl->EmpireKnownStarlanes(for_empire_id));
         boost::shared_ptr<GraphImpl::EmpireViewSystemGraph> filtered_graph_ptr(new GraphImpl::EmpireViewSystemGraph(m_graph_impl->system_graph, filter));
 
         for (EmpireManager::const_iterator it = Empires().begin(); it != Empires().end(); ++it) {
@@ -2022,14 +2102,76 @@ void Universe::RebuildEmpireViewSystemGraphs(int for_empire_id)
     }
 }
 
+void Universe::PrecomputeEmpireKnownStarlanes()
+{
+    int num_systems = static_cast<int>(boost::num_vertices(m_graph_impl->system_graph));
+    GraphImpl::ConstSystemIDPropertyMap sys_id_property_map =
+        boost::get(vertex_system_id_t(), const_cast<const GraphImpl::SystemGraph&>(m_graph_impl->system_graph));
+
+    for (EmpireManager::const_iterator empire_it = Empires().begin(); empire_it != Empires().end(); ++empire_it) {
+        int empire_id = empire_it->first;
+        GraphImpl::KnownStarlanes& known_starlanes = *m_graph_impl->EmpireKnownStarlanes(empire_id);
+        if (known_starlanes.valid)
+            continue;   // nothing it depends on has changed since it was last computed
+        ++m_system_graph_version;
+
+        const ObjectMap& known_objects = EmpireKnownObjects(empire_id);
+        known_starlanes.lanes.clear();
+        known_starlanes.lanes.resize(num_systems);
+
+        for (int i = 0; i < num_systems; ++i) {
+            const System* system = known_objects.Object<System>(sys_id_property_map[i]);
+            if (!system)
+                continue;
+            for (System::const_lane_iterator lane_it = system->begin_lanes(); lane_it != system->end_lanes(); ++lane_it) {
+                boost::unordered_map<int, int>::const_iterator index_it = m_system_id_to_graph_index.find(lane_it->first);
+                if (index_it != m_system_id_to_graph_index.end())
+                    known_starlanes.lanes[i].push_back(index_it->second);
+            }
+        }
+
+        known_starlanes.valid = true;
+    }
+}
+
+void Universe::InvalidateEmpireKnownStarlanes()
+{
+    ++m_system_graph_version;
+    for (GraphImpl::EmpireKnownStarlanesMap::iterator it = m_graph_impl->empire_known_starlanes.begin();
+         it != m_graph_impl->empire_known_starlanes.end(); ++it)
+    {
+        it->second->valid = false;
+        std::vector<std::vector<int> >().swap(it->second->lanes);
+    }
+}
+
+void Universe::InvalidateEmpireKnownStarlanes(int empire_id)
+{
+    GraphImpl::EmpireKnownStarlanesMap::iterator it = m_graph_impl->empire_known_starlanes.find(empire_id);
+    if (it == m_graph_impl->empire_known_starlanes.end() || !it->second->valid)
+        return;
+    ++m_system_graph_version;
+    it->second->valid = false;
+    std::vector<std::vector<int> >().swap(it->second->lanes);
+}
+
 double Universe::UniverseWidth()
-{ return s_universe_width; }
+{ return GameContext::Current().m_universe_width; }
+
+void Universe::SetUniverseWidth(double width)
+{ GameContext::Current().m_universe_width = width; }
 
 const bool& Universe::UniverseObjectSignalsInhibited()
-{ return s_inhibit_universe_object_signals; }
+{ return GameContext::Current().m_inhibit_universe_object_signals; }
 
 void Universe::InhibitUniverseObjectSignals(bool inhibit)
-{ s_inhibit_universe_object_signals = inhibit; }
+{ GameContext::Current().m_inhibit_universe_object_signals = inhibit; }
+
+int Universe::EncodingEmpire()
+{ return GameContext::Current().m_encoding_empire; }
+
+void Universe::SetEncodingEmpire(int empire_id)
+{ GameContext::Current().m_encoding_empire = empire_id; }
 
 void Universe::GetShipDesignsToSerialize(ShipDesignMap& designs_to_serialize, int encoding_empire) const
 {
@@ -2131,53 +2273,76 @@ void Universe::GetEmpireKnownObjectsToSerialize(EmpireObjectMap& empire_latest_k
 
 void Universe::GetEmpireObjectVisibilityMap(EmpireObjectVisibilityMap& empire_object_visibility, int encoding_empire) const
 {
-    if (encoding_empire == ALL_EMPIRES) {
-        empire_object_visibility = m_empire_object_visibility;
-        return;
-    }
-
-    // include just requested empire's visibility for each object it has better
-    // than no visibility of.  TODO: include what requested empire knows about
+    // include each empire's visibility for each object it has better than no
+    // visibility of, or just the requested empire's visibility of objects
+    // that still exist.  TODO: include what requested empire knows about
     // other empires' visibilites of objects
     empire_object_visibility.clear();
-    for (ObjectMap::const_iterator it = m_objects.const_begin(); it != m_objects.const_end(); ++it) {
-        int object_id = it->first;
-        Visibility vis = GetObjectVisibilityByEmpire(object_id, encoding_empire);
-        if (vis > VIS_NO_VISIBILITY)
-            empire_object_visibility[encoding_empire][object_id] = vis;
+    for (EmpireVisibilityMap::const_iterator empire_it = m_empire_visibility.begin(); empire_it != m_empire_visibility.end(); ++empire_it) {
+        if (encoding_empire != ALL_EMPIRES && empire_it->first != encoding_empire)
+            continue;
+        const EmpireVisibility& empire_vis = empire_it->second;
+        for (int object_id = 0; object_id < empire_vis.Size(); ++object_id) {
+            Visibility vis = empire_vis.GetVisibility(object_id);
+            if (vis > VIS_NO_VISIBILITY && (encoding_empire == ALL_EMPIRES || m_objects.Object(object_id)))
+                empire_object_visibility[empire_it->first][object_id] = vis;
+        }
     }
 }
 
 void Universe::GetEmpireObjectVisibilityTurnMap(EmpireObjectVisibilityTurnMap& empire_object_visibility_turns, int encoding_empire) const
 {
-    if (encoding_empire == ALL_EMPIRES) {
-        empire_object_visibility_turns = m_empire_object_visibility_turns;
-        return;
-    }
-
-    // include just requested empire's visibility turn information
+    // include all empires' or just requested empire's visibility turn information
     empire_object_visibility_turns.clear();
-    EmpireObjectVisibilityTurnMap::const_iterator it = m_empire_object_visibility_turns.find(encoding_empire);
-    if (it != m_empire_object_visibility_turns.end())
-        empire_object_visibility_turns[encoding_empire] = it->second;
+    for (EmpireVisibilityMap::const_iterator empire_it = m_empire_visibility.begin(); empire_it != m_empire_visibility.end(); ++empire_it) {
+        if (encoding_empire != ALL_EMPIRES && empire_it->first != encoding_empire)
+            continue;
+        const EmpireVisibility& empire_vis = empire_it->second;
+        for (int object_id = 0; object_id < empire_vis.Size(); ++object_id) {
+            VisibilityTurnMap vis_turns = empire_vis.VisibilityTurns(object_id);
+            if (!vis_turns.empty())
+                empire_object_visibility_turns[empire_it->first][object_id].swap(vis_turns);
+        }
+    }
 }
 
 void Universe::GetEmpireKnownDestroyedObjects(ObjectKnowledgeMap& empire_known_destroyed_object_ids, int encoding_empire) const
 {
-    if (&empire_known_destroyed_object_ids == &m_empire_known_destroyed_object_ids)
-        return;
+    // copy info about what all empires or just the encoding empire know
+    empire_known_destroyed_object_ids.clear();
+    for (EmpireVisibilityMap::const_iterator empire_it = m_empire_visibility.begin(); empire_it != m_empire_visibility.end(); ++empire_it) {
+        if (encoding_empire != ALL_EMPIRES && empire_it->first != encoding_empire)
+            continue;
+        std::set<int> destroyed_object_ids = empire_it->second.KnownDestroyedObjectIDs();
+        if (!destroyed_object_ids.empty())
+            empire_known_destroyed_object_ids[empire_it->first].swap(destroyed_object_ids);
+    }
+}
 
-    if (encoding_empire == ALL_EMPIRES) {
-        empire_known_destroyed_object_ids = m_empire_known_destroyed_object_ids;
-        return;
+void Universe::SetEmpireVisibility(const EmpireObjectVisibilityMap& empire_object_visibility,
+                                   const EmpireObjectVisibilityTurnMap& empire_object_visibility_turns,
+                                   const ObjectKnowledgeMap& empire_known_destroyed_object_ids)
+{
+    m_empire_visibility.clear();
+
+    for (EmpireObjectVisibilityMap::const_iterator empire_it = empire_object_visibility.begin(); empire_it != empire_object_visibility.end(); ++empire_it) {
+        EmpireVisibility& empire_vis = m_empire_visibility[empire_it->first];
+        for (ObjectVisibilityMap::const_iterator it = empire_it->second.begin(); it != empire_it->second.end(); ++it)
+            empire_vis.RaiseVisibility(it->first, it->second);
     }
 
-    empire_known_destroyed_object_ids.clear();
+    for (EmpireObjectVisibilityTurnMap::const_iterator empire_it = empire_object_visibility_turns.begin(); empire_it != empire_object_visibility_turns.end(); ++empire_it) {
+        EmpireVisibility& empire_vis = m_empire_visibility[empire_it->first];
+        for (ObjectVisibilityTurnMap::const_iterator object_it = empire_it->second.begin(); object_it != empire_it->second.end(); ++object_it)
+            for (VisibilityTurnMap::const_iterator it = object_it->second.begin(); it != object_it->second.end(); ++it)
+                empire_vis.SetVisibilityTurn(object_it->first, it->first, it->second);
+    }
 
-    // copy info about what encoding empire knows
-    ObjectKnowledgeMap::const_iterator it = m_empire_known_destroyed_object_ids.find(encoding_empire);
-    if (it != m_empire_known_destroyed_object_ids.end())
-        empire_known_destroyed_object_ids[encoding_empire] = it->second;
+    for (ObjectKnowledgeMap::const_iterator empire_it = empire_known_destroyed_object_ids.begin(); empire_it != empire_known_destroyed_object_ids.end(); ++empire_it) {
+        EmpireVisibility& empire_vis = m_empire_visibility[empire_it->first];
+        for (std::set<int>::const_iterator it = empire_it->second.begin(); it != empire_it->second.end(); ++it)
+            empire_vis.SetKnownDestroyed(*it);
+    }
 }
 
 ///////////////////////////////////////////////////////////
@@ -5,6 +5,7 @@
 #include "Enums.h"
 #include "Predicates.h"
 #include "EffectAccounting.h"
+#include "EmpireVisibility.h"
 #include "ObjectMap.h"
 #include "../util/AppInterface.h"
 
@@ -36,6 +37,7 @@ class XMLElement;
 class ShipDesign;
 class UniverseObject;
 class System;
+class MemoryReport;
 namespace Condition {
     struct ConditionBase;
     typedef std::vector<const UniverseObject*> ObjectSet;
@@ -57,7 +59,7 @@ private:
     typedef std::map<int, ObjectMap>                EmpireObjectMap;                ///< Known information each empire had about objects in the Universe; keyed by empire id
 
 public:
-    typedef std::map<Visibility, int>               VisibilityTurnMap;              ///< Most recent turn number on which a something, such as a Universe object, was observed at various Visibility ratings or better
+    typedef EmpireVisibility::VisibilityTurnMap     VisibilityTurnMap;              ///< Most recent turn number on which a something, such as a Universe object, was observed at various Visibility ratings or better
 
 private:
     typedef std::map<int, VisibilityTurnMap>        ObjectVisibilityTurnMap;        ///< Most recent turn number on which the objects were observed at various Visibility ratings; keyed by object id
@@ -70,6 +72,7 @@ public:
 
     typedef std::map<int, Visibility>               ObjectVisibilityMap;            ///< map from object id to Visibility level for a particular empire
     typedef std::map<int, ObjectVisibilityMap>      EmpireObjectVisibilityMap;      ///< map from empire id to ObjectVisibilityMap for that empire
+    typedef std::map<int, EmpireVisibility>         EmpireVisibilityMap;            ///< map from empire id to visibilities of objects for that empire
 
     typedef std::map<int, ShipDesign*>              ShipDesignMap;                  ///< ShipDesigns in universe; keyed by design id
     typedef ShipDesignMap::const_iterator           ship_design_iterator;           ///< const iterator over ship designs created by players that are known by this client
@@ -105,7 +108,11 @@ public:
       * last known information about each object, whether it has been destroyed
       * or not.  If \a empire_id = ALL_EMPIRES an empty set of IDs is
       * returned. */
-    const std::set<int>&    EmpireKnownDestroyedObjectIDs(int empire_id) const;
+    std::set<int>           EmpireKnownDestroyedObjectIDs(int empire_id) const;
+
+    /** Returns true iff the Empire with id \a empire_id knows the object with
+      * id \a object_id has been destroyed. */
+    bool                    EmpireKnowsObjectDestroyed(int object_id, int empire_id) const;
 
     const ShipDesign*       GetShipDesign(int ship_design_id) const;                        ///< returns the ship design with id \a ship_design id, or 0 if non exists
     ship_design_iterator    beginShipDesigns() const   {return m_ship_designs.begin();}     ///< returns the begin iterator for ship designs
@@ -128,7 +135,12 @@ public:
       * UniverseObject with id \a object_id .  The returned map may be empty or
       * not have entries for all visibility levels, if the empire has not seen
       * the object at that visibility level yet. */
-    const VisibilityTurnMap&GetObjectVisibilityTurnMapByEmpire(int object_id, int empire_id) const;
+    VisibilityTurnMap       GetObjectVisibilityTurnMapByEmpire(int object_id, int empire_id) const;
+
+    /** Returns the turn number on which the empire with id \a empire_id last
+      * had Visibility \a vis or better of the UniverseObject with id
+      * \a object_id, or INVALID_GAME_TURN if it never has. */
+    int                     GetObjectVisibilityTurnByEmpire(int object_id, int empire_id, Visibility vis) const;
 
     /** Returns the straight-line distance between the systems with the given
       * IDs. \throw std::out_of_range This function will throw if either system
@@ -191,6 +203,11 @@ public:
       * ID is out of range. */
     std::map<double, int>   ImmediateNeighbors(int system_id, int empire_id = ALL_EMPIRES) const;
 
+    /** Returns a number that changes whenever the system graph, the empires'
+      * views of it or the starlanes they know of are rebuilt, so that routes calculated on them can
+      * be cached until then. */
+    int                     SystemGraphVersion() const { return m_system_graph_version; }
+
     /** Returns map, indexed by object id, to map, indexed by MeterType,
       * to vector of EffectAccountInfo for the meter, in order effects
       * were applied to the meter. */
@@ -200,6 +217,11 @@ public:
       * to grant their owners victory. */
     const std::multimap<int, std::string>&  GetMarkedForVictory() const {return m_marked_for_victory;}
 
+    /** Adds estimates of the memory used by the objects, each empire's latest
+      * known objects, visibility, effects accounting, system distance matrices
+      * and ship designs in this Universe to \a report. */
+    void                    GetMemoryReport(MemoryReport& report) const;
+
     mutable UniverseObjectDeleteSignalType UniverseObjectDeleteSignal; ///< the state changed signal object for this UniverseObject
     //@}
 
@@ -298,6 +320,25 @@ public:
       * routes based on visibility. */
     void            RebuildEmpireViewSystemGraphs(int for_empire_id = ALL_EMPIRES);
 
+    /** Determines which starlanes each empire knows of, so that routes on the
+      * empires' views of the system graph can be calculated without looking
+      * up the empires' latest known systems for every starlane considered.
+      * The server does this while it waits for players' orders.  An empire's
+      * results are discarded when the starlanes of its latest known systems
+      * or the system graph change, after which its views fall back to looking
+      * up systems until this is called again.  Only the empires whose results
+      * were discarded are recomputed. */
+    void            PrecomputeEmpireKnownStarlanes();
+
+    /** Discards the results of PrecomputeEmpireKnownStarlanes().  Must be
+      * called after changing empires' latest known objects other than with
+      * UpdateEmpireLatestKnownObjectsAndVisibilityTurns(). */
+    void            InvalidateEmpireKnownStarlanes();
+
+    /** Discards the results of PrecomputeEmpireKnownStarlanes() for the
+      * empire with id \a empire_id. */
+    void            InvalidateEmpireKnownStarlanes(int empire_id);
+
     /** Adds the object ID \a object_id to the set of object ids for the empire
       * with id \a empire_id that the empire knows have been destroyed. */
     void            SetEmpireKnowledgeOfDestroyedObject(int object_id, int empire_id);
@@ -349,6 +390,9 @@ public:
       * depending on universe size. */
     static double   UniverseWidth();
 
+    /** Sets the size of the galaxy map of the active game. */
+    static void     SetUniverseWidth(double width);
+
     /** Generates an object ID for a future object. Usually used by the server
       * to service new ID requests. */
     int             GenerateObjectID() { return ++m_last_allocated_object_id; }
@@ -366,8 +410,12 @@ public:
       * Universe, so that only the relevant parts of the Universe are
       * serialized.  The use of this global variable is done just so I don't
       * have to rewrite any custom boost::serialization classes that implement
-      * empire-dependent visibility. */
-    static int                      s_encoding_empire;
+      * empire-dependent visibility.  The value is kept in the active game's
+      * GameContext, so that games can be serialized concurrently. */
+    static int      EncodingEmpire();
+
+    /** Sets the empire returned by EncodingEmpire(). */
+    static void     SetEncodingEmpire(int empire_id);
 
 private:
     template <typename T>
@@ -410,6 +458,10 @@ private:
         void resize(std::size_t rows, std::size_t columns)
         { m_m.resize(rows, columns); }
 
+        /** Returns the bytes allocated for the lower triangle of the matrix. */
+        std::size_t MemoryUsage() const
+        { return m_m.size1() * (m_m.size1() + 1) / 2 * sizeof(T); }
+
     private:
         storage_type m_m;
     };
@@ -490,10 +542,7 @@ private:
     ObjectMap                       m_objects;                          ///< map from object id to UniverseObjects in the universe.  for the server: all of them, up to date and true information about object is stored;  for clients, only limited information based on what the client knows about is sent.
     EmpireObjectMap                 m_empire_latest_known_objects;      ///< map from empire id to (map from object id to latest known information about each object by that empire)
 
-    EmpireObjectVisibilityMap       m_empire_object_visibility;         ///< map from empire id to (map from object id to visibility of that object for that empire)
-    EmpireObjectVisibilityTurnMap   m_empire_object_visibility_turns;   ///< map from empire id to (map from object id to (map from Visibility rating to turn number on which the empire last saw the object at the indicated Visibility rating or higher)
-
-    ObjectKnowledgeMap              m_empire_known_destroyed_object_ids;///< map from empire id to (set of object ids that the empire knows have been destroyed)
+    EmpireVisibilityMap             m_empire_visibility;                ///< map from empire id to that empire's visibility of each object, the turns on which it last saw each object at each Visibility rating or higher, and the objects it knows have been destroyed
 
     ShipDesignMap                   m_ship_designs;                     ///< ship designs in the universe
     std::map<int, std::set<int> >   m_empire_known_ship_design_ids;     ///< ship designs known to each empire
@@ -502,6 +551,7 @@ private:
     JumpsMatrix                     m_system_jumps;                     ///< the least-jumps distances between all the systems
     GraphImpl*                      m_graph_impl;                       ///< a graph in which the systems are vertices and the starlanes are edges
     boost::unordered_map<int, int>  m_system_id_to_graph_index;
+    int                             m_system_graph_version;             ///< see SystemGraphVersion()
 
     Effect::AccountingMap           m_effect_accounting_map;            ///< map from target object id, to map from target meter, to orderered list of structs with details of an effect and what it does to the meter
     Effect::DiscrepancyMap          m_effect_discrepancy_map;           ///< map from target object id, to map from target meter, to discrepancy between meter's actual initial value, and the initial value that this meter should have as far as the client can tell: the unknown factor affecting the meter
@@ -512,9 +562,6 @@ private:
     std::set<int>                   m_marked_destroyed;                 ///< used while applying effects to cache objects that have been destroyed.  this allows to-be-destroyed objects to remain undestroyed until all effects have been processed, which ensures that to-be-destroyed objects still exist when other effects need to access them as a source object
     std::multimap<int, std::string> m_marked_for_victory;               ///< used while applying effects to cache objects whose owner should be victorious.  Victory testing is done separately from effects execution, so this needs to be stored temporarily...
 
-    static double                   s_universe_width;
-    static bool                     s_inhibit_universe_object_signals;
-
     /** Fills \a designs_to_serialize with ShipDesigns known to the empire with
       * the ID \a encoding empire.  If encoding_empire is ALL_EMPIRES, then all
       * designs are included. */
@@ -539,6 +586,12 @@ private:
     /***/
     void    GetEmpireKnownDestroyedObjects(ObjectKnowledgeMap& m_empire_known_destroyed_object_ids, int encoding_empire) const;
 
+    /** Replaces m_empire_visibility with the contents of the maps filled by the
+      * above three functions. */
+    void    SetEmpireVisibility(const EmpireObjectVisibilityMap& empire_object_visibility,
+                                const EmpireObjectVisibilityTurnMap& empire_object_visibility_turns,
+                                const ObjectKnowledgeMap& empire_known_destroyed_object_ids);
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -7,7 +7,10 @@
 #include "Special.h"
 #include "Universe.h"
 #include "Predicates.h"
+#include "MemoryReport.h"
 
+#include <algorithm>
+#include <climits>
 #include <stdexcept>
 
 
@@ -76,19 +79,15 @@ void UniverseObject::Copy(const UniverseObject* copied_object, Visibility vis)
         return;
     }
 
-    std::map<MeterType, Meter> censored_meters = copied_object->CensoredMeters(vis);
-    for (std::map<MeterType, Meter>::const_iterator it = copied_object->m_meters.begin();
+    for (MeterMap::const_iterator it = copied_object->m_meters.begin();
          it != copied_object->m_meters.end(); ++it)
     {
-        MeterType type = it->first;
-
         // get existing meter in this object, or create a default one
-        Meter& this_meter = this->m_meters[type];
+        Meter& this_meter = this->m_meters[it->first];
 
-        // if there is an update to meter from censored meters, update this object's copy
-        std::map<MeterType, Meter>::const_iterator censored_it = censored_meters.find(type);
-        if (censored_it != censored_meters.end())
-            this_meter = censored_it->second;
+        // meters are censored below partial visibility
+        if (vis >= VIS_PARTIAL_VISIBILITY)
+            this_meter = it->second;
     }
 
     if (vis >= VIS_BASIC_VISIBILITY) {
@@ -100,11 +99,11 @@ void UniverseObject::Copy(const UniverseObject* copied_object, Visibility vis)
         if (vis >= VIS_PARTIAL_VISIBILITY) {
 
             this->m_owner_empire_id =   copied_object->m_owner_empire_id;
-            this->m_specials =          copied_object->m_specials;
+            CopyIfChanged(this->m_specials, copied_object->m_specials);
             this->m_created_on_turn =   copied_object->m_created_on_turn;
 
             if (vis >= VIS_FULL_VISIBILITY) {
-                this->m_name =          copied_object->m_name;
+                CopyIfChanged(this->m_name, copied_object->m_name);
             }
         }
     }
@@ -143,16 +142,35 @@ int UniverseObject::Owner() const
 int UniverseObject::SystemID() const
 { return m_system_id; }
 
-const std::map<std::string, int>& UniverseObject::Specials() const
+std::map<std::string, int> UniverseObject::Specials() const
+{
+    std::map<std::string, int> retval;
+    for (SpecialList::const_iterator it = m_specials.begin(); it != m_specials.end(); ++it)
+        retval[SpecialName(it->first)] = it->second;
+    return retval;
+}
+
+const UniverseObject::SpecialList& UniverseObject::SpecialIDs() const
 { return m_specials; }
 
 bool UniverseObject::HasSpecial(const std::string& name) const
-{ return m_specials.find(name) != m_specials.end(); }
+{ return !m_specials.empty() && HasSpecial(FindSpecialID(name)); }
+
+bool UniverseObject::HasSpecial(int special_id) const
+{
+    SpecialList::const_iterator it = std::lower_bound(m_specials.begin(), m_specials.end(),
+                                                      std::make_pair(special_id, INT_MIN));
+    return it != m_specials.end() && it->first == special_id;
+}
 
 int UniverseObject::SpecialAddedOnTurn(const std::string& name) const
+{ return m_specials.empty() ? INVALID_GAME_TURN : SpecialAddedOnTurn(FindSpecialID(name)); }
+
+int UniverseObject::SpecialAddedOnTurn(int special_id) const
 {
-    std::map<std::string, int>::const_iterator it = m_specials.find(name);
-    if (it == m_specials.end())
+    SpecialList::const_iterator it = std::lower_bound(m_specials.begin(), m_specials.end(),
+                                                      std::make_pair(special_id, INT_MIN));
+    if (it == m_specials.end() || it->first != special_id)
         return INVALID_GAME_TURN;
     return it->second;
 }
@@ -160,6 +178,18 @@ int UniverseObject::SpecialAddedOnTurn(const std::string& name) const
 const std::string& UniverseObject::TypeName() const
 { return UserString("UNIVERSEOBJECT"); }
 
+std::size_t UniverseObject::MemoryUsage() const
+{ return sizeof(UniverseObject) + AllocatedMemory(); }
+
+bool UniverseObject::ObjectVisible(int object_id, int empire_id)
+{ return GetUniverse().GetObjectVisibilityByEmpire(object_id, empire_id) >= VIS_BASIC_VISIBILITY; }
+
+std::size_t UniverseObject::AllocatedMemory() const
+{
+    return MemoryEstimate::Bytes(m_name) + MemoryEstimate::Bytes(m_specials) +
+           m_meters.size() * (sizeof(MeterMap::value_type) + MemoryEstimate::TREE_NODE_OVERHEAD);
+}
+
 std::string UniverseObject::Dump() const
 {
     const System* system = GetMainObjectMap().Object<System>(this->SystemID());
@@ -173,10 +203,10 @@ std::string UniverseObject::Dump() const
        << " owner: " << m_owner_empire_id
        << " created on turn: " << m_created_on_turn
        << " specials: ";
-    for (std::map<std::string, int>::const_iterator it = m_specials.begin(); it != m_specials.end(); ++it)
-        os << "(" << it->first << ", " << it->second << ") ";
+    for (SpecialList::const_iterator it = m_specials.begin(); it != m_specials.end(); ++it)
+        os << "(" << SpecialName(it->first) << ", " << it->second << ") ";
     os << "  Meters: ";
-    for (std::map<MeterType, Meter>::const_iterator it = m_meters.begin(); it != m_meters.end(); ++it)
+    for (MeterMap::const_iterator it = m_meters.begin(); it != m_meters.end(); ++it)
         os << UserString(GG::GetEnumMap<MeterType>().FromEnum(it->first))
            << ": " << it->second.Current() << "  ";
     return os.str();
@@ -199,7 +229,7 @@ bool UniverseObject::ContainedBy(int object_id) const
 
 const Meter* UniverseObject::GetMeter(MeterType type) const
 {
-    std::map<MeterType, Meter>::const_iterator it = m_meters.find(type);
+    MeterMap::const_iterator it = m_meters.find(type);
     if (it != m_meters.end())
         return &(it->second);
     return 0;
@@ -207,7 +237,7 @@ const Meter* UniverseObject::GetMeter(MeterType type) const
 
 double UniverseObject::CurrentMeterValue(MeterType type) const
 {
-    std::map<MeterType, Meter>::const_iterator it = m_meters.find(type);
+    MeterMap::const_iterator it = m_meters.find(type);
     if (it == m_meters.end())
         throw std::invalid_argument("UniverseObject::CurrentMeterValue was passed a MeterType that this UniverseObject does not have");
 
@@ -216,7 +246,7 @@ double UniverseObject::CurrentMeterValue(MeterType type) const
 
 double UniverseObject::InitialMeterValue(MeterType type) const
 {
-    std::map<MeterType, Meter>::const_iterator it = m_meters.find(type);
+    MeterMap::const_iterator it = m_meters.find(type);
     if (it == m_meters.end())
         throw std::invalid_argument("UniverseObject::InitialMeterValue was passed a MeterType that this UniverseObject does not have");
 
@@ -291,7 +321,7 @@ void UniverseObject::MoveTo(double x, double y)
 
 Meter* UniverseObject::GetMeter(MeterType type)
 {
-    std::map<MeterType, Meter>::iterator it = m_meters.find(type);
+    MeterMap::iterator it = m_meters.find(type);
     if (it != m_meters.end())
         return &(it->second);
     return 0;
@@ -307,7 +337,9 @@ void UniverseObject::BackPropegateMeters()
 void UniverseObject::SetOwner(int id)
 {
     if (m_owner_empire_id != id) {
+        int old_owner = m_owner_empire_id;
         m_owner_empire_id = id;
+        GetUniverse().Objects().ObjectOwnerChanged(this, old_owner);
         StateChangedSignal();
     }
     /* TODO: if changing object ownership gives an the new owner an
@@ -325,17 +357,27 @@ void UniverseObject::SetSystem(int sys)
 }
 
 void UniverseObject::AddSpecial(const std::string& name)
-{ m_specials[name] = CurrentTurn(); }
+{
+    int special_id = SpecialID(name);
+    SpecialList::iterator it = std::lower_bound(m_specials.begin(), m_specials.end(),
+                                                std::make_pair(special_id, INT_MIN));
+    if (it != m_specials.end() && it->first == special_id) {
+        it->second = CurrentTurn();
+        return;
+    }
+    m_specials.insert(it, std::make_pair(special_id, CurrentTurn()));
+    GetUniverse().Objects().ObjectSpecialAdded(this, special_id);
+}
 
 void UniverseObject::RemoveSpecial(const std::string& name)
-{ m_specials.erase(name); }
-
-std::map<MeterType, Meter> UniverseObject::CensoredMeters(Visibility vis) const
 {
-    std::map<MeterType, Meter> retval;
-    if (vis >= VIS_PARTIAL_VISIBILITY)
-        retval = m_meters;
-    return retval;
+    int special_id = FindSpecialID(name);
+    SpecialList::iterator it = std::lower_bound(m_specials.begin(), m_specials.end(),
+                                                std::make_pair(special_id, INT_MIN));
+    if (it == m_specials.end() || it->first != special_id)
+        return;
+    m_specials.erase(it);
+    GetUniverse().Objects().ObjectSpecialRemoved(this, special_id);
 }
 
 void UniverseObject::ResetTargetMaxUnpairedMeters()
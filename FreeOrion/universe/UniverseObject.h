@@ -9,7 +9,11 @@
 #define _UniverseObject_h_
 
 #include "InhibitableSignal.h"
+#include "../util/PoolAllocated.h"
 
+#include <boost/pool/pool_alloc.hpp>
+
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -46,6 +50,20 @@ public:
     typedef StateChangedSignalType::slot_type               StateChangedSlotType;
     //@}
 
+    /** Meters of an object, by type.  Every object has several, so the map
+      * nodes come from a pool shared by the meters of all objects.  Like the
+      * objects themselves (see PoolAllocated), meters are only created and
+      * destroyed on the main thread, so the pool doesn't lock. */
+    typedef std::map<MeterType, Meter, std::less<MeterType>,
+                     boost::fast_pool_allocator<std::pair<const MeterType, Meter>,
+                                                boost::default_user_allocator_new_delete,
+                                                boost::details::pool::null_mutex> > MeterMap;
+
+    /** Ids of the specials attached to an object (see SpecialID()), each with
+      * the turn on which it was attached, sorted by id.  Most objects have
+      * none or a few, so they're kept in a vector rather than a map. */
+    typedef std::vector<std::pair<int, int> >               SpecialList;
+
     /** \name Structors */ //@{
     UniverseObject();                                           ///< default ctor
 
@@ -72,14 +90,20 @@ public:
     double                      Y() const;                          ///< the Y-coordinate of this object
     int                         Owner() const;                      ///< returns the ID of the empire that owns this object, or ALL_EMPIRES if there is no owner
     virtual int                 SystemID() const;                   ///< returns the ID number of the system in which this object can be found, or INVALID_OBJECT_ID if the object is not within any system
-    const std::map<std::string, int>&
-                                Specials() const;                   ///< returns the names of Specials and the turn on which each was attached to this object
+    std::map<std::string, int>  Specials() const;                   ///< returns the names of Specials and the turn on which each was attached to this object
+    const SpecialList&          SpecialIDs() const;                 ///< returns the ids of Specials and the turn on which each was attached to this object
     bool                        HasSpecial(const std::string& name) const;          ///< returns true iff this object has a special with the indicated \a name
+    bool                        HasSpecial(int special_id) const;                   ///< returns true iff this object has a special with id \a special_id
     int                         SpecialAddedOnTurn(const std::string& name) const;  ///< returns the turn on which the special with name \a name was added to this object, or INVALID_GAME_TURN if that special is not present
+    int                         SpecialAddedOnTurn(int special_id) const;           ///< returns the turn on which the special with id \a special_id was added to this object, or INVALID_GAME_TURN if that special is not present
 
     virtual const std::string&  TypeName() const;                   ///< returns user-readable string indicating the type of UniverseObject this is
     virtual std::string         Dump() const;                       ///< outputs textual description of object to logger
 
+    /** Returns the approximate bytes used by this object, including memory
+      * allocated by its containers and strings.  See MemoryReport. */
+    virtual std::size_t         MemoryUsage() const;
+
     virtual std::vector<int>    FindObjectIDs() const;              ///< returns ids of objects contained within this object
 
     virtual bool                Contains(int object_id) const;      ///< returns true if there is an object with id \a object_id is contained within this UniverseObject
@@ -176,8 +200,46 @@ protected:
 
     void                    Copy(const UniverseObject* copied_object, Visibility vis);  ///< used by public UniverseObject::Copy and derived classes' ::Copy methods
 
+    std::size_t             AllocatedMemory() const;        ///< returns the approximate bytes allocated by this UniverseObject's containers and strings, for use by derived classes' MemoryUsage methods
+
+    /** Assigns \a source to \a dest, unless they are already equal.  Used by
+      * Copy methods so that refreshing an empire's latest known copy of an
+      * object that hasn't changed doesn't reallocate the copy's containers. */
+    template <class T>
+    static void             CopyIfChanged(T& dest, const T& source)
+    { if (!(dest == source)) dest = source; }
+
+    /** Assigns to \a dest the elements of \a source, a set of object ids or
+      * a map to object ids, whose objects are visible to the empire with id
+      * \a empire_id, unless \a dest already holds exactly those.  Both are
+      * walked together to compare them, so an unchanged \a dest is checked
+      * without building the visible subset of \a source. */
+    template <class Container>
+    static void             CopyVisibleIfChanged(Container& dest, const Container& source, int empire_id)
+    {
+        typename Container::const_iterator dest_it = dest.begin();
+        typename Container::const_iterator source_it = source.begin();
+        for (; source_it != source.end(); ++source_it) {
+            if (!ObjectVisible(ContainedObjectID(*source_it), empire_id))
+                continue;
+            if (dest_it == dest.end() || !(*dest_it == *source_it))
+                break;
+            ++dest_it;
+        }
+        if (source_it == source.end() && dest_it == dest.end())
+            return;
+
+        Container visible;
+        for (source_it = source.begin(); source_it != source.end(); ++source_it)
+            if (ObjectVisible(ContainedObjectID(*source_it), empire_id))
+                visible.insert(visible.end(), *source_it);
+        dest.swap(visible);
+    }
+
 private:
-    std::map<MeterType, Meter>  CensoredMeters(Visibility vis) const;   ///< returns set of meters of this object that are censored based on the specified Visibility \a vis
+    static bool             ObjectVisible(int object_id, int empire_id);    ///< returns true iff the empire with id \a empire_id has at least basic visibility of the object with id \a object_id
+    static int              ContainedObjectID(int object_id)                                { return object_id; }
+    static int              ContainedObjectID(const std::pair<const int, int>& orbit_object) { return orbit_object.second; }
 
     int                         m_id;
     std::string                 m_name;
@@ -185,8 +247,8 @@ private:
     double                      m_y;
     int                         m_owner_empire_id;
     int                         m_system_id;
-    std::map<std::string, int>  m_specials;
-    std::map<MeterType, Meter>  m_meters;
+    SpecialList                 m_specials;
+    MeterMap                    m_meters;
     int                         m_created_on_turn;
 
     friend class boost::serialization::access;
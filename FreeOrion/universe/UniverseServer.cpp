@@ -60,8 +60,8 @@ namespace {
 //  Server-Only Galaxy Setup Functions  //
 //////////////////////////////////////////
 namespace {
-    const double        MIN_SYSTEM_SEPARATION       = 35.0;                         // in universe units [0.0, s_universe_width]
-    const double        MIN_HOME_SYSTEM_SEPARATION  = 200.0;                        // in universe units [0.0, s_universe_width]
+    const double        MIN_SYSTEM_SEPARATION       = 35.0;                         // in universe units [0.0, UniverseWidth()]
+    const double        MIN_HOME_SYSTEM_SEPARATION  = 200.0;                        // in universe units [0.0, UniverseWidth()]
     const double        AVG_UNIVERSE_WIDTH          = 1000.0 / std::sqrt(150.0);    // so a 150 star universe is 1000 units across
     const int           ADJACENCY_BOXES             = 25;
     const double        PI                          = 3.141592653589793;
@@ -1499,7 +1499,8 @@ void Universe::CreateUniverse(int size, Shape shape, GalaxySetupOption age, Gala
     // in order to ensure that they get spaced out properly
     AdjacencyGrid adjacency_grid(ADJACENCY_BOXES, std::vector<std::set<System*> >(ADJACENCY_BOXES));
 
-    s_universe_width = std::sqrt(static_cast<double>(size)) * AVG_UNIVERSE_WIDTH;
+    const double universe_width = std::sqrt(static_cast<double>(size)) * AVG_UNIVERSE_WIDTH;
+    SetUniverseWidth(universe_width);
 
     std::vector<std::pair<double, double> > positions;
 
@@ -1508,30 +1509,30 @@ void Universe::CreateUniverse(int size, Shape shape, GalaxySetupOption age, Gala
     case SPIRAL_2:
     case SPIRAL_3:
     case SPIRAL_4:
-        SpiralGalaxyCalcPositions(positions, 2 + (shape - SPIRAL_2), size, s_universe_width, s_universe_width);
+        SpiralGalaxyCalcPositions(positions, 2 + (shape - SPIRAL_2), size, universe_width, universe_width);
         break;
     case CLUSTER: {
         int average_clusters = size / 20; // chosen so that a "typical" size of 100 yields about 5 clusters
         if (!average_clusters)
             average_clusters = 2;
         int clusters = RandSmallInt(average_clusters * 8 / 10, average_clusters * 12 / 10); // +/- 20%
-        ClusterGalaxyCalcPositions(positions, clusters, size, s_universe_width, s_universe_width);
+        ClusterGalaxyCalcPositions(positions, clusters, size, universe_width, universe_width);
         break;
     }
     case ELLIPTICAL:
-        EllipticalGalaxyCalcPositions(positions, size, s_universe_width, s_universe_width);
+        EllipticalGalaxyCalcPositions(positions, size, universe_width, universe_width);
         break;
     case IRREGULAR:
-        IrregularGalaxyPositions(positions, size, s_universe_width, s_universe_width);
+        IrregularGalaxyPositions(positions, size, universe_width, universe_width);
         break;
     case RING:
-        RingGalaxyCalcPositions(positions, size, s_universe_width, s_universe_width);
+        RingGalaxyCalcPositions(positions, size, universe_width, universe_width);
         break;
     default:
         Logger().errorStream() << "Universe::Universe : Unknown galaxy shape: " << shape << ".  Using IRREGULAR as default.";
-        IrregularGalaxyPositions(positions, size, s_universe_width, s_universe_width);
+        IrregularGalaxyPositions(positions, size, universe_width, universe_width);
     }
-    GenerateStarField(*this, age, positions, adjacency_grid, s_universe_width / ADJACENCY_BOXES);
+    GenerateStarField(*this, age, positions, adjacency_grid, universe_width / ADJACENCY_BOXES);
 
     PopulateSystems(planet_density);
     GenerateStarlanes(starlane_freq, adjacency_grid);
@@ -68,7 +68,7 @@ int GetNewDesignID()
 int CurrentTurn()
 {
 #ifdef FREEORION_BUILD_SERVER
-    return ServerApp::GetApp()->CurrentTurn();
+    return GameContext::Current().m_current_turn;
 #else
     return const_cast<const ClientApp*>(ClientApp::GetApp())->CurrentTurn();
 #endif
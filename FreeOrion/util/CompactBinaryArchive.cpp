@@ -0,0 +1,129 @@
+#include "CompactBinaryArchive.h"
+
+#include <boost/archive/archive_exception.hpp>
+#include <boost/archive/impl/archive_serializer_map.ipp>
+#include <boost/archive/impl/basic_binary_iarchive.ipp>
+#include <boost/archive/impl/basic_binary_iprimitive.ipp>
+#include <boost/archive/impl/basic_binary_oarchive.ipp>
+#include <boost/archive/impl/basic_binary_oprimitive.ipp>
+
+#include <cstring>
+
+
+namespace {
+    /** Written ahead of boost's own archive header, to distinguish compact
+        archives from boost binary archives. */
+    const char COMPACT_ARCHIVE_SIGNATURE[4] = {'F', 'O', 'C', 'B'};
+}
+
+////////////////////////////////////////////////
+// CompactBinaryOArchive
+////////////////////////////////////////////////
+CompactBinaryOArchive::CompactBinaryOArchive(std::ostream& os, unsigned int flags/* = 0*/) :
+    Base(os, flags)
+{ init(flags); }
+
+CompactBinaryOArchive::CompactBinaryOArchive(std::streambuf& bsb, unsigned int flags/* = 0*/) :
+    Base(bsb, flags)
+{ init(flags); }
+
+void CompactBinaryOArchive::init(unsigned int flags)
+{
+    if (flags & boost::archive::no_header)
+        return;
+    save_binary(COMPACT_ARCHIVE_SIGNATURE, sizeof(COMPACT_ARCHIVE_SIGNATURE));
+    Base::init(flags);
+}
+
+void CompactBinaryOArchive::SaveVarUInt(unsigned long long value)
+{
+    // 7 bits per byte, low bits first; high bit set on all but the last byte
+    unsigned char bytes[10];
+    std::size_t length = 0;
+    do {
+        unsigned char byte = static_cast<unsigned char>(value & 0x7F);
+        value >>= 7;
+        if (value)
+            byte |= 0x80;
+        bytes[length++] = byte;
+    } while (value);
+    save_binary(bytes, length);
+}
+
+void CompactBinaryOArchive::SaveVarInt(long long value)
+{
+    // zigzag: 0, -1, 1, -2, 2, ... map to 0, 1, 2, 3, 4, ...
+    unsigned long long zigzag = (static_cast<unsigned long long>(value) << 1) ^
+                                static_cast<unsigned long long>(value >> 63);
+    SaveVarUInt(zigzag);
+}
+
+////////////////////////////////////////////////
+// CompactBinaryIArchive
+////////////////////////////////////////////////
+CompactBinaryIArchive::CompactBinaryIArchive(std::istream& is, unsigned int flags/* = 0*/) :
+    Base(is, flags),
+    m_legacy_format(false)
+{ init(flags); }
+
+CompactBinaryIArchive::CompactBinaryIArchive(std::streambuf& bsb, unsigned int flags/* = 0*/) :
+    Base(bsb, flags),
+    m_legacy_format(false)
+{ init(flags); }
+
+void CompactBinaryIArchive::init(unsigned int flags)
+{
+    if (flags & boost::archive::no_header)
+        return;
+    // boost binary archives start with the length of their signature string,
+    // which can't be mistaken for the first character of ours; anything
+    // else is read as a boost binary archive, whose own header check
+    // rejects data that isn't one either
+    if (m_sb.sgetc() != static_cast<unsigned char>(COMPACT_ARCHIVE_SIGNATURE[0])) {
+        m_legacy_format = true;
+        Base::init(flags);
+        return;
+    }
+    char signature[sizeof(COMPACT_ARCHIVE_SIGNATURE)];
+    load_binary(signature, sizeof(signature));
+    if (std::memcmp(signature, COMPACT_ARCHIVE_SIGNATURE, sizeof(signature)) != 0)
+        boost::serialization::throw_exception(
+            boost::archive::archive_exception(boost::archive::archive_exception::invalid_signature));
+    Base::init(flags);
+}
+
+unsigned long long CompactBinaryIArchive::LoadVarUInt()
+{
+    unsigned long long value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+        unsigned char byte = 0;
+        load_binary(&byte, 1);
+        value |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return value;
+    }
+    boost::serialization::throw_exception(
+        boost::archive::archive_exception(boost::archive::archive_exception::input_stream_error));
+    return value;
+}
+
+long long CompactBinaryIArchive::LoadVarInt()
+{
+    unsigned long long zigzag = LoadVarUInt();
+    return static_cast<long long>(zigzag >> 1) ^ -static_cast<long long>(zigzag & 1);
+}
+
+////////////////////////////////////////////////
+// Explicit instantiations
+////////////////////////////////////////////////
+namespace boost { namespace archive {
+    template class basic_binary_oprimitive<CompactBinaryOArchive, std::ostream::char_type, std::ostream::traits_type>;
+    template class basic_binary_oarchive<CompactBinaryOArchive>;
+    template class binary_oarchive_impl<CompactBinaryOArchive, std::ostream::char_type, std::ostream::traits_type>;
+    template class detail::archive_serializer_map<CompactBinaryOArchive>;
+
+    template class basic_binary_iprimitive<CompactBinaryIArchive, std::istream::char_type, std::istream::traits_type>;
+    template class basic_binary_iarchive<CompactBinaryIArchive>;
+    template class binary_iarchive_impl<CompactBinaryIArchive, std::istream::char_type, std::istream::traits_type>;
+    template class detail::archive_serializer_map<CompactBinaryIArchive>;
+} }
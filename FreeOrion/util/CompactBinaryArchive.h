@@ -0,0 +1,290 @@
+// -*- C++ -*-
+#ifndef _CompactBinaryArchive_h_
+#define _CompactBinaryArchive_h_
+
+#include <boost/archive/binary_iarchive_impl.hpp>
+#include <boost/archive/binary_oarchive_impl.hpp>
+#include <boost/archive/detail/register_archive.hpp>
+#include <boost/serialization/array.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_signed.hpp>
+#include <boost/mpl/bool.hpp>
+
+#include <istream>
+#include <ostream>
+
+/** Binary archives that store integers, including boost's own collection
+    sizes, class ids, object ids and version numbers, as variable-length
+    (LEB128) integers; signed values are zigzag encoded so that small negative
+    numbers such as INVALID_OBJECT_ID also take a single byte.  Most ids,
+    counts and enum values in game state are small, so this roughly halves
+    the size of serialized universes compared to boost::archive::binary_oarchive,
+    which writes every one of them at full width.  Floating point values,
+    bools and chars are written as-is.
+
+    The archive starts with its own signature.  CompactBinaryIArchive checks
+    for it, and reads data without it, such as saved games written before
+    these archives were added, as boost binary archive data.  The boost
+    archives can still be selected in Serialize.h.
+
+    Object tracking, pointers and class ids are handled by boost exactly as
+    in its binary archives; only the integers they are written with are
+    shorter. */
+class CompactBinaryOArchive :
+    public boost::archive::binary_oarchive_impl<CompactBinaryOArchive, std::ostream::char_type, std::ostream::traits_type>
+{
+public:
+    CompactBinaryOArchive(std::ostream& os, unsigned int flags = 0);
+    CompactBinaryOArchive(std::streambuf& bsb, unsigned int flags = 0);
+
+    /** Writes \a value as an unsigned variable-length integer. */
+    void SaveVarUInt(unsigned long long value);
+
+    /** Writes \a value as a zigzag-encoded variable-length integer. */
+    void SaveVarInt(long long value);
+
+    /** Writes arrays, such as the contents of vectors, of integers wider
+      * than a byte element by element as variable-length integers, and other
+      * arrays as-is.  \a a is the boost::serialization::array (or, in newer
+      * boost releases, array_wrapper) that boost passes in. */
+    template <class Array>
+    void save_array(const Array& a, unsigned int version)
+    { SaveArray(a, a.address(), version); }
+
+protected:
+    typedef boost::archive::binary_oarchive_impl<CompactBinaryOArchive, std::ostream::char_type, std::ostream::traits_type> Base;
+
+    friend class boost::archive::detail::interface_oarchive<CompactBinaryOArchive>;
+    friend class boost::archive::basic_binary_oarchive<CompactBinaryOArchive>;
+    friend class boost::archive::basic_binary_oprimitive<CompactBinaryOArchive, std::ostream::char_type, std::ostream::traits_type>;
+    friend class boost::archive::save_access;
+
+    void init(unsigned int flags);
+
+    template <class T>
+    void save(const T& t)
+    { SaveImpl(t, boost::mpl::bool_<boost::is_integral<T>::value>()); }
+
+    void save(const bool t)
+    { Base::save(t); }
+
+    void save(const char t)
+    { Base::save(t); }
+
+    void save(const signed char t)
+    { Base::save(t); }
+
+    void save(const unsigned char t)
+    { Base::save(t); }
+
+    void save(const boost::archive::class_id_type& t)
+    { SaveVarInt(static_cast<long long>(t)); }
+
+    void save(const boost::archive::class_id_reference_type& t)
+    { SaveVarInt(static_cast<long long>(static_cast<const boost::archive::class_id_type&>(t))); }
+
+    void save(const boost::archive::object_id_type& t)
+    { SaveVarUInt(static_cast<unsigned long long>(t)); }
+
+    void save(const boost::archive::object_reference_type& t)
+    { SaveVarUInt(static_cast<unsigned long long>(static_cast<const boost::archive::object_id_type&>(t))); }
+
+    void save(const boost::archive::version_type& t)
+    { SaveVarUInt(static_cast<unsigned long long>(t)); }
+
+    void save(const boost::serialization::collection_size_type& t)
+    { SaveVarUInt(static_cast<unsigned long long>(t)); }
+
+    void save(const boost::serialization::item_version_type& t)
+    { SaveVarUInt(static_cast<unsigned long long>(t)); }
+
+private:
+    template <class T>
+    void SaveImpl(const T& t, boost::mpl::true_)
+    {
+        if (boost::is_signed<T>::value)
+            SaveVarInt(static_cast<long long>(t));
+        else
+            SaveVarUInt(static_cast<unsigned long long>(t));
+    }
+
+    template <class T>
+    void SaveImpl(const T& t, boost::mpl::false_)
+    { Base::save(t); }
+
+    template <class Array, class ValueType>
+    void SaveArray(const Array& a, const ValueType*, unsigned int version)
+    { SaveArrayImpl(a, version, boost::mpl::bool_<boost::is_integral<ValueType>::value && 1 < sizeof(ValueType)>()); }
+
+    template <class Array>
+    void SaveArrayImpl(const Array& a, unsigned int version, boost::mpl::true_)
+    {
+        for (std::size_t i = 0; i < a.count(); ++i)
+            SaveImpl(a.address()[i], boost::mpl::true_());
+    }
+
+    template <class Array>
+    void SaveArrayImpl(const Array& a, unsigned int version, boost::mpl::false_)
+    { Base::save_array(a, version); }
+};
+
+/** Reads data written by a CompactBinaryOArchive or, if the data doesn't
+    start with a CompactBinaryOArchive signature, by a
+    boost::archive::binary_oarchive. */
+class CompactBinaryIArchive :
+    public boost::archive::binary_iarchive_impl<CompactBinaryIArchive, std::istream::char_type, std::istream::traits_type>
+{
+public:
+    CompactBinaryIArchive(std::istream& is, unsigned int flags = 0);
+    CompactBinaryIArchive(std::streambuf& bsb, unsigned int flags = 0);
+
+    /** Reads an unsigned variable-length integer. */
+    unsigned long long LoadVarUInt();
+
+    /** Reads a zigzag-encoded variable-length integer. */
+    long long LoadVarInt();
+
+    /** Returns true if this archive is reading boost binary archive data,
+      * rather than compact data. */
+    bool LegacyFormat() const
+    { return m_legacy_format; }
+
+    /** Reads arrays written by CompactBinaryOArchive::save_array(), or by a
+      * boost binary archive in legacy format. */
+    template <class Array>
+    void load_array(Array& a, unsigned int version)
+    {
+        if (m_legacy_format)
+            Base::load_array(a, version);
+        else
+            LoadArray(a, a.address(), version);
+    }
+
+protected:
+    typedef boost::archive::binary_iarchive_impl<CompactBinaryIArchive, std::istream::char_type, std::istream::traits_type> Base;
+
+    friend class boost::archive::detail::interface_iarchive<CompactBinaryIArchive>;
+    friend class boost::archive::basic_binary_iarchive<CompactBinaryIArchive>;
+    friend class boost::archive::basic_binary_iprimitive<CompactBinaryIArchive, std::istream::char_type, std::istream::traits_type>;
+    friend class boost::archive::load_access;
+
+    void init(unsigned int flags);
+
+    template <class T>
+    void load(T& t)
+    {
+        if (m_legacy_format)
+            Base::load(t);
+        else
+            LoadImpl(t, boost::mpl::bool_<boost::is_integral<T>::value>());
+    }
+
+    void load(bool& t)
+    { Base::load(t); }
+
+    void load(char& t)
+    { Base::load(t); }
+
+    void load(signed char& t)
+    { Base::load(t); }
+
+    void load(unsigned char& t)
+    { Base::load(t); }
+
+    void load(boost::archive::class_id_type& t)
+    {
+        if (m_legacy_format)
+            Base::load(t);
+        else
+            t = boost::archive::class_id_type(static_cast<int>(LoadVarInt()));
+    }
+
+    void load(boost::archive::class_id_reference_type& t)
+    {
+        if (m_legacy_format)
+            Base::load(t);
+        else
+            t = boost::archive::class_id_reference_type(boost::archive::class_id_type(static_cast<int>(LoadVarInt())));
+    }
+
+    void load(boost::archive::object_id_type& t)
+    {
+        if (m_legacy_format)
+            Base::load(t);
+        else
+            t = boost::archive::object_id_type(static_cast<unsigned int>(LoadVarUInt()));
+    }
+
+    void load(boost::archive::object_reference_type& t)
+    {
+        if (m_legacy_format)
+            Base::load(t);
+        else
+            t = boost::archive::object_reference_type(boost::archive::object_id_type(static_cast<unsigned int>(LoadVarUInt())));
+    }
+
+    void load(boost::archive::version_type& t)
+    {
+        if (m_legacy_format)
+            Base::load(t);
+        else
+            t = boost::archive::version_type(static_cast<unsigned int>(LoadVarUInt()));
+    }
+
+    void load(boost::serialization::collection_size_type& t)
+    {
+        if (m_legacy_format)
+            Base::load(t);
+        else
+            t = boost::serialization::collection_size_type(static_cast<std::size_t>(LoadVarUInt()));
+    }
+
+    void load(boost::serialization::item_version_type& t)
+    {
+        if (m_legacy_format)
+            Base::load(t);
+        else
+            t = boost::serialization::item_version_type(static_cast<unsigned int>(LoadVarUInt()));
+    }
+
+private:
+    template <class T>
+    void LoadImpl(T& t, boost::mpl::true_)
+    {
+        if (boost::is_signed<T>::value)
+            t = static_cast<T>(LoadVarInt());
+        else
+            t = static_cast<T>(LoadVarUInt());
+    }
+
+    template <class T>
+    void LoadImpl(T& t, boost::mpl::false_)
+    { Base::load(t); }
+
+    template <class Array, class ValueType>
+    void LoadArray(Array& a, const ValueType*, unsigned int version)
+    { LoadArrayImpl(a, version, boost::mpl::bool_<boost::is_integral<ValueType>::value && 1 < sizeof(ValueType)>()); }
+
+    template <class Array>
+    void LoadArrayImpl(Array& a, unsigned int version, boost::mpl::true_)
+    {
+        for (std::size_t i = 0; i < a.count(); ++i)
+            LoadImpl(a.address()[i], boost::mpl::true_());
+    }
+
+    template <class Array>
+    void LoadArrayImpl(Array& a, unsigned int version, boost::mpl::false_)
+    { Base::load_array(a, version); }
+
+    bool m_legacy_format;
+};
+
+BOOST_SERIALIZATION_REGISTER_ARCHIVE(CompactBinaryOArchive)
+BOOST_SERIALIZATION_REGISTER_ARCHIVE(CompactBinaryIArchive)
+
+// arrays of primitives are passed to save_array() / load_array() whole, as
+// boost's binary archives do, so that legacy data can be read
+BOOST_SERIALIZATION_USE_ARRAY_OPTIMIZATION(CompactBinaryOArchive)
+BOOST_SERIALIZATION_USE_ARRAY_OPTIMIZATION(CompactBinaryIArchive)
+
+#endif // _CompactBinaryArchive_h_
@@ -0,0 +1,48 @@
+#include "GameContext.h"
+
+#include "ThreadSpecific.h"
+
+#include <stdexcept>
+
+
+namespace {
+    ThreadSpecific<GameContext*>    s_active_context(0);
+    GameContext*                    s_default_context = 0;
+}
+
+////////////////////////////////////////////////
+// GameContext
+////////////////////////////////////////////////
+GameContext::GameContext() :
+    m_universe(),
+    m_empires(),
+    m_current_turn(INVALID_GAME_TURN),
+    m_encoding_empire(ALL_EMPIRES),
+    m_universe_width(1000.0),
+    m_inhibit_universe_object_signals(false),
+    m_random_generator(),
+    m_zero_to_one_generator(m_random_generator)
+{}
+
+GameContext& GameContext::Current()
+{
+    GameContext* context = s_active_context;
+    if (!context)
+        context = s_default_context;
+    if (!context)
+        throw std::runtime_error("GameContext::Current() : No game is active on this thread, and there is no default game");
+    return *context;
+}
+
+void GameContext::SetDefault(GameContext* context)
+{ s_default_context = context; }
+
+////////////////////////////////////////////////
+// ScopedGameContext
+////////////////////////////////////////////////
+ScopedGameContext::ScopedGameContext(GameContext& context) :
+    m_previous(s_active_context)
+{ s_active_context = &context; }
+
+ScopedGameContext::~ScopedGameContext()
+{ s_active_context = m_previous; }
@@ -0,0 +1,61 @@
+// -*- C++ -*-
+#ifndef _GameContext_h_
+#define _GameContext_h_
+
+#include "Random.h"
+#include "../Empire/EmpireManager.h"
+#include "../universe/Universe.h"
+
+#include <boost/noncopyable.hpp>
+
+
+/** The state of one game: its universe, its empires and its current turn,
+    and the working state that goes with them, such as the empire the
+    universe is being serialized for and the random number generators.
+    Content parsed from the resource files, such as techs, building types,
+    ship parts and hulls, specials and species, is not part of a game and is
+    shared, read-only, by every game in the process.
+
+    GetUniverse(), Empires(), GetMainObjectMap(), CurrentTurn(), the Universe
+    statics and the Random.h functions use the state of the game that is
+    active on the calling thread; see ScopedGameContext.  A thread with no
+    active game uses the process' default game, which is the one owned by the
+    ServerApp or ClientApp.  Threads that work on one game concurrently must
+    not use the random number generators or change the encoding empire. */
+struct GameContext : private boost::noncopyable
+{
+    GameContext();
+
+    Universe        m_universe;
+    EmpireManager   m_empires;
+    int             m_current_turn;
+
+    int             m_encoding_empire;                  ///< see Universe::EncodingEmpire()
+    double          m_universe_width;                   ///< see Universe::UniverseWidth()
+    bool            m_inhibit_universe_object_signals;  ///< see Universe::InhibitUniverseObjectSignals()
+
+    GeneratorType                       m_random_generator;         ///< drives the distributions in Random.h
+    boost::uniform_01<GeneratorType>    m_zero_to_one_generator;    ///< used by RandZeroToOne()
+
+    /** Returns the game active on the calling thread, or the default game if
+      * there is none. */
+    static GameContext& Current();
+
+    /** Sets the game used by threads that have no active game. */
+    static void         SetDefault(GameContext* context);
+};
+
+/** Makes a game the active game of the calling thread for the lifetime of
+    this object, so that a game's turn can be processed on any thread.  The
+    previously active game, if any, is restored on destruction. */
+class ScopedGameContext : private boost::noncopyable
+{
+public:
+    explicit ScopedGameContext(GameContext& context);
+    ~ScopedGameContext();
+
+private:
+    GameContext*    m_previous;
+};
+
+#endif // _GameContext_h_
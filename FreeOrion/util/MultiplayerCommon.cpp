@@ -21,7 +21,9 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/system/system_error.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/unordered_map.hpp>
 #include <boost/thread/xtime.hpp>
 
 
@@ -354,15 +356,37 @@ int PriorityValue(const std::string& name) {
 
 const std::string& UserString(const std::string& str) {
     const StringTable_& string_table = GetStringTable();
-    if (string_table.StringExists(str))
-        return GetStringTable().String(str);
+    StringTable_::Handle handle = string_table.StringHandle(str);
+    if (handle != StringTable_::INVALID_HANDLE)
+        return string_table.String(handle);
     else
         return GetDefaultStringTable().String(str);
 }
 
+namespace {
+    // parsed format templates, so that repeated formatting of the same string
+    // copies an already-parsed boost::format instead of reparsing it
+    typedef boost::unordered_map<std::string, boost::format> FormatCache;
+    const std::size_t MAX_FORMAT_CACHE_SIZE = 4096;
+    FormatCache     s_format_cache;
+    boost::mutex    s_format_cache_mutex;
+}
+
 boost::format FlexibleFormat(const std::string &string_to_format) {
+    boost::mutex::scoped_lock lock(s_format_cache_mutex);
+    FormatCache::const_iterator it = s_format_cache.find(string_to_format);
+    if (it != s_format_cache.end())
+        return it->second;
+
     boost::format retval(string_to_format);
     retval.exceptions(boost::io::all_error_bits ^ (boost::io::too_many_args_bit | boost::io::too_few_args_bit));
+
+    // format strings are nearly all stringtable entries, so the cache stays
+    // small; bound it anyway in case of dynamically-generated strings
+    if (s_format_cache.size() >= MAX_FORMAT_CACHE_SIZE)
+        s_format_cache.clear();
+    s_format_cache.insert(std::make_pair(string_to_format, retval));
+
     return retval;
 }
 
@@ -952,3 +952,62 @@ bool ScrapOrder::UndoImpl() const
     }
     return true;
 }
+
+////////////////////////////////////////////////
+// DiplomaticStatusOrder
+////////////////////////////////////////////////
+DiplomaticStatusOrder::DiplomaticStatusOrder() :
+    Order(),
+    m_other_empire(ALL_EMPIRES),
+    m_status(INVALID_DIPLOMATIC_STATUS)
+{}
+
+DiplomaticStatusOrder::DiplomaticStatusOrder(int empire, int other_empire, DiplomaticStatus status) :
+    Order(empire),
+    m_other_empire(other_empire),
+    m_status(status)
+{}
+
+void DiplomaticStatusOrder::ExecuteImpl() const
+{
+    ValidateEmpireID();
+
+    if (m_other_empire == EmpireID() || !Empires().Lookup(m_other_empire)) {
+        Logger().errorStream() << "DiplomaticStatusOrder::ExecuteImpl given invalid other empire id " << m_other_empire;
+        return;
+    }
+
+    Empires().ProposeDiplomaticStatus(EmpireID(), m_other_empire, m_status);
+}
+
+////////////////////////////////////////////////
+// ShareVisibilityOrder
+////////////////////////////////////////////////
+ShareVisibilityOrder::ShareVisibilityOrder() :
+    Order(),
+    m_other_empire(ALL_EMPIRES),
+    m_share(false)
+{}
+
+ShareVisibilityOrder::ShareVisibilityOrder(int empire, int other_empire, bool share) :
+    Order(empire),
+    m_other_empire(other_empire),
+    m_share(share)
+{}
+
+void ShareVisibilityOrder::ExecuteImpl() const
+{
+    ValidateEmpireID();
+
+    if (m_other_empire == EmpireID() || !Empires().Lookup(m_other_empire)) {
+        Logger().errorStream() << "ShareVisibilityOrder::ExecuteImpl given invalid other empire id " << m_other_empire;
+        return;
+    }
+
+    if (m_share && Empires().AtWar(EmpireID(), m_other_empire)) {
+        Logger().errorStream() << "Empire attempted to share visibility with an empire it is at war with.";
+        return;
+    }
+
+    Empires().SetVisibilitySharing(EmpireID(), m_other_empire, m_share);
+}
@@ -550,6 +550,85 @@ private:
     void serialize(Archive& ar, const unsigned int version);
 };
 
+
+/////////////////////////////////////////////////////
+// DiplomaticStatusOrder
+/////////////////////////////////////////////////////
+/** the Order subclass that represents an empire asking to change its
+  * diplomatic status with another empire. */
+class DiplomaticStatusOrder : public Order
+{
+public:
+    /** \name Structors */ //@{
+    DiplomaticStatusOrder();
+    DiplomaticStatusOrder(int empire, int other_empire, DiplomaticStatus status);
+    //@}
+
+    /** \name Accessors */ //@{
+    int                 OtherEmpireID() const {return m_other_empire;}  ///< returns ID of the empire whose status with the issuing empire is to change
+    DiplomaticStatus    Status() const {return m_status;}               ///< returns the requested status
+    //@}
+
+private:
+    /**
+     *  Preconditions:
+     *     - m_other_empire must be the ID of an empire other than the issuing
+     *       empire
+     *
+     *  Postconditions:
+     *     - a more hostile status is set immediately; a friendlier status is
+     *       proposed to the other empire, and set if the other empire has
+     *       already proposed it.
+     */
+    virtual void    ExecuteImpl() const;
+
+    int                 m_other_empire;
+    DiplomaticStatus    m_status;
+
+    friend class boost::serialization::access;
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int version);
+};
+
+
+/////////////////////////////////////////////////////
+// ShareVisibilityOrder
+/////////////////////////////////////////////////////
+/** the Order subclass that represents an empire starting or stopping sharing
+  * what it detects with another empire. */
+class ShareVisibilityOrder : public Order
+{
+public:
+    /** \name Structors */ //@{
+    ShareVisibilityOrder();
+    ShareVisibilityOrder(int empire, int other_empire, bool share);
+    //@}
+
+    /** \name Accessors */ //@{
+    int             OtherEmpireID() const {return m_other_empire;}  ///< returns ID of the empire receiving the issuing empire's visibility
+    bool            Share() const {return m_share;}                 ///< returns whether sharing is to start or stop
+    //@}
+
+private:
+    /**
+     *  Preconditions:
+     *     - m_other_empire must be the ID of an empire other than the issuing
+     *       empire, which is not at war with it when sharing is to start
+     *
+     *  Postconditions:
+     *     - the issuing empire shares, or stops sharing, its visibility with
+     *       the other empire.
+     */
+    virtual void    ExecuteImpl() const;
+
+    int     m_other_empire;
+    bool    m_share;
+
+    friend class boost::serialization::access;
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int version);
+};
+
 // Note: *::serialize() implemented in SerializeOrderSet.cpp.
 
 #endif // _Order_h_
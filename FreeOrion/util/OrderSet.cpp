@@ -18,10 +18,22 @@ const OrderPtr OrderSet::ExamineOrder(int order) const
     return retval;
 }
 
+OrderSet OrderSet::Subset(const std::set<int>& order_ids) const
+{
+    OrderSet retval;
+    for (std::set<int>::const_iterator it = order_ids.begin(); it != order_ids.end(); ++it) {
+        OrderMap::const_iterator order_it = m_orders.find(*it);
+        if (order_it != m_orders.end())
+            retval.m_orders.insert(*order_it);
+    }
+    return retval;
+}
+
 int OrderSet::IssueOrder(OrderPtr order)
 {
     int retval = ((m_orders.rbegin() != m_orders.rend()) ? m_orders.rbegin()->first + 1 : 0);
     m_orders[retval] = order;
+    m_issued_order_ids.insert(retval);
 
     order->Execute();
 
@@ -42,6 +54,9 @@ bool OrderSet::RecindOrder(int order)
     if (it != m_orders.end()) {
         if (it->second->Undo()) {
             m_orders.erase(it);
+            // an order that was issued and rescinded between updates need not be sent at all
+            if (!m_issued_order_ids.erase(order))
+                m_rescinded_order_ids.insert(order);
             retval = true;
         }
     }
@@ -51,4 +66,19 @@ bool OrderSet::RecindOrder(int order)
 void OrderSet::Reset()
 {
     m_orders.clear();
+    ClearChanges();
+}
+
+void OrderSet::ApplyChanges(const OrderSet& orders, const std::set<int>& rescinded_order_ids)
+{
+    for (std::set<int>::const_iterator it = rescinded_order_ids.begin(); it != rescinded_order_ids.end(); ++it)
+        m_orders.erase(*it);
+    for (OrderMap::const_iterator it = orders.m_orders.begin(); it != orders.m_orders.end(); ++it)
+        m_orders[it->first] = it->second;
+}
+
+void OrderSet::ClearChanges()
+{
+    m_issued_order_ids.clear();
+    m_rescinded_order_ids.clear();
 }
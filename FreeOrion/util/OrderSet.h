@@ -7,6 +7,7 @@
 #endif
 
 #include <map>
+#include <set>
 #include <vector>
 
 /** The pointer type used to store Orders in OrderSets. */
@@ -45,6 +46,14 @@ public:
 
     const_iterator begin() const {return m_orders.begin();} ///< returns the begin const_iterator for the OrderSet
     const_iterator end() const   {return m_orders.end();}   ///< returns the end const_iterator for the OrderSet
+    std::size_t    size() const  {return m_orders.size();}  ///< returns the number of orders in the OrderSet
+
+    /** returns an OrderSet containing the orders in this OrderSet with the indices in \a order_ids, under the same indices */
+    OrderSet       Subset(const std::set<int>& order_ids) const;
+
+    const std::set<int>& IssuedOrderIDs() const    {return m_issued_order_ids;}    ///< returns the indices of orders issued (or loaded) since the last call to ClearChanges() and still in the OrderSet
+    const std::set<int>& RescindedOrderIDs() const {return m_rescinded_order_ids;} ///< returns the indices of orders present at the last call to ClearChanges() that have since been rescinded
+    bool           HasChanges() const {return !m_issued_order_ids.empty() || !m_rescinded_order_ids.empty();} ///< returns true iff orders have been issued or rescinded since the last call to ClearChanges()
     //@}
 
     /** \name Mutators */ //@{
@@ -58,10 +67,19 @@ public:
 
     bool           RecindOrder(int order);    ///< removes the order from the OrderSet; returns true on success, false if there was no such order or the order is non-recindable
     void           Reset(); ///< clears all orders; should be called at the beginning of a new turn
+
+    /** stores the orders in \a orders under their indices in that OrderSet, replacing any orders already stored under
+        those indices, and removes the orders with indices in \a rescinded_order_ids.  The orders are not executed.  This
+        is used by the server to keep up to date with orders streamed from a client during a turn. */
+    void           ApplyChanges(const OrderSet& orders, const std::set<int>& rescinded_order_ids);
+
+    void           ClearChanges(); ///< forgets which orders have been issued or rescinded; should be called after the changes have been sent to the server
     //@}
 
 private:
-    OrderMap m_orders;
+    OrderMap        m_orders;
+    std::set<int>   m_issued_order_ids;
+    std::set<int>   m_rescinded_order_ids;
 
     friend class boost::serialization::access;
     template <class Archive>
@@ -73,6 +91,14 @@ template <class Archive>
 void OrderSet::serialize(Archive& ar, const unsigned int version)
 {
     ar  & BOOST_SERIALIZATION_NVP(m_orders);
+
+    if (Archive::is_loading::value) {
+        // loaded orders haven't been sent to the server in this session
+        m_issued_order_ids.clear();
+        m_rescinded_order_ids.clear();
+        for (OrderMap::const_iterator it = m_orders.begin(); it != m_orders.end(); ++it)
+            m_issued_order_ids.insert(it->first);
+    }
 }
 
 #endif // _OrderSet_h_
@@ -0,0 +1,58 @@
+// -*- C++ -*-
+#ifndef _PoolAllocated_h_
+#define _PoolAllocated_h_
+
+#include <boost/pool/singleton_pool.hpp>
+
+#include <cstddef>
+#include <new>
+
+/** A base class for classes of which many objects of the same size are
+    created and destroyed during a game, such as UniverseObjects, which are
+    cloned for each empire's latest known objects, for combat and for each
+    player's copy of the universe every turn.  Objects of class T are
+    allocated from a pool of T-sized chunks shared by all objects of T, so
+    destroying one and creating another reuses its memory without going
+    through the general heap, and long games don't fragment it.  Objects of
+    classes derived from T, which are larger, are allocated normally.  Memory
+    freed to the pool is kept for reuse and not returned to the heap.
+
+    These objects are only created and destroyed on the main thread, so the
+    pool doesn't lock; they must not be allocated or freed concurrently. */
+template <class T>
+class PoolAllocated
+{
+public:
+    static void* operator new(std::size_t size)
+    {
+        if (size != sizeof(T))
+            return ::operator new(size);
+        void* retval = Pool<sizeof(T)>::type::malloc();
+        if (!retval)
+            throw std::bad_alloc();
+        return retval;
+    }
+
+    static void operator delete(void* p, std::size_t size)
+    {
+        if (!p)
+            return;
+        if (size != sizeof(T))
+            ::operator delete(p);
+        else
+            Pool<sizeof(T)>::type::free(p);
+    }
+
+private:
+    // T is incomplete where PoolAllocated<T> is instantiated, so the pool
+    // type, which depends on sizeof(T), is only named in the functions above
+    struct PoolTag {};
+
+    template <std::size_t Size>
+    struct Pool {
+        typedef boost::singleton_pool<PoolTag, Size, boost::default_user_allocator_new_delete,
+                                      boost::details::pool::null_mutex> type;
+    };
+};
+
+#endif // _PoolAllocated_h_
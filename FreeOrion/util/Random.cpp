@@ -1,43 +1,63 @@
 #include "Random.h"
 
+#include "GameContext.h"
 #include "MultiplayerCommon.h"
 
+#include <sstream>
+
 
 namespace {
-    GeneratorType gen; // the one random number generator driving the distributions below
-    boost::uniform_01<GeneratorType> zero_to_one_gen(gen);
+    // each game has its own generators, so that games processed on
+    // different threads neither race on nor perturb each other's sequences
+    GeneratorType& Gen()
+    { return GameContext::Current().m_random_generator; }
 
+    boost::uniform_01<GeneratorType>& ZeroToOneGen()
+    { return GameContext::Current().m_zero_to_one_generator; }
 }
 
 
 void Seed(unsigned int seed)
 {
-    gen.seed(static_cast<boost::mt19937::result_type>(seed));
+    Gen().seed(static_cast<boost::mt19937::result_type>(seed));
 }
 
 void ClockSeed()
 {
-    gen.seed(static_cast<boost::mt19937::result_type>(std::time(0)));
+    Gen().seed(static_cast<boost::mt19937::result_type>(std::time(0)));
+}
+
+std::string GeneratorState()
+{
+    std::ostringstream oss;
+    oss << Gen() << ' ' << ZeroToOneGen();
+    return oss.str();
+}
+
+void SetGeneratorState(const std::string& state)
+{
+    std::istringstream iss(state);
+    iss >> Gen() >> std::ws >> ZeroToOneGen();
 }
 
 SmallIntDistType SmallIntDist(int min, int max)
 {
-    return SmallIntDistType(gen, boost::uniform_smallint<>(min, max));
+    return SmallIntDistType(Gen(), boost::uniform_smallint<>(min, max));
 }
 
 IntDistType IntDist(int min, int max)
 {
-    return IntDistType(gen, boost::uniform_int<>(min, max));
+    return IntDistType(Gen(), boost::uniform_int<>(min, max));
 }
 
 DoubleDistType DoubleDist(double min, double max)
 {
-    return DoubleDistType(gen, boost::uniform_real<>(min, max));
+    return DoubleDistType(Gen(), boost::uniform_real<>(min, max));
 }
 
 GaussianDistType GaussianDist(double mean, double sigma)
 {
-    return GaussianDistType(gen, boost::normal_distribution<>(mean, sigma));
+    return GaussianDistType(Gen(), boost::normal_distribution<>(mean, sigma));
 }
 
 int RandSmallInt(int min, int max)
@@ -52,7 +72,7 @@ int RandInt(int min, int max)
 
 double RandZeroToOne()
 {
-    return zero_to_one_gen();
+    return ZeroToOneGen()();
 }
 
 double RandDouble(double min, double max)
@@ -14,6 +14,7 @@
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
 #include <ctime>
+#include <string>
 
 /** \file Random.h
     A collection of robust and portable random number generation functors and functions.
@@ -30,13 +31,22 @@ typedef boost::variate_generator<GeneratorType&, boost::uniform_int<> >
 typedef boost::variate_generator<GeneratorType&, boost::uniform_real<> >        DoubleDistType;
 typedef boost::variate_generator<GeneratorType&, boost::normal_distribution<> > GaussianDistType;
 
-/** seeds the underlying random number generator used to drive all random number distributions */
+/** seeds the underlying random number generator used to drive all random number distributions.  Each game has
+    its own generator; this seeds the one of the game active on the calling thread (see GameContext). */
 void Seed(unsigned int seed);
 
 /** seeds the underlying random number generator used to drive all random number distributions with 
     the current clock time */
 void ClockSeed();
 
+/** returns the complete state of the active game's random number generators, as text that
+    SetGeneratorState() accepts.  Used to record games for later replay. */
+std::string GeneratorState();
+
+/** restores the active game's random number generators to \a state, as returned by
+    GeneratorState(), so that they produce the same sequence of numbers they did then */
+void SetGeneratorState(const std::string& state);
+
 /** returns a functor that provides a uniform distribution of small
     integers in the range [\a min, \a max]; if the integers desired
     are larger than 10000, use IntDist() instead */
@@ -5,7 +5,16 @@
 // Set this to true to do all serialization using binary archives.  Otherwise, XML archives will be used.
 #define FREEORION_BINARY_SERIALIZATION 1
 
-#if FREEORION_BINARY_SERIALIZATION
+// Set this to true to use the compact binary archives in CompactBinaryArchive.h when doing binary serialization.
+// Otherwise, boost's binary archives will be used.  The compact input archive also reads boost binary data, so saved
+// games from before the switch still load; boost's archives can't read compact data.
+#define FREEORION_COMPACT_BINARY_SERIALIZATION 1
+
+#if FREEORION_BINARY_SERIALIZATION && FREEORION_COMPACT_BINARY_SERIALIZATION
+#  include "CompactBinaryArchive.h"
+#  define FREEORION_IARCHIVE_TYPE CompactBinaryIArchive
+#  define FREEORION_OARCHIVE_TYPE CompactBinaryOArchive
+#elif FREEORION_BINARY_SERIALIZATION
 #  include <boost/archive/binary_iarchive.hpp>
 #  include <boost/archive/binary_oarchive.hpp>
 #  define FREEORION_IARCHIVE_TYPE boost::archive::binary_iarchive
@@ -74,8 +74,8 @@ void Empire::serialize(Archive& ar, const unsigned int version)
         & BOOST_SERIALIZATION_NVP(m_color);
 
     if (Universe::ALL_OBJECTS_VISIBLE ||
-        Universe::s_encoding_empire == ALL_EMPIRES ||
-        m_id == Universe::s_encoding_empire)
+        Universe::EncodingEmpire() == ALL_EMPIRES ||
+        m_id == Universe::EncodingEmpire())
     {
         ar  & BOOST_SERIALIZATION_NVP(m_capital_id)
             & BOOST_SERIALIZATION_NVP(m_techs)
@@ -105,6 +105,9 @@ void Empire::serialize(Archive& ar, const unsigned int version)
             & BOOST_SERIALIZATION_NVP(m_maintenance_total_cost)
             & BOOST_SERIALIZATION_NVP(m_ship_names_used);
     }
+
+    if (Archive::is_loading::value)
+        SupplyChanged();
 }
 
 template void Empire::serialize<FREEORION_OARCHIVE_TYPE>(FREEORION_OARCHIVE_TYPE&, const unsigned int);
@@ -117,8 +120,48 @@ void EmpireManager::serialize(Archive& ar, const unsigned int version)
         Clear();    // clean up any existing dynamically allocated contents before replacing containers with deserialized data
     }
 
+    // diplomacy matrices are stored sparsely, as the non-default entries
+    // only, so that they don't depend on the dense indices assigned to empires
+    std::map<std::pair<int, int>, DiplomaticStatus> diplo_statuses;
+    std::set<std::pair<int, int> > visibility_sharing;
+    if (Archive::is_saving::value) {
+        for (const_iterator it1 = m_empire_map.begin(); it1 != m_empire_map.end(); ++it1) {
+            for (const_iterator it2 = m_empire_map.begin(); it2 != m_empire_map.end(); ++it2) {
+                if (it1->first == it2->first)
+                    continue;
+                DiplomaticStatus status = GetDiplomaticStatus(it1->first, it2->first);
+                if (status != DIPLO_WAR)
+                    diplo_statuses[std::make_pair(it1->first, it2->first)] = status;
+                if (SharesVisibility(it1->first, it2->first))
+                    visibility_sharing.insert(std::make_pair(it1->first, it2->first));
+            }
+        }
+    }
+
     ar  & BOOST_SERIALIZATION_NVP(m_empire_map)
         & BOOST_SERIALIZATION_NVP(m_eliminated_empires);
+
+    if (version >= 1) {
+        ar  & BOOST_SERIALIZATION_NVP(diplo_statuses)
+            & BOOST_SERIALIZATION_NVP(visibility_sharing);
+    }
+    if (version >= 2)
+        ar  & BOOST_SERIALIZATION_NVP(m_diplo_proposals);
+
+    if (Archive::is_loading::value) {
+        for (const_iterator it = m_empire_map.begin(); it != m_empire_map.end(); ++it)
+            AddDiplomacyEntries(it->first);
+        for (std::map<std::pair<int, int>, DiplomaticStatus>::const_iterator it = diplo_statuses.begin(); it != diplo_statuses.end(); ++it) {
+            int index = PairIndex(it->first.first, it->first.second);
+            if (index != -1)
+                m_diplo_statuses[index] = static_cast<unsigned char>(it->second);
+        }
+        for (std::set<std::pair<int, int> >::const_iterator it = visibility_sharing.begin(); it != visibility_sharing.end(); ++it) {
+            int index = PairIndex(it->first, it->second);
+            if (index != -1)
+                m_visibility_sharing[index] = 1;
+        }
+    }
 }
 
 template void EmpireManager::serialize<FREEORION_OARCHIVE_TYPE>(FREEORION_OARCHIVE_TYPE&, const unsigned int);
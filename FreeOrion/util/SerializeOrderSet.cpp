@@ -25,6 +25,8 @@ BOOST_CLASS_EXPORT(ResearchQueueOrder)
 BOOST_CLASS_EXPORT(ProductionQueueOrder)
 BOOST_CLASS_EXPORT(ShipDesignOrder)
 BOOST_CLASS_EXPORT(ScrapOrder)
+BOOST_CLASS_EXPORT(DiplomaticStatusOrder)
+BOOST_CLASS_EXPORT(ShareVisibilityOrder)
 
 template <class Archive>
 void Order::serialize(Archive& ar, const unsigned int version)
@@ -141,6 +143,22 @@ void ScrapOrder::serialize(Archive& ar, const unsigned int version)
         & BOOST_SERIALIZATION_NVP(m_object_id);
 }
 
+template <class Archive>
+void DiplomaticStatusOrder::serialize(Archive& ar, const unsigned int version)
+{
+    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Order)
+        & BOOST_SERIALIZATION_NVP(m_other_empire)
+        & BOOST_SERIALIZATION_NVP(m_status);
+}
+
+template <class Archive>
+void ShareVisibilityOrder::serialize(Archive& ar, const unsigned int version)
+{
+    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Order)
+        & BOOST_SERIALIZATION_NVP(m_other_empire)
+        & BOOST_SERIALIZATION_NVP(m_share);
+}
+
 void Serialize(FREEORION_OARCHIVE_TYPE& oa, const OrderSet& order_set)
 { oa << BOOST_SERIALIZATION_NVP(order_set); }
 
@@ -7,6 +7,7 @@
 #include "../universe/Ship.h"
 #include "../universe/Planet.h"
 #include "../universe/ShipDesign.h"
+#include "../universe/Special.h"
 #include "../universe/System.h"
 
 BOOST_CLASS_EXPORT(System)
@@ -22,6 +23,8 @@ void ObjectMap::serialize(Archive& ar, const unsigned int version)
 
     if (Archive::is_loading::value) {
         CopyObjectsToConstObjects();
+        RebuildOwnerIndex();
+        RebuildSpecialIndex();
     }
 }
 
@@ -38,19 +41,20 @@ void Universe::serialize(Archive& ar, const unsigned int version)
     ar.template register_type<System>();
 
     if (Archive::is_saving::value) {
-        GetObjectsToSerialize(              objects,                            s_encoding_empire);
-        GetEmpireKnownObjectsToSerialize(   empire_latest_known_objects,        s_encoding_empire);
-        GetEmpireObjectVisibilityMap(       empire_object_visibility,           s_encoding_empire);
-        GetEmpireObjectVisibilityTurnMap(   empire_object_visibility_turns,     s_encoding_empire);
-        GetEmpireKnownDestroyedObjects(     empire_known_destroyed_object_ids,  s_encoding_empire);
-        GetShipDesignsToSerialize(          ship_designs,                       s_encoding_empire);
+        GetObjectsToSerialize(              objects,                            EncodingEmpire());
+        GetEmpireKnownObjectsToSerialize(   empire_latest_known_objects,        EncodingEmpire());
+        GetEmpireObjectVisibilityMap(       empire_object_visibility,           EncodingEmpire());
+        GetEmpireObjectVisibilityTurnMap(   empire_object_visibility_turns,     EncodingEmpire());
+        GetEmpireKnownDestroyedObjects(     empire_known_destroyed_object_ids,  EncodingEmpire());
+        GetShipDesignsToSerialize(          ship_designs,                       EncodingEmpire());
     }
 
     if (Archive::is_loading::value) {
         Clear();    // clean up any existing dynamically allocated contents before replacing containers with deserialized data
     }
 
-    ar  & BOOST_SERIALIZATION_NVP(s_universe_width)
+    double universe_width = UniverseWidth();
+    ar  & boost::serialization::make_nvp("s_universe_width", universe_width)
         & BOOST_SERIALIZATION_NVP(ship_designs)
         & BOOST_SERIALIZATION_NVP(m_empire_known_ship_design_ids)
         & BOOST_SERIALIZATION_NVP(empire_object_visibility)
@@ -71,26 +75,38 @@ void Universe::serialize(Archive& ar, const unsigned int version)
     if (Archive::is_loading::value) {
         m_objects.swap(objects);
         m_empire_latest_known_objects.swap(empire_latest_known_objects);
-        m_empire_object_visibility.swap(empire_object_visibility);
-        m_empire_object_visibility_turns.swap(empire_object_visibility_turns);
-        m_empire_known_destroyed_object_ids.swap(empire_known_destroyed_object_ids);
+        SetEmpireVisibility(empire_object_visibility, empire_object_visibility_turns, empire_known_destroyed_object_ids);
         m_ship_designs.swap(ship_designs);
-        InitializeSystemGraph(s_encoding_empire);
+        InitializeSystemGraph(EncodingEmpire());
+        SetUniverseWidth(universe_width);
     }
 }
 
 template <class Archive>
 void UniverseObject::serialize(Archive& ar, const unsigned int version)
 {
+    // special ids differ between processes, so specials are saved by name,
+    // as they were before objects stored them by id
+    std::map<std::string, int> specials;
+    if (Archive::is_saving::value)
+        specials = Specials();
+
     ar  & BOOST_SERIALIZATION_NVP(m_id)
         & BOOST_SERIALIZATION_NVP(m_name)
         & BOOST_SERIALIZATION_NVP(m_x)
         & BOOST_SERIALIZATION_NVP(m_y)
         & BOOST_SERIALIZATION_NVP(m_owner_empire_id)
         & BOOST_SERIALIZATION_NVP(m_system_id)
-        & BOOST_SERIALIZATION_NVP(m_specials)
+        & boost::serialization::make_nvp("m_specials", specials)
         & BOOST_SERIALIZATION_NVP(m_meters)
         & BOOST_SERIALIZATION_NVP(m_created_on_turn);
+
+    if (Archive::is_loading::value) {
+        m_specials.clear();
+        for (std::map<std::string, int>::const_iterator it = specials.begin(); it != specials.end(); ++it)
+            m_specials.push_back(std::make_pair(SpecialID(it->first), it->second));
+        std::sort(m_specials.begin(), m_specials.end());
+    }
 }
 
 template <class Archive>
@@ -159,9 +175,21 @@ void Ship::serialize(Archive& ar, const unsigned int version)
         & BOOST_SERIALIZATION_NVP(m_ordered_colonize_planet_id)
         & BOOST_SERIALIZATION_NVP(m_ordered_invade_planet_id)
         & BOOST_SERIALIZATION_NVP(m_fighters)
-        & BOOST_SERIALIZATION_NVP(m_missiles)
-        & BOOST_SERIALIZATION_NVP(m_part_meters)
-        & BOOST_SERIALIZATION_NVP(m_species_name)
+        & BOOST_SERIALIZATION_NVP(m_missiles);
+
+    if (version < 1) {
+        // part meters were stored in a map, which is ordered as the array
+        // that replaced it is
+        std::map<std::pair<MeterType, std::string>, Meter> part_meters;
+        ar  & boost::serialization::make_nvp("m_part_meters", part_meters);
+        m_part_meters.clear();
+        for (std::map<std::pair<MeterType, std::string>, Meter>::const_iterator it = part_meters.begin(); it != part_meters.end(); ++it)
+            m_part_meters.push_back(it->second);
+    } else {
+        ar  & BOOST_SERIALIZATION_NVP(m_part_meters);
+    }
+
+    ar  & BOOST_SERIALIZATION_NVP(m_species_name)
         & BOOST_SERIALIZATION_NVP(m_produced_by_empire_id);
 }
 
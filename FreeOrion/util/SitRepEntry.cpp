@@ -10,124 +10,222 @@
 
 namespace {
     const std::string SITREP_UPDATE_TAG = "SitRepUpdate";
+
+    const std::string EMPTY_STRING;
+
+    // indexed by SitRepEntry::TemplateID
+    const std::string TEMPLATE_STRINGS[SitRepEntry::NUM_TEMPLATES] = {
+        "SITREP_TECH_RESEARCHED",
+        "SITREP_SHIP_BUILT",
+        "SITREP_BUILDING_BUILT",
+        "SITREP_COMBAT_SYSTEM",
+        "SITREP_GROUND_BATTLE",
+        "SITREP_PLANET_CAPTURED",
+        "SITREP_OBJECT_DESTROYED_AT_SYSTEM",
+        "SITREP_SHIP_DESTROYED_AT_SYSTEM",
+        "SITREP_FLEET_DESTROYED_AT_SYSTEM",
+        "SITREP_PLANET_DESTROYED_AT_SYSTEM",
+        "SITREP_BUILDING_DESTROYED_ON_PLANET_AT_SYSTEM",
+        "SITREP_PLANET_LOST_STARVED_TO_DEATH",
+        "SITREP_PLANET_COLONIZED",
+        "SITREP_FLEET_ARRIVED_AT_DESTINATION",
+        "SITREP_EMPIRE_ELIMINATED",
+        "SITREP_VICTORY"
+    };
 }
 
+////////////////////////////////////////
+// SitRepEntry::Argument               //
+////////////////////////////////////////
+SitRepEntry::Argument::Argument() :
+    type(INVALID_ARGUMENT),
+    id(UniverseObject::INVALID_OBJECT_ID),
+    name()
+{}
+
+SitRepEntry::Argument::Argument(ArgumentType type_, int id_) :
+    type(type_),
+    id(id_),
+    name()
+{}
+
+SitRepEntry::Argument::Argument(ArgumentType type_, const std::string& name_) :
+    type(type_),
+    id(UniverseObject::INVALID_OBJECT_ID),
+    name(name_)
+{}
+
+////////////////////////////////////////
+// SitRepEntry                         //
+////////////////////////////////////////
 SitRepEntry::SitRepEntry() :
-    VarText()
+    VarText(),
+    m_template_id(GENERIC_TEMPLATE),
+    m_arguments()
 {}
 
 SitRepEntry::SitRepEntry(const std::string& template_string) :
-    VarText(template_string, true)
+    VarText(template_string, true),
+    m_template_id(GENERIC_TEMPLATE),
+    m_arguments()
 {}
 
+SitRepEntry::SitRepEntry(TemplateID template_id) :
+    VarText(),
+    m_template_id(template_id),
+    m_arguments()
+{}
+
+const std::string& SitRepEntry::GetText() const
+{
+    if (m_text.empty() && m_template_id != GENERIC_TEMPLATE) {
+        // expand compact representation into a VarText and cache its result
+        VarText expanded(TemplateString(m_template_id), true);
+        for (std::vector<Argument>::const_iterator it = m_arguments.begin(); it != m_arguments.end(); ++it) {
+            if (it->type == TEXT_ARGUMENT || it->type == TECH_ARGUMENT)
+                expanded.AddVariable(ArgumentTag(it->type), it->name);
+            else
+                expanded.AddVariable(ArgumentTag(it->type), boost::lexical_cast<std::string>(it->id));
+        }
+        m_text = expanded.GetText();
+        return m_text;
+    }
+    return VarText::GetText();
+}
+
+void SitRepEntry::AddArgument(ArgumentType type, int id)
+{ m_arguments.push_back(Argument(type, id)); }
+
+void SitRepEntry::AddArgument(ArgumentType type, const std::string& name)
+{ m_arguments.push_back(Argument(type, name)); }
+
+const std::string& SitRepEntry::TemplateString(TemplateID template_id)
+{
+    if (template_id < 0 || template_id >= NUM_TEMPLATES)
+        return EMPTY_STRING;
+    return TEMPLATE_STRINGS[template_id];
+}
+
+const std::string& SitRepEntry::ArgumentTag(ArgumentType type)
+{
+    switch (type) {
+    case TEXT_ARGUMENT:         return VarText::TEXT_TAG;
+    case PLANET_ID_ARGUMENT:    return VarText::PLANET_ID_TAG;
+    case SYSTEM_ID_ARGUMENT:    return VarText::SYSTEM_ID_TAG;
+    case SHIP_ID_ARGUMENT:      return VarText::SHIP_ID_TAG;
+    case FLEET_ID_ARGUMENT:     return VarText::FLEET_ID_TAG;
+    case BUILDING_ID_ARGUMENT:  return VarText::BUILDING_ID_TAG;
+    case EMPIRE_ID_ARGUMENT:    return VarText::EMPIRE_ID_TAG;
+    case TECH_ARGUMENT:         return VarText::TECH_TAG;
+    default:                    return EMPTY_STRING;
+    }
+}
+
+////////////////////////////////////////
+// SitRep constructors                 //
+////////////////////////////////////////
 SitRepEntry* CreateTechResearchedSitRep(const std::string& tech_name) {
-    SitRepEntry* sitrep = new SitRepEntry("SITREP_TECH_RESEARCHED");
-    sitrep->AddVariable(VarText::TECH_TAG,          tech_name);
+    SitRepEntry* sitrep = new SitRepEntry(SitRepEntry::TECH_RESEARCHED);
+    sitrep->AddArgument(SitRepEntry::TECH_ARGUMENT,         tech_name);
     return sitrep;
 }
 
 SitRepEntry* CreateShipBuiltSitRep(int ship_id, int system_id) {
-    SitRepEntry* sitrep = new SitRepEntry("SITREP_SHIP_BUILT");
-    sitrep->AddVariable(VarText::SYSTEM_ID_TAG,     boost::lexical_cast<std::string>(system_id));
-    sitrep->AddVariable(VarText::SHIP_ID_TAG,       boost::lexical_cast<std::string>(ship_id));
+    SitRepEntry* sitrep = new SitRepEntry(SitRepEntry::SHIP_BUILT);
+    sitrep->AddArgument(SitRepEntry::SYSTEM_ID_ARGUMENT,    system_id);
+    sitrep->AddArgument(SitRepEntry::SHIP_ID_ARGUMENT,      ship_id);
     return sitrep;
 }
 
 SitRepEntry* CreateBuildingBuiltSitRep(int building_id, int planet_id) {
-    SitRepEntry* sitrep = new SitRepEntry("SITREP_BUILDING_BUILT");
-    sitrep->AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(planet_id));
-    sitrep->AddVariable(VarText::BUILDING_ID_TAG,   boost::lexical_cast<std::string>(building_id));
+    SitRepEntry* sitrep = new SitRepEntry(SitRepEntry::BUILDING_BUILT);
+    sitrep->AddArgument(SitRepEntry::PLANET_ID_ARGUMENT,    planet_id);
+    sitrep->AddArgument(SitRepEntry::BUILDING_ID_ARGUMENT,  building_id);
     return sitrep;
 }
 
 SitRepEntry* CreateCombatSitRep(int system_id) {
-    SitRepEntry* sitrep = new SitRepEntry("SITREP_COMBAT_SYSTEM");
-    sitrep->AddVariable(VarText::SYSTEM_ID_TAG,     boost::lexical_cast<std::string>(system_id));
+    SitRepEntry* sitrep = new SitRepEntry(SitRepEntry::COMBAT_SYSTEM);
+    sitrep->AddArgument(SitRepEntry::SYSTEM_ID_ARGUMENT,    system_id);
     return sitrep;
 }
 
 SitRepEntry* CreateGroundCombatSitRep(int planet_id) {
-    SitRepEntry* sitrep = new SitRepEntry("SITREP_GROUND_BATTLE");
-    sitrep->AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(planet_id));
+    SitRepEntry* sitrep = new SitRepEntry(SitRepEntry::GROUND_BATTLE);
+    sitrep->AddArgument(SitRepEntry::PLANET_ID_ARGUMENT,    planet_id);
     return sitrep;
 }
 
 SitRepEntry* CreatePlanetCapturedSitRep(int planet_id, int empire_id) {
-    SitRepEntry* sitrep = new SitRepEntry("SITREP_PLANET_CAPTURED");
-    sitrep->AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(planet_id));
-    sitrep->AddVariable(VarText::EMPIRE_ID_TAG,     boost::lexical_cast<std::string>(empire_id));
+    SitRepEntry* sitrep = new SitRepEntry(SitRepEntry::PLANET_CAPTURED);
+    sitrep->AddArgument(SitRepEntry::PLANET_ID_ARGUMENT,    planet_id);
+    sitrep->AddArgument(SitRepEntry::EMPIRE_ID_ARGUMENT,    empire_id);
     return sitrep;
 }
 
-namespace {
-    SitRepEntry* GenericCombatDestroyedObjectSitrep(int combat_system_id) {
-        SitRepEntry* sitrep = new SitRepEntry("SITREP_OBJECT_DESTROYED_AT_SYSTEM");
-        sitrep->AddVariable(VarText::SYSTEM_ID_TAG,     boost::lexical_cast<std::string>(combat_system_id));
-        return sitrep;
-    }
-}
-
 SitRepEntry* CreateCombatDestroyedObjectSitRep(int object_id, int combat_system_id, int empire_id) {
     const UniverseObject* obj = GetUniverse().EmpireKnownObjects(empire_id).Object(object_id);
-    if (!obj)
-        return GenericCombatDestroyedObjectSitrep(combat_system_id);
 
     SitRepEntry* sitrep(0);
 
-    if (universe_object_cast<const Ship*>(obj)) {
-        sitrep = new SitRepEntry("SITREP_SHIP_DESTROYED_AT_SYSTEM");
-        sitrep->AddVariable(VarText::SHIP_ID_TAG,       boost::lexical_cast<std::string>(object_id));
+    if (!obj) {
+        sitrep = new SitRepEntry(SitRepEntry::OBJECT_DESTROYED_AT_SYSTEM);
+
+    } else if (universe_object_cast<const Ship*>(obj)) {
+        sitrep = new SitRepEntry(SitRepEntry::SHIP_DESTROYED_AT_SYSTEM);
+        sitrep->AddArgument(SitRepEntry::SHIP_ID_ARGUMENT,      object_id);
 
     } else if (universe_object_cast<const Fleet*>(obj)) {
-        SitRepEntry* sitrep = new SitRepEntry("SITREP_FLEET_DESTROYED_AT_SYSTEM");
-        sitrep->AddVariable(VarText::FLEET_ID_TAG,      boost::lexical_cast<std::string>(object_id));
+        sitrep = new SitRepEntry(SitRepEntry::FLEET_DESTROYED_AT_SYSTEM);
+        sitrep->AddArgument(SitRepEntry::FLEET_ID_ARGUMENT,     object_id);
 
     } else if (universe_object_cast<const Planet*>(obj)) {
-        SitRepEntry* sitrep = new SitRepEntry("SITREP_PLANET_DESTROYED_AT_SYSTEM");
-        sitrep->AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(object_id));
+        sitrep = new SitRepEntry(SitRepEntry::PLANET_DESTROYED_AT_SYSTEM);
+        sitrep->AddArgument(SitRepEntry::PLANET_ID_ARGUMENT,    object_id);
 
     } else if (const Building* building = universe_object_cast<const Building*>(obj)) {
-        sitrep = new SitRepEntry("SITREP_BUILDING_DESTROYED_ON_PLANET_AT_SYSTEM");
-        sitrep->AddVariable(VarText::BUILDING_ID_TAG,   boost::lexical_cast<std::string>(object_id));
-        sitrep->AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(building->PlanetID()));
+        sitrep = new SitRepEntry(SitRepEntry::BUILDING_DESTROYED_ON_PLANET_AT_SYSTEM);
+        sitrep->AddArgument(SitRepEntry::BUILDING_ID_ARGUMENT,  object_id);
+        sitrep->AddArgument(SitRepEntry::PLANET_ID_ARGUMENT,    building->PlanetID());
+
     } else {
-        sitrep = GenericCombatDestroyedObjectSitrep(combat_system_id);
+        sitrep = new SitRepEntry(SitRepEntry::OBJECT_DESTROYED_AT_SYSTEM);
     }
 
-    sitrep->AddVariable(VarText::SYSTEM_ID_TAG,     boost::lexical_cast<std::string>(combat_system_id));
+    sitrep->AddArgument(SitRepEntry::SYSTEM_ID_ARGUMENT,    combat_system_id);
 
     return sitrep;
 }
 
 SitRepEntry* CreatePlanetStarvedToDeathSitRep(int planet_id) {
-    SitRepEntry* sitrep = new SitRepEntry("SITREP_PLANET_LOST_STARVED_TO_DEATH");
-    sitrep->AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(planet_id));
+    SitRepEntry* sitrep = new SitRepEntry(SitRepEntry::PLANET_LOST_STARVED_TO_DEATH);
+    sitrep->AddArgument(SitRepEntry::PLANET_ID_ARGUMENT,    planet_id);
     return sitrep;
 }
 
 SitRepEntry* CreatePlanetColonizedSitRep(int planet_id) {
-    SitRepEntry* sitrep = new SitRepEntry("SITREP_PLANET_COLONIZED");
-    sitrep->AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(planet_id));
+    SitRepEntry* sitrep = new SitRepEntry(SitRepEntry::PLANET_COLONIZED);
+    sitrep->AddArgument(SitRepEntry::PLANET_ID_ARGUMENT,    planet_id);
     return sitrep;
 }
 
 SitRepEntry* CreateFleetArrivedAtDestinationSitRep(int system_id, int fleet_id) {
-    SitRepEntry* sitrep = new SitRepEntry("SITREP_FLEET_ARRIVED_AT_DESTINATION");
-    sitrep->AddVariable(VarText::SYSTEM_ID_TAG,     boost::lexical_cast<std::string>(system_id));
-    sitrep->AddVariable(VarText::FLEET_ID_TAG,      boost::lexical_cast<std::string>(fleet_id));
+    SitRepEntry* sitrep = new SitRepEntry(SitRepEntry::FLEET_ARRIVED_AT_DESTINATION);
+    sitrep->AddArgument(SitRepEntry::SYSTEM_ID_ARGUMENT,    system_id);
+    sitrep->AddArgument(SitRepEntry::FLEET_ID_ARGUMENT,     fleet_id);
     return sitrep;
 }
 
 SitRepEntry* CreateEmpireEliminatedSitRep(int empire_id) {
-    SitRepEntry* sitrep = new SitRepEntry("SITREP_EMPIRE_ELIMINATED");
-    sitrep->AddVariable(VarText::EMPIRE_ID_TAG,     boost::lexical_cast<std::string>(empire_id));
+    SitRepEntry* sitrep = new SitRepEntry(SitRepEntry::EMPIRE_ELIMINATED);
+    sitrep->AddArgument(SitRepEntry::EMPIRE_ID_ARGUMENT,    empire_id);
     return sitrep;
 }
 
 SitRepEntry* CreateVictorySitRep(const std::string& reason_string, int empire_id) {
-    SitRepEntry* sitrep = new SitRepEntry("SITREP_VICTORY");
-    sitrep->AddVariable(VarText::TEXT_TAG,          reason_string);
-    sitrep->AddVariable(VarText::EMPIRE_ID_TAG,     boost::lexical_cast<std::string>(empire_id));
+    SitRepEntry* sitrep = new SitRepEntry(SitRepEntry::VICTORY);
+    sitrep->AddArgument(SitRepEntry::TEXT_ARGUMENT,         reason_string);
+    sitrep->AddArgument(SitRepEntry::EMPIRE_ID_ARGUMENT,    empire_id);
     return sitrep;
 }
 
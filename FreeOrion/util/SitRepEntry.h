@@ -9,22 +9,111 @@
 #include <vector>
 
 #include <boost/lexical_cast.hpp>
+#include <boost/serialization/version.hpp>
 
-/** Situation report entry, to be displayed in the SitRep screen. */
+/** Situation report entry, to be displayed in the SitRep screen.
+  *
+  * Entries for the built-in sitrep types are stored compactly as a template
+  * ID and a small array of typed arguments (object, empire and content IDs).
+  * Only these are sent to clients; the VarText variables and the rendered
+  * text are generated lazily on first call to GetText() and then cached.
+  * Entries created from scripted content (CreateSitRep) use a
+  * GENERIC_TEMPLATE and store their template string and variables in the
+  * VarText base as before. */
 class SitRepEntry : public VarText
 {
 public:
+    /** Built-in sitrep templates that have a compact representation. */
+    enum TemplateID {
+        GENERIC_TEMPLATE = -1,
+        TECH_RESEARCHED,
+        SHIP_BUILT,
+        BUILDING_BUILT,
+        COMBAT_SYSTEM,
+        GROUND_BATTLE,
+        PLANET_CAPTURED,
+        OBJECT_DESTROYED_AT_SYSTEM,
+        SHIP_DESTROYED_AT_SYSTEM,
+        FLEET_DESTROYED_AT_SYSTEM,
+        PLANET_DESTROYED_AT_SYSTEM,
+        BUILDING_DESTROYED_ON_PLANET_AT_SYSTEM,
+        PLANET_LOST_STARVED_TO_DEATH,
+        PLANET_COLONIZED,
+        FLEET_ARRIVED_AT_DESTINATION,
+        EMPIRE_ELIMINATED,
+        VICTORY,
+        NUM_TEMPLATES
+    };
+
+    /** Kinds of value that a compact sitrep argument can refer to.  Each
+      * corresponds to one of the VarText tags. */
+    enum ArgumentType {
+        INVALID_ARGUMENT = -1,
+        TEXT_ARGUMENT,
+        PLANET_ID_ARGUMENT,
+        SYSTEM_ID_ARGUMENT,
+        SHIP_ID_ARGUMENT,
+        FLEET_ID_ARGUMENT,
+        BUILDING_ID_ARGUMENT,
+        EMPIRE_ID_ARGUMENT,
+        TECH_ARGUMENT,
+        NUM_ARGUMENT_TYPES
+    };
+
+    /** A typed argument of a compact sitrep.  ID-typed arguments use \a id;
+      * text and content arguments use \a name. */
+    struct Argument {
+        Argument();
+        Argument(ArgumentType type_, int id_);
+        Argument(ArgumentType type_, const std::string& name_);
+
+        ArgumentType    type;
+        int             id;
+        std::string     name;
+
+    private:
+        friend class boost::serialization::access;
+        template <class Archive>
+        void serialize(Archive& ar, const unsigned int version);
+    };
+
     /** \name Structors */ //@{
     SitRepEntry();  ///< default ctor
     SitRepEntry(const std::string& template_string);
+    explicit SitRepEntry(TemplateID template_id);
+    //@}
+
+    /** \name Accessors */ //@{
+    /** Returns the rendered text of this entry, generating and caching it
+      * on first call.  Hides VarText::GetText(). */
+    const std::string&              GetText() const;
+
+    TemplateID                      GetTemplateID() const { return m_template_id; }
+    const std::vector<Argument>&    Arguments() const { return m_arguments; }
+    //@}
+
+    /** \name Mutators */ //@{
+    void                            AddArgument(ArgumentType type, int id);
+    void                            AddArgument(ArgumentType type, const std::string& name);
     //@}
 
+    /** Returns the stringtable key of the template with ID \a template_id. */
+    static const std::string&       TemplateString(TemplateID template_id);
+
+    /** Returns the VarText tag corresponding to argument type \a type. */
+    static const std::string&       ArgumentTag(ArgumentType type);
+
 private:
+    TemplateID              m_template_id;
+    std::vector<Argument>   m_arguments;
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
 };
 
+BOOST_CLASS_VERSION(SitRepEntry, 1)
+
 /** Sitrep constructors for each SitRep type */
 SitRepEntry* CreateTechResearchedSitRep(const std::string& tech_name);
 SitRepEntry* CreateShipBuiltSitRep(int ship_id, int system_id);
@@ -42,10 +131,29 @@ SitRepEntry* CreateSitRep(const std::string& template_string,
                           const std::vector<std::pair<std::string, std::string> >& parameters);
 
 // template implementations
+template <class Archive>
+void SitRepEntry::Argument::serialize(Archive& ar, const unsigned int version)
+{
+    ar  & BOOST_SERIALIZATION_NVP(type);
+    if (type == TEXT_ARGUMENT || type == TECH_ARGUMENT)
+        ar  & BOOST_SERIALIZATION_NVP(name);
+    else
+        ar  & BOOST_SERIALIZATION_NVP(id);
+}
+
 template <class Archive>
 void SitRepEntry::serialize(Archive& ar, const unsigned int version)
 {
-    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(VarText);
+    if (version < 1) {
+        ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(VarText);
+        return;
+    }
+
+    ar  & BOOST_SERIALIZATION_NVP(m_template_id);
+    if (m_template_id == GENERIC_TEMPLATE)
+        ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(VarText);
+    else
+        ar  & BOOST_SERIALIZATION_NVP(m_arguments);
 }
 
 #endif // _SitRepEntry_h_
@@ -0,0 +1,48 @@
+// -*- C++ -*-
+#ifndef _ThreadSpecific_h_
+#define _ThreadSpecific_h_
+
+#include <boost/thread/tss.hpp>
+
+/** A value of type T of which each thread has its own copy.  A thread's copy
+    is made from the default value given on construction the first time the
+    thread accesses it.  Used to track which game is active on each thread;
+    see ScopedGameContext.  State that belongs to a game belongs in its
+    GameContext instead. */
+template <class T>
+class ThreadSpecific
+{
+public:
+    explicit ThreadSpecific(const T& default_value = T()) :
+        m_default(default_value)
+    {}
+
+    operator const T&() const
+    { return Get(); }
+
+    ThreadSpecific& operator=(const T& value)
+    {
+        Get() = value;
+        return *this;
+    }
+
+    /** Returns the calling thread's copy of the value. */
+    T& Get() const
+    {
+        T* value = m_values.get();
+        if (!value) {
+            value = new T(m_default);
+            m_values.reset(value);
+        }
+        return *value;
+    }
+
+private:
+    ThreadSpecific(const ThreadSpecific&); // disabled
+    const ThreadSpecific& operator=(const ThreadSpecific&); // disabled
+
+    T                                       m_default;
+    mutable boost::thread_specific_ptr<T>   m_values;
+};
+
+#endif // _ThreadSpecific_h_